@@ -19,13 +19,14 @@
 
 #pragma once
 
-#include <ebur128.h>
 #include <sigc++/signal.h>
 #include <sys/types.h>
+#include <cstdint>
+#include <memory>
 #include <span>
 #include <string>
-#include <thread>
-#include <vector>
+#include "gated_loudness.hpp"
+#include "metering_bus.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -52,8 +53,6 @@ class AutoGain : public PluginBase {
     geometric_mean_si
   };
 
-  void setup() override;
-
   void process(std::span<float>& left_in,
                std::span<float>& right_in,
                std::span<float>& left_out,
@@ -61,6 +60,8 @@ class AutoGain : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  void emit_meters(const MeterValues& values) override;
+
   sigc::signal<void(const double,  // loudness
                     const double,  // gain
                     const double,  // momentary
@@ -78,25 +79,23 @@ class AutoGain : public PluginBase {
   double loudness = 0.0;
 
  private:
-  bool ebur128_ready = false;
-
-  uint old_rate = 0U;
-
   double target = -23.0;  // target loudness level
   double silence_threshold = -70.0;
   double internal_output_gain = 1.0;
 
   Reference reference = Reference::geometric_mean_msi;
 
-  std::vector<float> data;
+  std::unique_ptr<GatedLoudness> meter;
 
-  ebur128_state* ebur_state = nullptr;
+  MeteringTap* last_tap = nullptr;
 
-  std::vector<std::thread> mythreads;
+  uint64_t next_subblock = 0U;
 
-  auto init_ebur128() -> bool;
+  void reset_meter();
 
   static auto parse_reference_key(const std::string& key) -> Reference;
 
   void set_maximum_history(const int& seconds);
+
+  void set_statistics_interval(const int& milliseconds);
 };
@@ -52,6 +52,10 @@ class Compressor : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  void emit_meters(const MeterValues& values) override;
+
+  void reset_meters() override;
+
   void update_probe_links() override;
 
   sigc::signal<void(const float)> reduction, sidechain, curve, envelope;
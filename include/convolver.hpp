@@ -45,6 +45,10 @@ class Convolver : public PluginBase {
 
   void setup() override;
 
+  void suspend() override;
+
+  void resume() override;
+
   void process(std::span<float>& left_in,
                std::span<float>& right_in,
                std::span<float>& left_out,
@@ -67,6 +71,8 @@ class Convolver : public PluginBase {
   bool zita_ready = false;
   bool ready = false;
   bool notify_latency = false;
+  bool true_stereo = false;
+  bool suspended = false;  // the zita engine was released while the pipeline was idle
 
   uint blocksize = 512U;
   uint ir_width = 100U;
@@ -74,6 +80,10 @@ class Convolver : public PluginBase {
 
   std::vector<float> kernel_L, kernel_R;
   std::vector<float> original_kernel_L, original_kernel_R;
+
+  // cross paths of true stereo impulses: L -> R and R -> L
+  std::vector<float> kernel_LR, kernel_RL;
+  std::vector<float> original_kernel_LR, original_kernel_RL;
   std::vector<float> data_L, data_R;
 
   std::deque<float> deque_out_L, deque_out_R;
@@ -84,6 +94,8 @@ class Convolver : public PluginBase {
 
   void read_kernel_file();
 
+  void reset_kernels();
+
   void apply_kernel_autogain();
 
   void set_kernel_stereo_width();
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <array>
 #include <filesystem>
 #include <string>
 #include <tuple>
@@ -29,4 +30,8 @@ namespace ui::convolver {
 auto read_kernel(std::filesystem::path irs_dir, const std::string& irs_ext, const std::string& file_name)
     -> std::tuple<int, std::vector<float>, std::vector<float>>;
 
+// All the paths of the impulse in the order L -> L, L -> R, R -> L, R -> R. The cross paths of a stereo file are empty.
+auto read_kernel_paths(std::filesystem::path irs_dir, const std::string& irs_ext, const std::string& file_name)
+    -> std::tuple<int, std::array<std::vector<float>, 4>>;
+
 }
@@ -19,14 +19,20 @@
 
 #pragma once
 
+#include <sys/types.h>
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <span>
 #include <string>
+#include <thread>
 #include <vector>
 #include "ladspa_wrapper.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
-#include "resampler.hpp"
+#include "polyphase_resampler.hpp"
+#include "spsc_ring.hpp"
 
 class DeepFilterNet : public PluginBase {
  public:
@@ -43,6 +49,10 @@ class DeepFilterNet : public PluginBase {
 
   void setup() override;
 
+  void suspend() override;
+
+  void resume() override;
+
   void process(std::span<float>& left_in,
                std::span<float>& right_in,
                std::span<float>& left_out,
@@ -51,14 +61,64 @@ class DeepFilterNet : public PluginBase {
   auto get_latency_seconds() -> float override;
 
  private:
-  std::unique_ptr<ladspa::LadspaWrapper> ladspa_wrapper;
+  std::unique_ptr<ladspa::LadspaWrapper> ladspa_wrapper, ladspa_wrapper_mono;
+
+  bool suspended = false;  // the model instances were freed while the pipeline was idle
 
-  bool resample = false;
-  bool resampler_ready = true;
+  // also read by the worker thread
 
-  std::unique_ptr<Resampler> resampler_inL, resampler_outL;
-  std::unique_ptr<Resampler> resampler_inR, resampler_outR;
+  std::atomic<bool> resample = false;
+  std::atomic<bool> resampler_ready = true;
 
+  float resampler_latency = 0.0F;        // seconds
+  float resampler_latency_async = 0.0F;  // seconds
+
+  std::unique_ptr<PolyphaseResampler> resampler_inL, resampler_outL;
+  std::unique_ptr<PolyphaseResampler> resampler_inR, resampler_outR;
+
+  std::vector<float> resampled_inL, resampled_inR;
   std::vector<float> resampled_outL, resampled_outR;
-  std::vector<float> carryover_l, carryover_r;
+
+  /*
+    In the asynchronous mode the realtime thread only moves audio through the rings below. The model runs in a
+    worker thread and the output rings are primed with async_latency_frames of silence, so the worker has that much
+    time to finish each block.
+  */
+
+  bool async_processing = false;
+
+  double async_buffer_ms = 20.0;
+
+  uint async_latency_frames = 0U;
+
+  size_t async_deficit = 0U;  // frames that arrived late and have to be dropped to keep the latency constant
+
+  std::atomic<bool> async_ready = false;
+  std::atomic<bool> async_mono = false;
+  std::atomic<bool> worker_signal = false;
+  std::atomic<bool> worker_exit = false;
+
+  std::mutex worker_mutex;
+
+  std::thread worker;
+
+  std::unique_ptr<SpscRing<float>> ring_inL, ring_inR, ring_outL, ring_outR;
+
+  std::vector<float> work_inL, work_inR, work_outL, work_outR;
+
+  void init_async();
+
+  void stop_worker();
+
+  void update_latency();
+
+  void worker_loop();
+
+  void run_model(std::span<float> inL,
+                 std::span<float> inR,
+                 std::span<float> outL,
+                 std::span<float> outR,
+                 const bool& mono);
+
+  auto process_block(std::span<float> inL, std::span<float> inR, const bool& mono) -> size_t;
 };
@@ -47,6 +47,10 @@ class Deesser : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  void emit_meters(const MeterValues& values) override;
+
+  void reset_meters() override;
+
   sigc::signal<void(const double)> compression, detected;
 
   double compression_port_value = 0.0;
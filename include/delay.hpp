@@ -20,8 +20,12 @@
 #pragma once
 
 #include <sys/types.h>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <span>
 #include <string>
+#include "delay_line.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -48,5 +52,23 @@ class Delay : public PluginBase {
   auto get_latency_seconds() -> float override;
 
  private:
+  static constexpr uint max_delay = 1000U;  // ms, the upper limit of the time keys
+
   uint latency_n_frames = 0U;
+
+  uint delay_line_rate = 0U;
+
+  // Written by the settings handlers and read by the realtime thread. The wet levels carry the phase inversion.
+
+  std::atomic<double> time_l = 0.0, time_r = 0.0;
+
+  std::atomic<float> dry_l = 0.0F, dry_r = 0.0F, wet_l = 1.0F, wet_r = 1.0F;
+
+  // Levels used in the previous block. The realtime thread ramps from them to the new ones.
+
+  std::array<float, 4U> applied_levels = {0.0F, 0.0F, 1.0F, 1.0F};  // dry left, dry right, wet left and wet right
+
+  std::unique_ptr<DelayLine> delay_line;
+
+  void read_settings();
 };
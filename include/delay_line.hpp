@@ -0,0 +1,89 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/*
+  Stereo delay line for the realtime thread. The memory is allocated in the constructor and process() only moves
+  samples around, so the delay can be changed in every call without allocating.
+
+  The ring buffer size is a power of two. Each block is first copied into the ring and then read back, so the input and
+  output spans may be the same. Integer delays are plain block copies. The fractional part of a delay is interpolated
+  with a third order Lagrange polynomial that only reads past samples, so the line does not add latency of its own.
+
+  When the delay of a channel changes, the output of the call crossfades from the previous delay to the new one. A
+  jump of the read position would otherwise be heard as a click.
+*/
+
+class DelayLine {
+ public:
+  explicit DelayLine(const uint& max_delay_frames);
+  DelayLine(const DelayLine&) = delete;
+  auto operator=(const DelayLine&) -> DelayLine& = delete;
+  DelayLine(const DelayLine&&) = delete;
+  auto operator=(const DelayLine&&) -> DelayLine& = delete;
+  ~DelayLine() = default;
+
+  // Delays the signal in place. Values larger than get_max_delay_frames() are clamped.
+  void process(std::span<float> left, std::span<float> right, const uint& delay_frames);
+
+  // Each channel has its own delay in frames, which does not have to be an integer. Values are clamped to the range
+  // [0, get_max_delay_frames()].
+  void process(std::span<const float> left_in,
+               std::span<const float> right_in,
+               std::span<float> left_out,
+               std::span<float> right_out,
+               const double& delay_left,
+               const double& delay_right);
+
+  void reset();
+
+  [[nodiscard]] auto get_max_delay_frames() const -> uint { return max_delay_frames; }
+
+ private:
+  static constexpr size_t block_frames = 1024U;  // the longest block written to the ring before it is read back
+  static constexpr size_t interpolation_frames = 3U;
+
+  uint max_delay_frames = 0U;
+
+  size_t mask = 0U;
+
+  size_t write_position = 0U;
+
+  std::vector<float> buffer_left, buffer_right, faded;
+
+  double previous_left = -1.0, previous_right = -1.0;  // negative before the first call
+
+  void write(std::span<const float> left, std::span<const float> right);
+
+  void read(const std::vector<float>& buffer, std::span<float> output, const double& delay) const;
+
+  // Mixes the output with the one read at the previous delay. The weight of the new delay goes from 0 to 1 over the
+  // total number of frames of the call.
+  void crossfade(const std::vector<float>& buffer,
+                 std::span<float> output,
+                 const double& previous_delay,
+                 const size_t& offset,
+                 const size_t& total);
+};
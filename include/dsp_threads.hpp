@@ -0,0 +1,68 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <zita-convolver.h>
+#include <string>
+#include <vector>
+
+/*
+  Scheduling of the zita-convolver engines used by the Convolver and by the FIR filters. The configuration comes from
+  the application settings and is shared by all the engines.
+
+  With zero threads the engines use a uniform partition and the whole convolution runs in the PipeWire thread. Each
+  additional thread doubles the largest partition, and zita computes these partitions in threads of its own. That
+  lowers the cost of long impulse responses in the realtime thread.
+*/
+
+namespace dsp_threads {
+
+struct Config {
+  uint threads = 0U;  // background threads per engine
+
+  bool realtime = true;
+
+  int priority = 0;
+
+  std::vector<int> cpus;  // empty means that the threads can run on any core
+};
+
+void set_config(Config config);
+
+auto get_config() -> Config;
+
+// Parses lists like "2-3,6". Invalid entries are ignored.
+auto parse_cpu_list(const std::string& list) -> std::vector<int>;
+
+// Largest partition for an engine processing blocks of block_size frames
+auto get_max_partition(const uint& block_size) -> uint;
+
+// Starts the engine threads with the configured scheduling and pins them to the configured cores
+auto start(Convproc* conv) -> int;
+
+/*
+  Gives the calling thread the configured cores. Used by plugin workers that are not zita threads. The configured
+  realtime scheduling is only applied when allow_realtime is true. Otherwise the thread uses the normal scheduler, so
+  it can not delay the audio threads.
+*/
+void apply_to_current_thread(const std::string& thread_name, const bool& allow_realtime);
+
+}  // namespace dsp_threads
@@ -24,6 +24,8 @@
 #include <pipewire/proxy.h>
 #include <sigc++/connection.h>
 #include <sigc++/signal.h>
+#include <chrono>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -47,6 +49,7 @@
 #include "limiter.hpp"
 #include "loudness.hpp"
 #include "maximizer.hpp"
+#include "metering_bus.hpp"
 #include "multiband_compressor.hpp"
 #include "multiband_gate.hpp"
 #include "output_level.hpp"
@@ -68,12 +71,25 @@ class EffectsBase {
   auto operator=(const EffectsBase&&) -> EffectsBase& = delete;
   virtual ~EffectsBase();
 
+  /*
+    Instantiates the filter class of a plugin name like "compressor#1". Its settings are below base_path. The
+    constructors do not use the PipeManager, so it can be null when the filter is not going to be connected.
+  */
+  static auto create_plugin(const std::string& name,
+                            const std::string& tag,
+                            const std::string& base_path,
+                            PipeManager* pipe_manager,
+                            PipelineType pipe_type) -> std::shared_ptr<PluginBase>;
+
   const std::string log_tag;
 
   PipeManager* pm = nullptr;
 
   PipelineType pipeline_type;
 
+  // Declared before the plugins so that it is destroyed after them
+  std::shared_ptr<MeteringBus> metering_bus = std::make_shared<MeteringBus>();
+
   std::shared_ptr<OutputLevel> output_level;
   std::shared_ptr<Spectrum> spectrum;
 
@@ -130,8 +146,16 @@ class EffectsBase {
 
   std::vector<gulong> gconnections, gconnections_global;
 
+  guint events_source_id = 0U;
+
+  guint idle_source_id = 0U;
+
+  bool suspended = false;
+
   void create_filters_if_necessary();
 
+  auto create_plugin(const std::string& name) -> std::shared_ptr<PluginBase>;
+
   void remove_unused_filters();
 
   void activate_filters();
@@ -139,4 +163,41 @@ class EffectsBase {
   void deactivate_filters();
 
   void broadcast_pipeline_latency();
+
+  // The "link timing" debug lines written here are parsed by util/soak_test.sh
+  void log_link_timing(const std::string& operation,
+                       const std::chrono::steady_clock::time_point& start,
+                       const size_t& n_links);
+
+  /*
+    Plugins listed in the parallel-plugins key run in parallel with the plugin that comes before them in the plugins
+    key. Each stage is linked to all the nodes of the previous one and PipeWire mixes the branches at its input.
+  */
+
+  std::vector<std::vector<std::string>> linked_stages;
+
+  auto get_stages(const std::vector<std::string>& list) -> std::vector<std::vector<std::string>>;
+
+  void assign_metering_taps();
+
+  // Delays the faster plugins of each stage so that all of its branches have the latency of the slowest one
+  void update_delay_compensation();
+
+  // Scales the branches of each parallel stage by 1 / (number of branches) so that their sum keeps the input level
+  void update_branch_gains();
+
+  // A single main loop source per pipeline emits the level and latency events queued by the realtime threads
+  void start_events_source();
+
+  virtual auto apps_want_to_play() -> bool = 0;
+
+  /*
+    Called when the streams of the pipeline change. When no stream has been connected for idle-suspend-timeout
+    seconds the filters are deactivated and release their heavy state. They are resumed as soon as a stream appears.
+  */
+  void update_idle_state();
+
+  void suspend_filters();
+
+  void resume_filters();
 };
@@ -22,11 +22,14 @@
 #include <gio/gio.h>
 #include <glib.h>
 #include <sys/types.h>
+#include <atomic>
 #include <cstddef>
+#include <memory>
 #include <span>
 #include <string>
 #include <utility>
 #include <vector>
+#include "parametric_eq.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_equalizer.hpp"
@@ -58,6 +61,8 @@ class Equalizer : public PluginBase {
 
   void sort_bands();
 
+  [[nodiscard]] auto using_native_engine() const -> bool { return use_native_engine; }
+
   static constexpr uint max_bands = 32U;
 
  private:
@@ -65,7 +70,15 @@ class Equalizer : public PluginBase {
 
   uint latency_n_frames = 0U;
 
-  std::vector<gulong> gconnections_unified;
+  std::vector<gulong> gconnections_unified, gconnections_left, gconnections_right;
+
+  // Used when the engine key is set to Native or when the LSP plugin is not installed
+
+  std::unique_ptr<ParametricEq> native_eq = std::make_unique<ParametricEq>();
+
+  std::atomic<bool> use_native_engine = false;
+
+  guint native_commit_source_id = 0U;
 
   template <size_t n>
   constexpr void bind_band() {
@@ -108,4 +121,11 @@ class Equalizer : public PluginBase {
   }
 
   void on_split_channels();
+
+  void update_native_band(const uint& channel, const uint& index);
+
+  void update_native_engine();
+
+  // Many keys change at once when a preset is loaded. They are handed to the native engine in a single commit.
+  void schedule_native_commit();
 };
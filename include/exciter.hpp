@@ -47,6 +47,10 @@ class Exciter : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  void emit_meters(const MeterValues& values) override;
+
+  void reset_meters() override;
+
   sigc::signal<void(const double)> harmonics;
 
   double harmonics_port_value = 0.0;
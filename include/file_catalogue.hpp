@@ -0,0 +1,46 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/*
+  Index of the files installed in the community packages directories (presets, impulse responses and RNNoise
+  models). Each directory tree is walked once and kept in memory together with the modification time of every
+  directory in it. A GFileMonitor on each of these directories invalidates the tree when something changes. When a
+  directory cannot be monitored the modification times are compared instead on every lookup.
+*/
+
+namespace file_catalogue {
+
+// Same search order as util::search_filename. Returns an empty string when the file is not found.
+auto find(const std::filesystem::path& root, const std::string& filename, const uint& max_depth) -> std::string;
+
+// Files with the given extension, up to max_depth levels below root. Paths are relative to root.
+auto list(const std::filesystem::path& root, const std::string& extension, const uint& max_depth)
+    -> std::vector<std::filesystem::path>;
+
+// Releases the index and its monitors
+void clear();
+
+}  // namespace file_catalogue
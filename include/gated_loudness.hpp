@@ -0,0 +1,189 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/*
+  K-weighting filter of ITU BS.1770 for stereo signals. The energy of the filtered signal is accumulated in blocks of
+  100 ms and each finished block is given to the callback as a mean square value.
+*/
+
+class KWeighting {
+ public:
+  explicit KWeighting(const uint& rate = 48000U);
+
+  void set_rate(const uint& rate);
+
+  void reset();
+
+  [[nodiscard]] auto get_rate() const -> uint { return rate; }
+
+  template <typename Callback>
+  void process(std::span<const float> left, std::span<const float> right, Callback&& on_subblock) {
+    const auto n_frames = std::min(left.size(), right.size());
+
+    for (size_t n = 0U; n < n_frames; n++) {
+      const double l = rlb_filter[0].process(pre_filter[0].process(left[n]));
+      const double r = rlb_filter[1].process(pre_filter[1].process(right[n]));
+
+      subblock_energy += l * l + r * r;
+
+      if (++subblock_position == subblock_frames) {
+        on_subblock(subblock_energy / static_cast<double>(subblock_frames));
+
+        subblock_position = 0U;
+        subblock_energy = 0.0;
+      }
+    }
+  }
+
+ private:
+  struct Biquad {
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    double z1 = 0.0, z2 = 0.0;
+
+    auto process(const double& x) -> double {
+      const double y = b0 * x + z1;
+
+      z1 = b1 * x - a1 * y + z2;
+      z2 = b2 * x - a2 * y;
+
+      return y;
+    }
+  };
+
+  uint rate = 0U;
+  uint subblock_frames = 1U;
+  uint subblock_position = 0U;
+
+  double subblock_energy = 0.0;
+
+  std::array<Biquad, 2U> pre_filter, rlb_filter;
+};
+
+/*
+  EBU R128 loudness statistics computed from the 100 ms blocks of a KWeighting filter. The gating blocks are kept in
+  histograms of 0.1 LU wide bins, so the cost of the integrated loudness and of the loudness range does not depend on
+  how long the history is. The momentary and short-term values are updated with every block. The integrated
+  loudness, the relative threshold and the loudness range are updated at the interval given to
+  set_update_interval().
+
+  Only add_subblock() is meant to be called in the realtime thread.
+*/
+
+class GatedLoudness {
+ public:
+  // A maximum history of zero keeps every block since the last reset
+  explicit GatedLoudness(const uint& max_history_seconds);
+  GatedLoudness(const GatedLoudness&) = delete;
+  auto operator=(const GatedLoudness&) -> GatedLoudness& = delete;
+  GatedLoudness(const GatedLoudness&&) = delete;
+  auto operator=(const GatedLoudness&&) -> GatedLoudness& = delete;
+  ~GatedLoudness() = default;
+
+  // Mean square of the K-weighted signal over 100 ms, summed over the channels
+  void add_subblock(const double& energy);
+
+  void set_max_history(const uint& seconds);
+
+  // Rounded to a multiple of 100 ms because the statistics only change when a new block arrives
+  void set_update_interval(const uint& milliseconds);
+
+  void reset();
+
+  [[nodiscard]] auto get_momentary() const -> double { return momentary; }
+
+  [[nodiscard]] auto get_shortterm() const -> double { return shortterm; }
+
+  [[nodiscard]] auto get_integrated() const -> double { return integrated; }
+
+  [[nodiscard]] auto get_relative_threshold() const -> double { return relative_threshold; }
+
+  [[nodiscard]] auto get_range() const -> double { return range; }
+
+ private:
+  static constexpr uint n_bins = 1000U;  // from -70 to +30 LUFS
+  static constexpr double min_loudness = -70.0;
+  static constexpr double bin_width = 0.1;
+
+  static constexpr uint momentary_subblocks = 4U;
+  static constexpr uint shortterm_subblocks = 30U;
+  static constexpr uint shortterm_step_subblocks = 10U;  // the loudness range uses 3 s blocks with 2 s of overlap
+
+  struct Histogram {
+    std::array<uint64_t, n_bins> count{};
+    std::array<double, n_bins> energy{};
+
+    uint64_t total_count = 0U;
+    double total_energy = 0.0;
+
+    void add(const double& block_energy);
+    void remove(const double& block_energy);
+    void clear();
+  };
+
+  // Energies of the blocks in the order they were measured, so the oldest can leave the histogram. Nothing has to be
+  // stored when the history is unlimited.
+  struct History {
+    std::vector<double> blocks;
+
+    size_t head = 0U;
+    size_t size = 0U;
+
+    void resize(const size_t& capacity, Histogram& histogram);
+    void push(const double& block_energy, Histogram& histogram);
+  };
+
+  uint update_interval = 1U;  // in blocks of 100 ms
+  uint subblocks_since_update = 0U;
+  uint max_history = 0U;      // seconds, zero means unlimited
+
+  std::array<double, shortterm_subblocks> subblocks{};
+
+  uint subblock_index = 0U;
+  uint n_subblocks = 0U;  // up to shortterm_subblocks
+  uint subblocks_since_shortterm_block = 0U;
+
+  Histogram integrated_histogram, range_histogram;
+  History integrated_history, range_history;
+
+  double momentary = 0.0;
+  double shortterm = 0.0;
+  double integrated = 0.0;
+  double relative_threshold = 0.0;
+  double range = 0.0;
+
+  void update_gated_statistics();
+
+  [[nodiscard]] auto sum_subblocks(const uint& count) const -> double;
+
+  static auto energy_to_loudness(const double& energy) -> double;
+
+  static auto loudness_to_bin(const double& loudness) -> uint;
+
+  static auto bin_center(const uint& bin) -> double;
+};
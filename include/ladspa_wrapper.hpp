@@ -49,6 +49,9 @@ class LadspaWrapper {
 
   auto create_instance(uint rate) -> bool;
 
+  // Frees the instance and the memory it allocated. The control values are kept for the next create_instance().
+  void destroy_instance();
+
   void connect_data_ports(const std::span<const float>& left_in,
                           const std::span<const float>& right_in,
                           const std::span<float>& left_out,
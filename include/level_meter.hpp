@@ -19,13 +19,14 @@
 
 #pragma once
 
-#include <ebur128.h>
 #include <sigc++/signal.h>
 #include <sys/types.h>
+#include <cstdint>
+#include <memory>
 #include <span>
 #include <string>
-#include <thread>
-#include <vector>
+#include "gated_loudness.hpp"
+#include "metering_bus.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -42,8 +43,6 @@ class LevelMeter : public PluginBase {
   auto operator=(const LevelMeter&&) -> LevelMeter& = delete;
   ~LevelMeter() override;
 
-  void setup() override;
-
   void process(std::span<float>& left_in,
                std::span<float>& right_in,
                std::span<float>& left_out,
@@ -51,6 +50,8 @@ class LevelMeter : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  void emit_meters(const MeterValues& values) override;
+
   void reset_history();
 
   sigc::signal<void(const double,  // momentary
@@ -64,10 +65,6 @@ class LevelMeter : public PluginBase {
       results;  // range
 
  private:
-  bool ebur128_ready = false;
-
-  uint old_rate = 0U;
-
   double momentary = 0.0;
   double shortterm = 0.0;
   double global = 0.0;
@@ -77,11 +74,9 @@ class LevelMeter : public PluginBase {
   double true_peak_L = 0.0;
   double true_peak_R = 0.0;
 
-  std::vector<float> data;
-
-  ebur128_state* ebur_state = nullptr;
+  std::unique_ptr<GatedLoudness> meter;
 
-  std::vector<std::thread> mythreads;
+  MeteringTap* last_tap = nullptr;
 
-  auto init_ebur128() -> bool;
+  uint64_t next_subblock = 0U;
 };
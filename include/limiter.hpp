@@ -54,6 +54,10 @@ class Limiter : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  void emit_meters(const MeterValues& values) override;
+
+  void reset_meters() override;
+
   sigc::signal<void(const float)> gain_left, gain_right, sidechain_left, sidechain_right;
 
   float gain_l_port_value = 0.0F;
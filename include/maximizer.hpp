@@ -48,6 +48,10 @@ class Maximizer : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  void emit_meters(const MeterValues& values) override;
+
+  void reset_meters() override;
+
   sigc::signal<void(const double)> reduction;
 
   double reduction_port_value = 0.0;
@@ -0,0 +1,156 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "gated_loudness.hpp"
+#include "polyphase_resampler.hpp"
+
+/*
+  Analysis of the signal at one point of a pipeline. The first plugin that looks at the signal in a graph cycle does
+  the analysis and everybody else reads the results. Sample peak and RMS are always measured. K-weighted loudness and
+  true peak are only computed while somebody is subscribed to them.
+*/
+
+class MeteringTap {
+ public:
+  MeteringTap();
+  MeteringTap(const MeteringTap&) = delete;
+  auto operator=(const MeteringTap&) -> MeteringTap& = delete;
+  MeteringTap(const MeteringTap&&) = delete;
+  auto operator=(const MeteringTap&&) -> MeteringTap& = delete;
+  ~MeteringTap() = default;
+
+  enum class Feature { loudness, true_peak };
+
+  void subscribe(const Feature& feature);
+
+  void unsubscribe(const Feature& feature);
+
+  [[nodiscard]] auto has_subscribers() const -> bool;
+
+  /*
+    Called in the realtime threads. Only the first call for a graph position does the analysis, the others return
+    immediately even if the first one has not finished yet. They read the last published results until it does.
+  */
+  void analyze(std::span<const float> left, std::span<const float> right, const uint& rate, const uint64_t& position);
+
+  [[nodiscard]] auto get_peak(const uint& channel) const -> float {
+    return get_published_results().peak[channel].load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto get_rms(const uint& channel) const -> float {
+    return get_published_results().rms[channel].load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto get_true_peak(const uint& channel) const -> float {
+    return get_published_results().true_peak[channel].load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto get_subblock_count() const -> uint64_t { return subblock_count.load(std::memory_order_acquire); }
+
+  /*
+    Gives to the callback the K-weighted 100 ms blocks measured since the block number "next" and updates it. Readers
+    that fell too far behind skip the blocks that are not stored anymore.
+  */
+
+  template <typename Callback>
+  void read_subblocks(uint64_t& next, Callback&& callback) const {
+    const auto count = get_subblock_count();
+
+    if (next > count || count - next > n_stored_subblocks) {
+      next = count;
+    }
+
+    for (; next < count; next++) {
+      callback(subblock_energies[next % n_stored_subblocks]);
+    }
+  }
+
+ private:
+  static constexpr uint n_stored_subblocks = 64U;
+
+  std::atomic<int> loudness_subscribers = 0, true_peak_subscribers = 0;
+
+  std::atomic<uint64_t> claimed_position = UINT64_MAX, analyzed_position = UINT64_MAX;
+
+  KWeighting kweighting;
+
+  std::array<double, n_stored_subblocks> subblock_energies{};
+
+  std::atomic<uint64_t> subblock_count = 0U;
+
+  std::unique_ptr<PolyphaseResampler> oversampler_left, oversampler_right;
+
+  std::vector<float> oversampled;
+
+  /*
+    The analysis fills the slot that is not published and then publishes it. Readers never see a slot that is being
+    written unless they hold on to it for a whole graph cycle.
+  */
+
+  struct Results {
+    std::array<std::atomic<float>, 2U> peak{}, rms{}, true_peak{};
+  };
+
+  std::array<Results, 2U> results;
+
+  std::atomic<uint> published_results = 0U;
+
+  [[nodiscard]] auto get_published_results() const -> const Results& {
+    return results[published_results.load(std::memory_order_acquire)];
+  }
+
+  void measure_true_peak(std::span<const float> input,
+                         PolyphaseResampler& oversampler,
+                         const uint& channel,
+                         Results& output);
+};
+
+/*
+  Owned by each pipeline. Taps are named after the node whose output they measure and are never removed, so the raw
+  pointers used by the realtime threads stay valid while the bus exists.
+*/
+
+class MeteringBus {
+ public:
+  MeteringBus() = default;
+  MeteringBus(const MeteringBus&) = delete;
+  auto operator=(const MeteringBus&) -> MeteringBus& = delete;
+  MeteringBus(const MeteringBus&&) = delete;
+  auto operator=(const MeteringBus&&) -> MeteringBus& = delete;
+  ~MeteringBus() = default;
+
+  static constexpr auto source_tap = "source";
+
+  // Main thread only
+  auto get_tap(const std::string& name) -> std::shared_ptr<MeteringTap>;
+
+ private:
+  std::map<std::string, std::shared_ptr<MeteringTap>> taps;
+};
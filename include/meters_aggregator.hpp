@@ -0,0 +1,48 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+#include <memory>
+#include "plugin_base.hpp"
+
+/*
+  The plugin boxes do not update their level meters when the levels arrive. They register the meters here and the
+  plugins box of each pipeline refreshes them from a frame clock tick callback. Only the box that is mapped is updated
+  and only when its plugin has new levels, so pages that are not visible cost nothing.
+*/
+
+namespace ui::meters_aggregator {
+
+struct Meters {
+  GtkLevelBar* left = nullptr;
+  GtkLabel* left_label = nullptr;
+  GtkLevelBar* right = nullptr;
+  GtkLabel* right_label = nullptr;
+};
+
+void add(GtkWidget* box, const std::shared_ptr<PluginBase>& plugin, const Meters& input, const Meters& output = {});
+
+void remove(GtkWidget* box);
+
+// Called once per frame with the visible plugin box
+void update(GtkWidget* box);
+
+}  // namespace ui::meters_aggregator
@@ -61,6 +61,10 @@ class MultibandGate : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  void emit_meters(const MeterValues& values) override;
+
+  void reset_meters() override;
+
   void update_probe_links() override;
 
   sigc::signal<void(const std::array<float, n_bands>)> reduction, envelope, curve, frequency_range;
@@ -79,6 +83,8 @@ class MultibandGate : public PluginBase {
 
   void update_sidechain_links(const std::string& key);
 
+  void post_port_arrays();
+
   template <size_t n>
   constexpr void bind_band() {
     using namespace tags::multiband_gate;
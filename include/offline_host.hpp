@@ -0,0 +1,70 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <memory>
+#include <span>
+#include <vector>
+#include "plugin_base.hpp"
+
+/*
+  Runs a plugin without PipeWire. It plays the role of the PipeWire node: it sets the rate and the quantum, calls
+  setup() the way the reconfiguration worker does and feeds PluginBase::process_quantum() with blocks of exactly one
+  quantum. Everything happens in the calling thread, so the output only depends on the input and on the settings.
+
+  The plugin has to be created with a null PipeManager and must never be connected to PipeWire. Its PipeWire members
+  stay in PluginBase, unused, and the calls that would talk to the server return early when there is no PipeManager.
+*/
+
+class OfflineHost {
+ public:
+  explicit OfflineHost(std::shared_ptr<PluginBase> plugin);
+  OfflineHost(const OfflineHost&) = delete;
+  auto operator=(const OfflineHost&) -> OfflineHost& = delete;
+  OfflineHost(const OfflineHost&&) = delete;
+  auto operator=(const OfflineHost&&) -> OfflineHost& = delete;
+  ~OfflineHost() = default;
+
+  // Calls setup() and waits for the work it defers to the main loop
+  void configure(const uint& rate, const uint& quantum);
+
+  // The spans must have the same size. The last incomplete block is padded with silence.
+  void process(std::span<const float> left_in,
+               std::span<const float> right_in,
+               std::span<float> left_out,
+               std::span<float> right_out);
+
+  [[nodiscard]] auto get_plugin() const -> std::shared_ptr<PluginBase> { return plugin; }
+
+  [[nodiscard]] auto get_quantum() const -> uint { return quantum; }
+
+  [[nodiscard]] auto get_latency_seconds() const -> float;
+
+  // Dispatches the callbacks that plugins schedule with util::idle_add
+  static void drain_main_context();
+
+ private:
+  std::shared_ptr<PluginBase> plugin;
+
+  uint quantum = 0U;
+
+  std::vector<float> left_in_buffer, right_in_buffer, left_out_buffer, right_out_buffer, probe_left, probe_right;
+};
@@ -0,0 +1,200 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+
+/*
+  Native parametric equalizer with up to 32 bands per channel. Each band is a cascade of trapezoidal state variable
+  filter sections. The left and right channels run in the two lanes of a GCC/Clang vector, so processing a band costs
+  the same whether or not the channels have the same settings. Only the sections of enabled bands run, and a
+  bell or shelf band at 0 dB counts as disabled.
+
+  The coefficients are computed outside the realtime thread, only for the bands whose parameters changed, and are
+  published by commit(). process() moves its coefficients towards the published ones sample by sample, so changing a
+  band does not click.
+*/
+
+class ParametricEq {
+ public:
+  // Same order as the bandtype, bandmode and bandslope enums of the equalizer schema
+
+  enum class Type {
+    off,
+    bell,
+    hi_pass,
+    hi_shelf,
+    lo_pass,
+    lo_shelf,
+    notch,
+    resonance,
+    allpass,
+    bandpass,
+    ladder_pass,
+    ladder_rej
+  };
+
+  enum class Mode { rlc_bt, rlc_mt, bwc_bt, bwc_mt, lrx_bt, lrx_mt, apo_dr };
+
+  struct Band {
+    Type type = Type::off;
+    Mode mode = Mode::rlc_bt;
+    uint slope = 0U;  // 0 to 3 for x1 to x4
+    double frequency = 1000.0;
+    double gain = 0.0;  // dB
+    double q = 0.707;
+    bool solo = false;
+    bool mute = false;
+
+    auto operator==(const Band&) const -> bool = default;
+  };
+
+  ParametricEq();
+  ParametricEq(const ParametricEq&) = delete;
+  auto operator=(const ParametricEq&) -> ParametricEq& = delete;
+  ParametricEq(const ParametricEq&&) = delete;
+  auto operator=(const ParametricEq&&) -> ParametricEq& = delete;
+  ~ParametricEq();
+
+  static constexpr uint max_bands = 32U;
+
+  // The setters below can be called from any thread but the realtime one. Nothing changes until commit().
+
+  void set_rate(const uint& rate);
+
+  void set_band(const uint& channel, const uint& index, const Band& band);
+
+  void set_balance(const double& value);  // -100 to 100
+
+  void set_pitch(const uint& channel, const double& semitones);
+
+  void commit();
+
+  // Realtime thread. Passes the audio through until the first commit().
+  void process(std::span<const float> left_in,
+               std::span<const float> right_in,
+               std::span<float> left_out,
+               std::span<float> right_out);
+
+  // Number of sections process() is running. Only meant for diagnostics.
+  [[nodiscard]] auto get_active_sections() const -> uint { return n_running; }
+
+ private:
+  using v2sf = float __attribute__((vector_size(8)));
+
+  static constexpr uint sections_per_band = 8U;  // slope x4 in the Linkwitz-Riley modes
+  static constexpr uint max_sections = max_bands * sections_per_band;
+  static constexpr uint block_size = 256U;
+
+  struct Section {
+    float a1 = 1.0F, a2 = 0.0F, a3 = 0.0F, m0 = 1.0F, m1 = 0.0F, m2 = 0.0F;
+  };
+
+  struct Coefficients {
+    v2sf a1, a2, a3, m0, m1, m2;
+  };
+
+  struct Design {
+    std::array<Coefficients, max_sections> target{};
+
+    std::array<bool, max_sections> active{};
+
+    v2sf gain{};
+
+    float alpha = 1.0F;  // per sample smoothing factor of the coefficients
+
+    uint64_t serial = 0U;
+
+    uint64_t reset_serial = 0U;  // incremented when the filter state has to be cleared, like after a rate change
+  };
+
+  // state used outside of the realtime thread
+
+  std::mutex mutex;
+
+  uint rate = 0U;
+
+  uint64_t serial = 0U, reset_serial = 0U;
+
+  double balance = 0.0;
+
+  std::array<double, 2U> pitch{};
+
+  std::array<std::array<Band, max_bands>, 2U> bands{};
+
+  std::array<std::array<bool, max_bands>, 2U> dirty{};
+
+  std::array<std::array<uint, max_bands>, 2U> n_sections{};
+
+  std::array<std::array<Section, max_sections>, 2U> sections{};
+
+  std::unique_ptr<Design> design;
+
+  // handoff to the realtime thread. Same scheme as the compensation delay line of PluginBase.
+
+  std::atomic<Design*> design_ptr = nullptr;
+
+  std::atomic<bool> busy = false;
+
+  // realtime thread state
+
+  bool has_design = false;
+
+  uint64_t applied_serial = 0U, applied_reset_serial = 0U;
+
+  bool smoothing = false;
+
+  float alpha = 1.0F;
+
+  v2sf gain = {1.0F, 1.0F};
+
+  v2sf target_gain = {1.0F, 1.0F};
+
+  std::array<Coefficients, max_sections> current{};
+
+  std::array<Coefficients, max_sections> target{};
+
+  std::array<v2sf, max_sections> ic1{}, ic2{};
+
+  std::array<bool, max_sections> target_active{}, running{};
+
+  std::array<uint, max_sections> running_list{};
+
+  uint n_running = 0U;
+
+  std::array<v2sf, block_size> frames{};
+
+  void compute_band(const uint& channel, const uint& index);
+
+  void take_design(const Design& d);
+
+  void update_running_list();
+
+  void finish_smoothing();
+
+  template <bool smooth>
+  void run_section(const uint& s, const uint& count);
+};
@@ -82,6 +82,9 @@ class PipeManager {
 
   std::array<std::string, 2U> blocklist_media_role = {"event", "Notification"};
 
+  // Upper limit of the data loops that process our filters
+  constexpr static uint max_data_loops = 4U;
+
   std::string header_version, library_version, core_name, version;
   std::string default_clock_rate = "0";
   std::string default_min_quantum = "0";
@@ -25,16 +25,21 @@
 #include <sigc++/signal.h>
 #include <spa/utils/hook.h>
 #include <sys/types.h>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <span>
 #include <string>
 #include <vector>
+#include "delay_line.hpp"
 #include "lv2_wrapper.hpp"
+#include "metering_bus.hpp"
 #include "pipe_manager.hpp"
 #include "pipeline_type.hpp"
+#include "spsc_ring.hpp"
 #include "util.hpp"
 
 class PluginBase {
@@ -86,6 +91,10 @@ class PluginBase {
 
   bool enable_probe = false;
 
+  /*
+    Written by the reconfiguration worker while holding data_mutex. Main thread code reading them has to lock it. In
+    plugins that do not set quantum_needs_setup the realtime thread may update n_samples too.
+  */
   uint n_samples = 0U;
 
   uint rate = 0U;
@@ -103,18 +112,57 @@ class PluginBase {
 
   float notification_time_window = 1.0F / 20.0F;  // seconds
 
-  float latency_value = 0.0F;  // seconds
+  std::atomic<float> latency_value = 0.0F;  // seconds, written by the realtime thread
+
+  uint64_t clock_position = 0U;  // position of the graph cycle being processed
 
   std::chrono::time_point<std::chrono::system_clock> clock_start;
 
   std::vector<float> dummy_left, dummy_right;
 
+  std::vector<float> mono_buffer;  // downmix of the input in mono mode. The input buffers may be shared.
+
+  static constexpr uint default_max_quantum = 8192U;
+
+  // The dummy buffers are allocated for this quantum. It is raised to PipeWire's default.clock.max-quantum if needed.
+  uint max_quantum = default_max_quantum;
+
+  /*
+    Quantum and rate changes are not handled in the realtime thread. It only writes the new values below and bumps
+    pending_serial. A worker thread then calls setup() and stores the serial it handled in applied_serial. Until then
+    process() keeps being called with the previous state if it was set up for the current quantum. Silence is written
+    while setup() runs and while the quantum differs from applied_n_samples.
+  */
+
+  std::atomic<uint> pending_rate = 0U, pending_n_samples = 0U;
+
+  std::atomic<uint64_t> pending_serial = 0U, applied_serial = 0U;
+
+  std::atomic<uint> applied_n_samples = 0U;
+
+  // Set by the worker around setup() and by the realtime thread around process(). They never run at the same time.
+  std::atomic<bool> configuring = false, processing = false;
+
+  /*
+    Plugins whose state does not depend on the quantum, besides the block length of their LV2 instance, set it to
+    false in their constructor. A quantum that is not larger than max_quantum is then applied by the realtime thread
+    at the start of the next cycle, without setup().
+  */
+  bool quantum_needs_setup = true;
+
   [[nodiscard]] auto get_node_id() const -> uint;
 
   void set_active(const bool& state) const;
 
   void set_post_messages(const bool& state);
 
+  /*
+    The constructors only read the settings and load the plugin libraries, so they can run in any thread. The
+    PipeWire filter is created here, in the main thread, after the plugin is constructed.
+  */
+
+  void create_pw_filter();
+
   auto connect_to_pw() -> bool;
 
   void disconnect_from_pw();
@@ -129,6 +177,18 @@ class PluginBase {
 
   virtual void setup();
 
+  // Realtime thread only. Used instead of setup() when quantum_needs_setup is false.
+  void set_quantum_in_place(const uint& value);
+
+  /*
+    Main thread only. Called by the pipeline when no stream has been connected to it for a while. Plugins release the
+    state that is expensive to keep, like threads and models, but that can be rebuilt quickly in resume().
+  */
+
+  virtual void suspend();
+
+  virtual void resume();
+
   virtual void process(std::span<float>& left_in,
                        std::span<float>& right_in,
                        std::span<float>& left_out,
@@ -143,8 +203,88 @@ class PluginBase {
 
   virtual void update_probe_links();
 
+  /*
+    DSP core of the filter, independent of PipeWire. It analyzes the input, skips the processing once the tail has
+    decayed, calls process() and delays the output for the latency compensation. The PipeWire node calls it from its
+    process callback and OfflineHost calls it to run the plugin without an audio server. The probe spans are only
+    used when enable_probe is set.
+  */
+  void process_quantum(std::span<float> left_in,
+                       std::span<float> right_in,
+                       std::span<float> left_out,
+                       std::span<float> right_out,
+                       std::span<float> probe_left,
+                       std::span<float> probe_right);
+
+  // Called by the pipeline when it is linked. The input tap measures the output of the previous node.
+  void set_metering_taps(std::shared_ptr<MeteringTap> input, std::shared_ptr<MeteringTap> output);
+
+  // Called in the realtime thread before process(), while the input buffers still hold the signal of the previous node
+  void analyze_input(std::span<const float> left, std::span<const float> right);
+
   virtual auto get_latency_seconds() -> float;
 
+  /*
+    Called in the realtime thread in place of process() once the tail has decayed, when notifications are due.
+    Plugins with meters of their own post the values they show without a signal.
+  */
+  virtual void reset_meters();
+
+  /*
+    Main thread only. Delays the output of a plugin that runs in parallel with slower ones so that all the branches
+    are aligned when PipeWire mixes them. Zero removes the delay line.
+  */
+  void set_compensation_delay(const float& seconds);
+
+  [[nodiscard]] auto get_compensation_delay() const -> float { return compensation_seconds; }
+
+  /*
+    Main thread only. PipeWire sums the branches of a parallel stage without any gain, so the pipeline scales each of
+    them by 1 / (number of branches). The output gain of the plugins sets the balance of the mix.
+  */
+  void set_branch_gain(const float& value);
+
+  [[nodiscard]] auto get_branch_gain() const -> float { return branch_gain; }
+
+  // Called in the realtime thread after process()
+  void apply_compensation_delay(std::span<float>& left, std::span<float>& right);
+
+  // Time the output of the plugin takes to decay after its input becomes silent, not counting its latency
+  [[nodiscard]] auto get_tail_seconds() const -> float { return tail_value; }
+
+  /*
+    Called in the realtime thread. Returns true once the input has been silent for longer than the tail, latency and
+    compensation delay of the plugin. The output would be silent too, so process() does not have to be called.
+  */
+  auto tail_has_decayed(std::span<const float> left, std::span<const float> right) -> bool;
+
+  static constexpr size_t max_meter_values = 32U;
+
+  // Values of the meters of a plugin. Each plugin decides their order in post_meters() and emit_meters().
+  using MeterValues = std::array<double, max_meter_values>;
+
+  /*
+    Sent by the realtime thread. dispatch_events() emits them in the main thread. Level events carry the input left
+    and right and the output left and right peaks in the first four values.
+  */
+  struct Event {
+    enum class Type { levels, meters };
+
+    Type type = Type::levels;
+
+    MeterValues values{};
+  };
+
+  // Main thread only. Several level or meter events are merged into one emission with the newest values. A pending
+  // latency change is emitted once.
+  void dispatch_events();
+
+  // Main thread only. Newest input (left, right) and output (left, right) levels handled by dispatch_events(). The
+  // serial is incremented every time they change so that the meters can skip the frames without new values.
+  [[nodiscard]] auto get_levels() const -> std::array<float, 4U> { return levels; }
+
+  [[nodiscard]] auto get_levels_serial() const -> uint64_t { return levels_serial; }
+
   sigc::signal<void(const float, const float)> input_level;
   sigc::signal<void(const float, const float)> output_level;
   sigc::signal<void()> latency;
@@ -154,6 +294,10 @@ class PluginBase {
 
   GSettings *settings = nullptr, *global_settings = nullptr;
 
+  /*
+    Null when the plugin runs without PipeWire, like in OfflineHost and ee-bench. The filter is never created in that
+    case and everything reachable from setup(), process() and the settings handlers has to check it before using it.
+  */
   PipeManager* pm = nullptr;
 
   spa_hook listener{};
@@ -162,6 +306,12 @@ class PluginBase {
 
   bool post_messages = false;
 
+  // Plugins whose output rings longer than the default margin set it. It may be changed in any thread.
+  std::atomic<float> tail_value = 0.0F;
+
+  // The meters and the spectrum have to see the silence
+  bool skip_silence = true;
+
   uint n_ports = 4U;
 
   float input_gain = 1.0F;
@@ -171,12 +321,39 @@ class PluginBase {
 
   std::vector<gulong> gconnections;
 
+  // Used by the voice plugins. When the microphone is mono the expensive model only has to run on the left channel.
+
+  enum class ChannelMode { automatic, stereo, mono };
+
+  ChannelMode channel_mode = ChannelMode::automatic;
+
   void setup_input_output_gain();
 
+  void setup_channel_mode();
+
+  // Returns true when only the left channel has to be processed and its output copied to the right channel. In mono
+  // mode left is pointed to a downmix of both channels and the input buffers are left untouched. In automatic mode
+  // the channels have to be practically identical for half a second before the fast path is used.
+  auto use_mono_path(std::span<float>& left, std::span<float>& right) -> bool;
+
   void initialize_listener();
 
   void notify();
 
+  // Called in the realtime thread. Queues the values of the plugin meters for emit_meters().
+  void post_meters(const MeterValues& values);
+
+  // Called in the main thread by dispatch_events() with the newest values given to post_meters()
+  virtual void emit_meters(const MeterValues& values);
+
+  // Tells the main thread that latency_value changed
+  void notify_latency_change();
+
+  // Features of the input tap this plugin reads in process(). The subscriptions follow the plugin when it is moved.
+  void subscribe_input_metering(const MeteringTap::Feature& feature);
+
+  [[nodiscard]] auto get_input_tap() const -> MeteringTap* { return input_tap_ptr.load(std::memory_order_acquire); }
+
   void get_peaks(const std::span<float>& left_in,
                  const std::span<float>& right_in,
                  std::span<float>& left_out,
@@ -189,6 +366,46 @@ class PluginBase {
  private:
   uint node_id = 0U;
 
+  uint mono_frames = 0U;
+
+  static auto parse_channel_mode(const int& value) -> ChannelMode;
+
+  std::shared_ptr<MeteringTap> input_tap, output_tap;
+
+  std::atomic<MeteringTap*> input_tap_ptr = nullptr, output_tap_ptr = nullptr;
+
+  std::vector<MeteringTap::Feature> input_metering_features;
+
+  // The delay line is allocated for this rate so that it does not have to be replaced when the rate changes
+  static constexpr uint max_compensation_rate = 192000U;
+
+  std::unique_ptr<DelayLine> compensation_line;
+
+  std::atomic<DelayLine*> compensation_line_ptr = nullptr;
+
+  std::atomic<float> compensation_seconds = 0.0F;
+
+  std::atomic<bool> compensation_busy = false;
+
+  std::atomic<float> branch_gain = 1.0F;
+
+  static constexpr float silence_threshold = 0.000001F;  // -120 dB
+
+  // Covers the filters ringing and the release of envelopes, that are not declared as tails
+  static constexpr float silence_margin = 1.0F;  // seconds
+
+  uint64_t silent_frames = 0U;
+
+  SpscRing<Event> events{64U};
+
+  // Latency changes must never be lost, so they do not go through the events queue, which may be full
+  std::atomic<bool> latency_dirty = false;
+
+  std::array<float, 4U> levels{util::minimum_linear_level, util::minimum_linear_level, util::minimum_linear_level,
+                               util::minimum_linear_level};
+
+  uint64_t levels_serial = 0U;
+
   float input_peak_left = util::minimum_linear_level, input_peak_right = util::minimum_linear_level;
   float output_peak_left = util::minimum_linear_level, output_peak_right = util::minimum_linear_level;
 };
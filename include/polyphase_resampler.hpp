@@ -0,0 +1,116 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/*
+  Streaming resampler meant to be used inside the realtime thread. Every buffer is allocated in the constructor for
+  the maximum number of input frames given there, so process() never allocates. The number of frames produced by
+  each call only depends on the number of input frames and on the internal phase, and the latency is constant.
+
+  Rational ratios with a small denominator (44.1 <-> 48 kHz, 16 <-> 48 kHz, 2x, etc) use an exact polyphase filter
+  bank. Other ratios interpolate between the phases of a 256 phases bank.
+*/
+
+class PolyphaseResampler {
+ public:
+  enum class Quality { fast, balanced, best };
+
+  PolyphaseResampler(const uint& input_rate,
+                     const uint& output_rate,
+                     const uint& max_input_frames,
+                     const Quality& quality = Quality::balanced);
+  PolyphaseResampler(const PolyphaseResampler&) = delete;
+  auto operator=(const PolyphaseResampler&) -> PolyphaseResampler& = delete;
+  PolyphaseResampler(const PolyphaseResampler&&) = delete;
+  auto operator=(const PolyphaseResampler&&) -> PolyphaseResampler& = delete;
+  ~PolyphaseResampler() = default;
+
+  static constexpr uint default_max_input_frames = 8192U;
+
+  static auto quality_from_int(const int& value) -> Quality;
+
+  // Resamples all input frames. Returns how many frames were written to output. The output span must have room for
+  // get_max_output_frames(input.size()) frames.
+  auto process(std::span<const float> input, std::span<float> output) -> size_t;
+
+  // Resamples all input frames and always writes output.size() frames. A small internal queue primed with silence
+  // absorbs the difference between the produced and the requested number of frames. When the input arrives in bursts
+  // (for example in blocks of a model that has a fixed frame size) set_input_block_size() has to be called first.
+  void process_fixed(std::span<const float> input, std::span<float> output);
+
+  void set_input_block_size(const uint& frames);
+
+  void reset();
+
+  // Continues from the state of a resampler built with the same arguments. Used to resume a channel that was skipped
+  // while it carried the same signal as the other one.
+  void copy_state(const PolyphaseResampler& other);
+
+  // Exact number of frames the next call to process() will produce for the given number of input frames
+  [[nodiscard]] auto get_output_frames(const size_t& n_input) const -> size_t;
+
+  [[nodiscard]] auto get_max_output_frames(const size_t& n_input) const -> size_t;
+
+  [[nodiscard]] auto get_max_input_frames() const -> uint { return max_input_frames; }
+
+  // Group delay of the filter in output frames
+  [[nodiscard]] auto get_latency_frames() const -> uint;
+
+  // Latency of process_fixed() in output frames. It includes the filter group delay.
+  [[nodiscard]] auto get_fixed_latency_frames() const -> uint;
+
+  [[nodiscard]] auto get_ratio() const -> double { return static_cast<double>(up) / static_cast<double>(down); }
+
+ private:
+  static constexpr uint max_exact_phases = 512U;
+  static constexpr uint interpolated_phases = 256U;
+  static constexpr uint simd_width = 4U;
+
+  uint up = 1U;    // output rate / gcd
+  uint down = 1U;  // input rate / gcd
+
+  uint max_input_frames = default_max_input_frames;
+  uint n_phases = 1U;
+  uint n_taps = 0U;
+  uint input_block_size = 0U;
+  uint prime_frames = 0U;
+
+  bool exact = true;
+
+  uint64_t phase = 0U;  // position of the next output frame relative to the newest history frame, in 1/up units
+
+  std::vector<float> coefficients;  // n_phases + 1 rows of n_taps reversed coefficients
+  std::vector<float> history;       // n_taps - 1 old frames followed by the current input
+
+  std::vector<float> fixed_buffer;  // ring buffer used by process_fixed()
+  std::vector<float> fixed_scratch;
+  size_t fixed_read = 0U;
+  size_t fixed_count = 0U;
+
+  void design_filter(const Quality& quality);
+
+  [[nodiscard]] auto dot(const float* x, const float* h) const -> float;
+};
@@ -0,0 +1,48 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <glib.h>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+  Compiled form of the preset files. After a preset is loaded from its json file, the pipeline keys and every plugin
+  key written while reading it are stored in a GVariant image in the user cache directory. The image is used on the
+  next loads as long as the modification time and the size of the json file, and the application version, are the
+  same. Applying it writes the values in bulk without parsing the json or going through the preset classes.
+*/
+
+namespace preset_cache {
+
+struct Image {
+  std::vector<std::string> plugins, parallel_plugins, blocklist;
+
+  std::shared_ptr<GVariant> values;  // see settings_store::stop_recording()
+};
+
+auto load(const std::filesystem::path& preset_file) -> std::optional<Image>;
+
+void save(const std::filesystem::path& preset_file, const Image& image);
+
+}  // namespace preset_cache
@@ -22,6 +22,7 @@
 #include <gio/gio.h>
 #include <sigc++/signal.h>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
@@ -56,10 +57,6 @@ class PresetsManager {
 
   auto get_all_community_presets_paths(const PresetType& preset_type) -> std::vector<std::string>;
 
-  auto scan_community_package_recursive(std::filesystem::directory_iterator& it,
-                                        const uint& top_scan_level,
-                                        const std::string& origin = "") -> std::vector<std::string>;
-
   auto get_community_preset_info(const PresetType& preset_type, const std::string& path)
       -> std::pair<std::string, std::string>;
 
@@ -129,6 +126,12 @@ class PresetsManager {
   sigc::signal<void(const std::vector<nlohmann::json>& profiles)> autoload_output_profiles_changed;
 
  private:
+  struct AutoloadProfile {
+    std::string device, device_description, device_profile, preset_name;
+
+    auto operator==(const AutoloadProfile&) const -> bool = default;
+  };
+
   std::string user_config_dir;
 
   std::filesystem::path user_input_dir, user_output_dir, user_irs_dir, user_rnnoise_dir, autoload_input_dir,
@@ -142,6 +145,18 @@ class PresetsManager {
 
   GFileMonitor *autoload_output_monitor = nullptr, *autoload_input_monitor = nullptr;
 
+  // The autoload files indexed by "device:profile". They are read once and kept up to date by the file monitors.
+
+  std::map<std::string, AutoloadProfile> autoload_output_profiles, autoload_input_profiles;
+
+  auto get_autoload_map(const PresetType& preset_type) -> std::map<std::string, AutoloadProfile>&;
+
+  void load_autoload_profiles(const PresetType& preset_type);
+
+  // Returns true when the map of autoload profiles changed
+  auto update_autoload_profile(const PresetType& preset_type, const std::filesystem::path& path, const bool& removed)
+      -> bool;
+
   static void create_user_directory(const std::filesystem::path& path);
 
   auto import_addons_from_community_package(const PresetType& preset_type,
@@ -154,10 +169,20 @@ class PresetsManager {
 
   auto load_preset_file(const PresetType& preset_type, const std::filesystem::path& input_file) -> bool;
 
+  // Applies the cached image of the preset file, if there is an up to date one
+  auto load_compiled_preset(const PresetType& preset_type, const std::filesystem::path& input_file) -> bool;
+
+  // Saves the values written while the preset file was read from json. It ends the settings_store recording.
+  void compile_preset(const PresetType& preset_type, const std::filesystem::path& input_file);
+
   void save_blocklist(const PresetType& preset_type, nlohmann::json& json);
 
   auto load_blocklist(const PresetType& preset_type, const nlohmann::json& json) -> bool;
 
+  // Entries of the parallel-plugins key that belong to the given plugins list
+  static auto get_parallel_plugins(GSettings* settings, const std::vector<std::string>& plugins)
+      -> std::vector<std::string>;
+
   void notify_error(const PresetError& preset_error, const std::string& plugin_name = "");
 
   static auto create_wrapper(const PresetType& preset_type, std::string_view filter_name)
@@ -47,4 +47,5 @@ class Reverb : public PluginBase {
   auto get_latency_seconds() -> float override;
 
  private:
+  void update_tail();
 };
@@ -35,7 +35,7 @@
 
 #include <deque>
 #include "plugin_base.hpp"
-#include "resampler.hpp"
+#include "polyphase_resampler.hpp"
 
 class RNNoise : public PluginBase {
  public:
@@ -82,6 +82,7 @@ class RNNoise : public PluginBase {
   bool rnnoise_ready = false;
   bool resampler_ready = false;
   bool enable_vad = false;
+  bool mono_input = false;
 
   uint blocksize = 480U;
   uint rnnoise_rate = 48000U;
@@ -96,10 +97,13 @@ class RNNoise : public PluginBase {
   std::deque<float> deque_out_L, deque_out_R;
 
   std::vector<float> data_L, data_R, data_tmp;
+  std::vector<float> resampled_in_L, resampled_in_R;
   std::vector<float> resampled_data_L, resampled_data_R;
 
-  std::unique_ptr<Resampler> resampler_inL, resampler_outL;
-  std::unique_ptr<Resampler> resampler_inR, resampler_outR;
+  std::unique_ptr<PolyphaseResampler> resampler_inL, resampler_outL;
+  std::unique_ptr<PolyphaseResampler> resampler_inR, resampler_outR;
+
+  bool mono_resampling = false;  // the right resamplers were skipped in the previous call
 
 #ifdef ENABLE_RNNOISE
 
@@ -115,94 +119,87 @@ class RNNoise : public PluginBase {
   void free_rnnoise();
 
   template <typename T1, typename T2>
-  void remove_noise(const T1& left_in, const T1& right_in, T2& out_L, T2& out_R) {
-    for (const auto& v : left_in) {
-      data_L.push_back(v);
+  void remove_noise_channel(const T1& input,
+                            std::vector<float>& data,
+                            DenoiseState* state,
+                            float& vad_prob,
+                            int& vad_grace,
+                            T2& out) {
+    for (const auto& v : input) {
+      data.push_back(v);
 
-      if (data_L.size() == blocksize) {
-        if (state_left != nullptr) {
-          std::ranges::for_each(data_L, [](auto& v) { v *= static_cast<float>(SHRT_MAX + 1); });
+      if (data.size() == blocksize) {
+        if (state != nullptr) {
+          std::ranges::for_each(data, [](auto& v) { v *= static_cast<float>(SHRT_MAX + 1); });
 
-          data_tmp = data_L;
+          data_tmp = data;
 
-          vad_prob_left = rnnoise_process_frame(state_left, data_L.data(), data_L.data());
+          vad_prob = rnnoise_process_frame(state, data.data(), data.data());
 
           if (enable_vad) {
-            if (vad_prob_left >= vad_thres) {
-              vad_grace_left = release;
+            if (vad_prob >= vad_thres) {
+              vad_grace = release;
             }
 
-            if (vad_grace_left >= 0) {
-              --vad_grace_left;
+            if (vad_grace >= 0) {
+              --vad_grace;
 
-              for (size_t i = 0U; i < data_L.size(); i++) {
-                data_L[i] = data_L[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
+              for (size_t i = 0U; i < data.size(); i++) {
+                data[i] = data[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
 
-                data_L[i] *= inv_short_max;
+                data[i] *= inv_short_max;
               }
             } else {
-              std::ranges::for_each(data_L, [&](auto& v) { v = 0.0F; });
+              std::ranges::for_each(data, [&](auto& v) { v = 0.0F; });
             }
           } else {
-            for (size_t i = 0U; i < data_L.size(); i++) {
-              data_L[i] = data_L[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
+            for (size_t i = 0U; i < data.size(); i++) {
+              data[i] = data[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
 
-              data_L[i] *= inv_short_max;
+              data[i] *= inv_short_max;
             }
           }
         }
 
-        for (const auto& v : data_L) {
-          out_L.push_back(v);
+        for (const auto& v : data) {
+          out.push_back(v);
         }
 
-        data_L.resize(0U);
+        data.resize(0U);
       }
     }
+  }
 
-    for (const auto& v : right_in) {
-      data_R.push_back(v);
+  template <typename T1, typename T2>
+  void remove_noise(const T1& left_in, const T1& right_in, T2& out_L, T2& out_R, const bool& mono) {
+    if (mono) {
+      // the model runs only on the left channel and its output is duplicated
 
-      if (data_R.size() == blocksize) {
-        if (state_right != nullptr) {
-          std::ranges::for_each(data_R, [](auto& v) { v *= static_cast<float>(SHRT_MAX + 1); });
+      const auto n_before = out_L.size();
 
-          data_tmp = data_R;
+      remove_noise_channel(left_in, data_L, state_left, vad_prob_left, vad_grace_left, out_L);
 
-          vad_prob_right = rnnoise_process_frame(state_right, data_R.data(), data_R.data());
+      const auto n_new = static_cast<std::ptrdiff_t>(out_L.size() - n_before);
 
-          if (enable_vad) {
-            if (vad_prob_right >= vad_thres) {
-              vad_grace_right = release;
-            }
+      out_R.insert(out_R.end(), out_L.end() - n_new, out_L.end());
 
-            if (vad_grace_right >= 0) {
-              --vad_grace_right;
+      mono_input = true;
 
-              for (size_t i = 0U; i < data_R.size(); i++) {
-                data_R[i] = data_R[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
+      return;
+    }
 
-                data_R[i] *= inv_short_max;
-              }
-            } else {
-              std::ranges::for_each(data_R, [&](auto& v) { v = 0.0F; });
-            }
-          } else {
-            for (size_t i = 0U; i < data_R.size(); i++) {
-              data_R[i] = data_R[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
+    if (mono_input) {
+      // the right channel continues from where the left one is so both stay aligned
 
-              data_R[i] *= inv_short_max;
-            }
-          }
-        }
+      data_R = data_L;
 
-        for (const auto& v : data_R) {
-          out_R.push_back(v);
-        }
+      vad_grace_right = vad_grace_left;
 
-        data_R.resize(0U);
-      }
+      mono_input = false;
     }
+
+    remove_noise_channel(left_in, data_L, state_left, vad_prob_left, vad_grace_left, out_L);
+    remove_noise_channel(right_in, data_R, state_right, vad_prob_right, vad_grace_right, out_R);
   }
 
 #endif
@@ -0,0 +1,68 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*
+  Debug instrumentation enabled by the meson option enable-rt-checks. While a thread is inside a ScopedRealtime region
+  every call to malloc, free, pthread_mutex_lock and to our logging functions is recorded together with its backtrace.
+  Identical call sites are merged and the report is written when the program exits. The file name can be chosen
+  through the environment variable EE_RT_CHECKS_REPORT.
+
+  When the option is disabled everything here compiles to nothing. ee-bench is always built with it.
+*/
+
+#include <cstdint>
+
+namespace rt_checks {
+
+#ifdef ENABLE_RT_CHECKS
+
+class ScopedRealtime {
+ public:
+  ScopedRealtime();
+  ScopedRealtime(const ScopedRealtime&) = delete;
+  auto operator=(const ScopedRealtime&) -> ScopedRealtime& = delete;
+  ScopedRealtime(const ScopedRealtime&&) = delete;
+  auto operator=(const ScopedRealtime&&) -> ScopedRealtime& = delete;
+  ~ScopedRealtime();
+};
+
+void report_blocking_call(const char* what);
+
+void write_report();
+
+// Number of malloc, calloc, realloc, posix_memalign and aligned_alloc calls made inside ScopedRealtime regions
+auto get_allocation_count() -> uint64_t;
+
+#else
+
+class ScopedRealtime {};
+
+inline void report_blocking_call(const char* what) {}
+
+inline void write_report() {}
+
+inline auto get_allocation_count() -> uint64_t {
+  return 0U;
+}
+
+#endif
+
+}  // namespace rt_checks
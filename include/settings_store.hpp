@@ -0,0 +1,64 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <gio/gio.h>
+
+/*
+  Plugin settings shared by the filters, their user interfaces and the preset wrappers. There is a single GSettings
+  object per schema path and it is kept in delay mode, so the values live in memory and the changed signals are
+  emitted right away to everybody using that path. The modified keys are written to dconf in one batch after the
+  writes have stopped for flush_delay_ms, or after max_flush_delay_ms while a control is still being dragged. They
+  are also written when the application quits or receives SIGINT or SIGTERM, so a crash loses at most the last
+  max_flush_delay_ms of changes.
+
+  The filters still read their parameters in GSettings handlers on the main thread and copy them to the values used
+  by the realtime thread. Only the writes go through the shared objects.
+*/
+
+namespace settings_store {
+
+constexpr int flush_delay_ms = 250;
+
+constexpr int max_flush_delay_ms = 500;
+
+// Same arguments as g_settings_new_with_path. The caller owns the returned reference and has to unref it as usual.
+auto get(const char* schema_id, const char* path) -> GSettings*;
+
+// Writes all the pending changes to the backend
+void flush();
+
+// Every path obtained or written through the shared objects between these two calls is recorded. stop_recording()
+// returns the current value of all the keys of these paths in a new a(sssv) variant with the schema id, the path,
+// the key and the value.
+void start_recording();
+
+auto stop_recording() -> GVariant*;
+
+// Checks that values recorded by stop_recording() still match the installed schemas
+auto is_valid(GVariant* values) -> bool;
+
+// Writes values recorded by stop_recording()
+void apply(GVariant* values);
+
+// Flushes the pending changes and releases the shared objects. It is called when the application shuts down.
+void clear();
+
+}  // namespace settings_store
@@ -24,9 +24,11 @@
 #include <sys/types.h>
 #include <atomic>
 #include <deque>
+#include <memory>
 #include <span>
 #include <string>
 #include <vector>
+#include "delay_line.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -66,6 +68,14 @@ class Spectrum : public PluginBase {
   std::array<float, n_bands> real_input;
   std::array<double, n_bands / 2U + 1U> output;
 
+  static constexpr uint max_avsync_delay = 1000U;  // ms, the upper limit of the avsync-delay key
+
+  std::atomic<int> avsync_delay = 0;
+
+  uint avsync_line_rate = 0U;
+
+  std::unique_ptr<DelayLine> avsync_line;
+
   std::vector<float> left_delayed_vector;
   std::vector<float> right_delayed_vector;
   std::span<float> left_delayed;
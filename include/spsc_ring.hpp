@@ -0,0 +1,119 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/*
+  Wait free single producer single consumer ring buffer. It is used to move data between the realtime thread and a
+  worker thread. The memory is allocated in the constructor, so push() and pop() never allocate and never block.
+  Only one thread may push and only one thread may pop.
+*/
+
+template <typename T>
+class SpscRing {
+ public:
+  explicit SpscRing(const size_t& min_capacity)
+      : capacity(std::bit_ceil(std::max(min_capacity, static_cast<size_t>(2U)))), mask(capacity - 1U) {
+    buffer.resize(capacity);
+  }
+  SpscRing(const SpscRing&) = delete;
+  auto operator=(const SpscRing&) -> SpscRing& = delete;
+  SpscRing(const SpscRing&&) = delete;
+  auto operator=(const SpscRing&&) -> SpscRing& = delete;
+  ~SpscRing() = default;
+
+  // Writes as many elements as there is room for and returns how many were written
+
+  auto push(std::span<const T> input) -> size_t {
+    const auto w = write_index.load(std::memory_order_relaxed);
+    const auto r = read_index.load(std::memory_order_acquire);
+
+    const auto n = std::min(input.size(), capacity - (w - r));
+
+    const auto start = w & mask;
+    const auto first = std::min(n, capacity - start);
+
+    std::copy_n(input.begin(), first, buffer.begin() + static_cast<std::ptrdiff_t>(start));
+    std::copy_n(input.begin() + static_cast<std::ptrdiff_t>(first), n - first, buffer.begin());
+
+    write_index.store(w + n, std::memory_order_release);
+
+    return n;
+  }
+
+  auto push(const T& value) -> bool { return push(std::span<const T>(&value, 1U)) == 1U; }
+
+  // Reads up to output.size() elements and returns how many were read
+
+  auto pop(std::span<T> output) -> size_t {
+    const auto r = read_index.load(std::memory_order_relaxed);
+    const auto w = write_index.load(std::memory_order_acquire);
+
+    const auto n = std::min(output.size(), w - r);
+
+    const auto start = r & mask;
+    const auto first = std::min(n, capacity - start);
+
+    std::copy_n(buffer.begin() + static_cast<std::ptrdiff_t>(start), first, output.begin());
+    std::copy_n(buffer.begin(), n - first, output.begin() + static_cast<std::ptrdiff_t>(first));
+
+    read_index.store(r + n, std::memory_order_release);
+
+    return n;
+  }
+
+  auto pop(T& value) -> bool { return pop(std::span<T>(&value, 1U)) == 1U; }
+
+  // Drops up to n elements from the consumer side
+
+  auto discard(const size_t& n) -> size_t {
+    const auto r = read_index.load(std::memory_order_relaxed);
+    const auto w = write_index.load(std::memory_order_acquire);
+
+    const auto count = std::min(n, w - r);
+
+    read_index.store(r + count, std::memory_order_release);
+
+    return count;
+  }
+
+  [[nodiscard]] auto size() const -> size_t {
+    return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] auto get_capacity() const -> size_t { return capacity; }
+
+ private:
+  const size_t capacity;
+  const size_t mask;
+
+  std::vector<T> buffer;
+
+  // The indices are never wrapped. The difference between them is the number of stored elements.
+
+  alignas(64) std::atomic<size_t> write_index = 0U;
+  alignas(64) std::atomic<size_t> read_index = 0U;
+};
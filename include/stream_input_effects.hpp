@@ -43,7 +43,7 @@ class StreamInputEffects : public EffectsBase {
 
   void disconnect_filters();
 
-  auto apps_want_to_play() -> bool;
+  auto apps_want_to_play() -> bool override;
 
   void on_app_added(NodeInfo node_info);
 
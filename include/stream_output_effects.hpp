@@ -41,7 +41,7 @@ class StreamOutputEffects : public EffectsBase {
 
   void disconnect_filters();
 
-  auto apps_want_to_play() -> bool;
+  auto apps_want_to_play() -> bool override;
 
   void on_app_added(NodeInfo node_info);
 };
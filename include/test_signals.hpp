@@ -19,12 +19,19 @@
 
 #pragma once
 
+#include <fftw3.h>
+#include <glib.h>
 #include <pipewire/context.h>
 #include <pipewire/filter.h>
 #include <pipewire/proxy.h>
 #include <spa/utils/hook.h>
+#include <sigc++/signal.h>
 #include <sys/types.h>
+#include <atomic>
 #include <random>
+#include <span>
+#include <string>
+#include <thread>
 #include <vector>
 #include "pipe_manager.hpp"
 
@@ -46,6 +53,9 @@ class TestSignals {
   };
 
   struct data {
+    struct port* in_left = nullptr;
+    struct port* in_right = nullptr;
+
     struct port* out_left = nullptr;
     struct port* out_right = nullptr;
 
@@ -84,7 +94,35 @@ class TestSignals {
 
   auto white_noise() -> float;
 
+  /*
+    Impulse response measurement. An exponential sine sweep is played through the output pipeline while the output of
+    the input pipeline is recorded. The sweep is computed before the measurement starts, so the realtime thread only
+    copies buffers. The deconvolution is done in a worker thread and the result is saved as a convolver impulse
+    response.
+  */
+
+  auto start_measurement(const std::string& ir_name, const double& sweep_seconds) -> bool;
+
+  void cancel_measurement();
+
+  [[nodiscard]] auto measuring() const -> bool;
+
+  // Called by the realtime thread. Returns false when no measurement is running.
+  auto play_and_record(std::span<float> left_out,
+                       std::span<float> right_out,
+                       std::span<const float> left_in,
+                       std::span<const float> right_in) -> bool;
+
+  sigc::signal<void(const bool success, const std::string message)> measurement_finished;
+
  private:
+  enum class MeasurementState { idle, running, recorded, processing, done, failed };
+
+  static constexpr double sweep_start_frequency = 20.0;
+  static constexpr double sweep_end_frequency = 20000.0;
+  static constexpr double measurement_tail_seconds = 2.0;
+  static constexpr double ir_seconds = 1.0;
+
   PipeManager* pm = nullptr;
 
   spa_hook listener{};
@@ -100,4 +138,53 @@ class TestSignals {
   std::mt19937 random_generator;
 
   std::normal_distribution<float> normal_distribution{0.0F, 0.3F};
+
+  std::atomic<MeasurementState> measurement_state = MeasurementState::idle;
+
+  // Set by the realtime thread while it may use the sweep and the recordings. A cancelled measurement only releases
+  // them after it is cleared.
+  std::atomic<bool> measurement_busy = false;
+
+  uint measurement_rate = 0U;
+
+  size_t measurement_position = 0U;  // only used by the realtime thread while running
+
+  guint measurement_source_id = 0U;
+
+  double sweep_f2 = sweep_end_frequency;
+
+  bool measurement_ok = false;
+
+  std::string measurement_name;
+
+  std::string measurement_message;
+
+  std::vector<float> sweep, recording_left, recording_right;
+
+  std::vector<pw_proxy*> measurement_proxies;
+
+  std::thread measurement_thread;
+
+  // The fftw plans are created and destroyed in the main thread. The worker thread only executes them.
+  int fft_size = 0;
+  float* fft_real = nullptr;
+  fftwf_complex* fft_sweep = nullptr;
+  fftwf_complex* fft_complex = nullptr;
+  fftwf_plan plan_forward = nullptr;
+  fftwf_plan plan_backward = nullptr;
+
+  auto on_measurement_timeout() -> bool;
+
+  auto record_quantum(std::span<float> left_out,
+                      std::span<float> right_out,
+                      std::span<const float> left_in,
+                      std::span<const float> right_in) -> bool;
+
+  void wait_for_realtime_thread();
+
+  void unlink_measurement();
+
+  void deconvolve();
+
+  void free_fft();
 };
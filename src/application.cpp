@@ -35,11 +35,14 @@
 #include <thread>
 #include "application_ui.hpp"
 #include "config.h"
+#include "dsp_threads.hpp"
+#include "file_catalogue.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
 #include "preferences_window.hpp"
 #include "preset_type.hpp"
 #include "presets_manager.hpp"
+#include "settings_store.hpp"
 #include "stream_input_effects.hpp"
 #include "stream_output_effects.hpp"
 #include "tags_app.hpp"
@@ -77,6 +80,14 @@ void update_bypass_state(Application* self) {
   util::info(((state) != 0 ? "enabling" : "disabling") + " global bypass"s);
 }
 
+void update_dsp_threads_config(Application* self) {
+  dsp_threads::set_config(
+      {.threads = static_cast<uint>(g_settings_get_int(self->settings, "dsp-threads")),
+       .realtime = g_settings_get_boolean(self->settings, "dsp-threads-realtime") != 0,
+       .priority = g_settings_get_int(self->settings, "dsp-threads-priority"),
+       .cpus = dsp_threads::parse_cpu_list(util::gsettings_get_string(self->settings, "dsp-threads-cpus"))});
+}
+
 void on_startup(GApplication* gapp) {
   G_APPLICATION_CLASS(application_parent_class)->startup(gapp);
 
@@ -101,6 +112,8 @@ void on_startup(GApplication* gapp) {
 
   PipeManager::exclude_monitor_stream = g_settings_get_boolean(self->settings, "exclude-monitor-streams") != 0;
 
+  update_dsp_threads_config(self);
+
   self->data->connections.push_back(self->pm->new_default_sink_name.connect([=](const std::string name) {
     util::debug("new default output device: " + name);
 
@@ -224,6 +237,15 @@ void on_startup(GApplication* gapp) {
                        }),
                        self));
 
+  for (const auto* key : {"changed::dsp-threads", "changed::dsp-threads-realtime", "changed::dsp-threads-priority",
+                          "changed::dsp-threads-cpus"}) {
+    self->data->gconnections.push_back(g_signal_connect(
+        self->settings, key, G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+          update_dsp_threads_config(static_cast<Application*>(user_data));
+        }),
+        self));
+  }
+
   update_bypass_state(self);
 
   if ((g_application_get_flags(gapp) & G_APPLICATION_IS_SERVICE) != 0) {
@@ -458,6 +480,12 @@ void application_class_init(ApplicationClass* klass) {
     self->soe = nullptr;
     self->pm = nullptr;
 
+    // the plugins are gone and the settings changes that are still in memory can be written
+
+    settings_store::clear();
+
+    file_catalogue::clear();
+
     util::debug("Shutting down...");
   };
 }
@@ -18,17 +18,17 @@
  */
 
 #include "autogain.hpp"
-#include <ebur128.h>
 #include <gio/gio.h>
 #include <glib-object.h>
 #include <glib.h>
 #include <sys/types.h>
 #include <algorithm>
 #include <cmath>
-#include <cstddef>
+#include <memory>
 #include <mutex>
 #include <span>
 #include <string>
+#include "gated_loudness.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -41,7 +41,7 @@ AutoGain::AutoGain(const std::string& tag,
                    PipelineType pipe_type)
     : PluginBase(tag,
                  tags::plugin_name::autogain,
-                 tags::plugin_package::ebur128,
+                 tags::plugin_package::ee,
                  schema,
                  schema_path,
                  pipe_manager,
@@ -50,6 +50,8 @@ AutoGain::AutoGain(const std::string& tag,
       silence_threshold(g_settings_get_double(settings, "silence-threshold")) {
   reference = parse_reference_key(util::gsettings_get_string(settings, "reference"));
 
+  quantum_needs_setup = false;
+
   gconnections.push_back(g_signal_connect(settings, "changed::target",
                                           G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                             auto* self = static_cast<AutoGain*>(user_data);
@@ -76,27 +78,23 @@ AutoGain::AutoGain(const std::string& tag,
                                           }),
                                           this));
 
-  gconnections.push_back(g_signal_connect(
-      settings, "changed::reset-history", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
-        auto* self = static_cast<AutoGain*>(user_data);
-
-        self->mythreads.emplace_back([self]() {  // Using emplace_back here makes sense
-          self->data_mutex.lock();
-
-          self->ebur128_ready = false;
-
-          self->data_mutex.unlock();
+  gconnections.push_back(g_signal_connect(settings, "changed::statistics-interval",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<AutoGain*>(user_data);
 
-          auto status = self->init_ebur128();
+                                            std::scoped_lock<std::mutex> lock(self->data_mutex);
 
-          self->data_mutex.lock();
+                                            self->set_statistics_interval(g_settings_get_int(settings, key));
+                                          }),
+                                          this));
 
-          self->ebur128_ready = status;
+  gconnections.push_back(g_signal_connect(settings, "changed::reset-history",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<AutoGain*>(user_data);
 
-          self->data_mutex.unlock();
-        });
-      }),
-      this));
+                                            self->reset_meter();
+                                          }),
+                                          this));
 
   gconnections.push_back(g_signal_connect(
       settings, "changed::reference", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
@@ -107,6 +105,10 @@ AutoGain::AutoGain(const std::string& tag,
       this));
 
   setup_input_output_gain();
+
+  subscribe_input_metering(MeteringTap::Feature::loudness);
+
+  reset_meter();
 }
 
 AutoGain::~AutoGain() {
@@ -114,42 +116,22 @@ AutoGain::~AutoGain() {
     disconnect_from_pw();
   }
 
-  for (auto& t : mythreads) {
-    t.join();
-  }
-
-  mythreads.clear();
-
-  std::scoped_lock<std::mutex> lock(data_mutex);
-
-  if (ebur_state != nullptr) {
-    ebur128_destroy(&ebur_state);
-  }
-
   util::debug(log_tag + name + " destroyed");
 }
 
-auto AutoGain::init_ebur128() -> bool {
-  if (n_samples == 0U || rate == 0U) {
-    return false;
-  }
-
-  internal_output_gain = 1.0;
-
-  if (ebur_state != nullptr) {
-    ebur128_destroy(&ebur_state);
+void AutoGain::reset_meter() {
+  // The meter allocates its histories, so it is built here and only swapped while the lock is held
 
-    ebur_state = nullptr;
-  }
+  auto new_meter =
+      std::make_unique<GatedLoudness>(static_cast<uint>(std::max(g_settings_get_int(settings, "maximum-history"), 0)));
 
-  ebur_state = ebur128_init(2U, rate, EBUR128_MODE_S | EBUR128_MODE_I | EBUR128_MODE_LRA | EBUR128_MODE_SAMPLE_PEAK);
+  new_meter->set_update_interval(static_cast<uint>(std::max(g_settings_get_int(settings, "statistics-interval"), 0)));
 
-  ebur128_set_channel(ebur_state, 0U, EBUR128_LEFT);
-  ebur128_set_channel(ebur_state, 1U, EBUR128_RIGHT);
+  std::scoped_lock<std::mutex> lock(data_mutex);
 
-  set_maximum_history(g_settings_get_int(settings, "maximum-history"));
+  internal_output_gain = 1.0;
 
-  return ebur_state != nullptr;
+  meter.swap(new_meter);
 }
 
 auto AutoGain::parse_reference_key(const std::string& key) -> Reference {
@@ -181,45 +163,19 @@ auto AutoGain::parse_reference_key(const std::string& key) -> Reference {
 }
 
 void AutoGain::set_maximum_history(const int& seconds) {
-  if (ebur_state == nullptr) {
+  if (meter == nullptr) {
     return;
   }
 
-  // The value given to ebur128_set_max_history must be in milliseconds
-
-  ebur128_set_max_history(ebur_state, static_cast<ulong>(seconds) * 1000UL);
+  meter->set_max_history(static_cast<uint>(std::max(seconds, 0)));
 }
 
-void AutoGain::setup() {
-  if (2U * static_cast<size_t>(n_samples) != data.size()) {
-    data.resize(static_cast<size_t>(n_samples) * 2U);
+void AutoGain::set_statistics_interval(const int& milliseconds) {
+  if (meter == nullptr) {
+    return;
   }
 
-  if (rate != old_rate) {
-    data_mutex.lock();
-
-    ebur128_ready = false;
-
-    data_mutex.unlock();
-
-    mythreads.emplace_back([this]() {  // Using emplace_back here makes sense
-      if (ebur128_ready) {
-        return;
-      }
-
-      auto status = true;
-
-      old_rate = rate;
-
-      status = init_ebur128();
-
-      data_mutex.lock();
-
-      ebur128_ready = status;
-
-      data_mutex.unlock();
-    });
-  }
+  meter->set_update_interval(static_cast<uint>(std::max(milliseconds, 1)));
 }
 
 void AutoGain::process(std::span<float>& left_in,
@@ -228,7 +184,9 @@ void AutoGain::process(std::span<float>& left_in,
                        std::span<float>& right_out) {
   std::scoped_lock<std::mutex> lock(data_mutex);
 
-  if (bypass || !ebur128_ready) {
+  auto* tap = get_input_tap();
+
+  if (bypass || tap == nullptr) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -239,31 +197,27 @@ void AutoGain::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  for (size_t n = 0U; n < n_samples; n++) {
-    data[2U * n] = left_in[n];
-    data[2U * n + 1U] = right_in[n];
-  }
-
-  ebur128_add_frames_float(ebur_state, data.data(), n_samples);
+  // The tap measured the signal before the input gain. Scaling the block energies gives the same result as measuring
+  // the amplified signal.
 
-  auto failed = false;
+  if (tap != last_tap) {
+    last_tap = tap;
 
-  if (EBUR128_SUCCESS != ebur128_loudness_momentary(ebur_state, &momentary)) {
-    failed = true;
+    next_subblock = tap->get_subblock_count();
   }
 
-  if (EBUR128_SUCCESS != ebur128_loudness_shortterm(ebur_state, &shortterm)) {
-    failed = true;
-  }
+  const double energy_gain = static_cast<double>(input_gain) * static_cast<double>(input_gain);
 
-  if (EBUR128_SUCCESS != ebur128_loudness_global(ebur_state, &global)) {
-    failed = true;
-  }
+  tap->read_subblocks(next_subblock, [&](const double& energy) { meter->add_subblock(energy_gain * energy); });
+
+  momentary = meter->get_momentary();
+  shortterm = meter->get_shortterm();
+  global = meter->get_integrated();
 
   if (std::isinf(momentary) || std::isnan(momentary)) {
     /*
       Assuming zero so that the output gain is negative. This should avoid undesirably high amplification in case
-      a bad resutla comes from libebur128
+      a bad result comes from the meter
     */
 
     momentary = 0.0;
@@ -289,90 +243,75 @@ void AutoGain::process(std::span<float>& left_in,
     global = momentary;
   }
 
-  if (EBUR128_SUCCESS != ebur128_relative_threshold(ebur_state, &relative)) {
-    failed = true;
-  }
-
-  if (EBUR128_SUCCESS != ebur128_loudness_range(ebur_state, &range)) {
-    failed = true;
-  }
-
-  if (momentary > silence_threshold && !failed) {
-    double peak_L = 0.0;
-    double peak_R = 0.0;
+  relative = meter->get_relative_threshold();
+  range = meter->get_range();
 
-    if (EBUR128_SUCCESS != ebur128_prev_sample_peak(ebur_state, 0U, &peak_L)) {
-      failed = true;
-    }
+  if (momentary > silence_threshold) {
+    const double peak_L = static_cast<double>(tap->get_peak(0U) * input_gain);
+    const double peak_R = static_cast<double>(tap->get_peak(1U) * input_gain);
 
-    if (EBUR128_SUCCESS != ebur128_prev_sample_peak(ebur_state, 1U, &peak_R)) {
-      failed = true;
-    }
+    switch (reference) {
+      case Reference::momentary: {
+        loudness = momentary;
 
-    if (!failed) {
-      switch (reference) {
-        case Reference::momentary: {
-          loudness = momentary;
+        break;
+      }
+      case Reference::shortterm: {
+        loudness = shortterm;
 
-          break;
-        }
-        case Reference::shortterm: {
-          loudness = shortterm;
+        break;
+      }
+      case Reference::integrated: {
+        loudness = global;
 
-          break;
-        }
-        case Reference::integrated: {
-          loudness = global;
+        break;
+      }
+      case Reference::geometric_mean_msi: {
+        loudness = std::cbrt(momentary * shortterm * global);
 
-          break;
-        }
-        case Reference::geometric_mean_msi: {
-          loudness = std::cbrt(momentary * shortterm * global);
+        break;
+      }
+      case Reference::geometric_mean_ms: {
+        loudness = std::sqrt(std::fabs(momentary * shortterm));
 
-          break;
+        if (momentary < 0 && shortterm < 0) {
+          loudness *= -1;
         }
-        case Reference::geometric_mean_ms: {
-          loudness = std::sqrt(std::fabs(momentary * shortterm));
 
-          if (momentary < 0 && shortterm < 0) {
-            loudness *= -1;
-          }
+        break;
+      }
+      case Reference::geometric_mean_mi: {
+        loudness = std::sqrt(std::fabs(momentary * global));
 
-          break;
+        if (momentary < 0 && global < 0) {
+          loudness *= -1;
         }
-        case Reference::geometric_mean_mi: {
-          loudness = std::sqrt(std::fabs(momentary * global));
 
-          if (momentary < 0 && global < 0) {
-            loudness *= -1;
-          }
+        break;
+      }
+      case Reference::geometric_mean_si: {
+        loudness = std::sqrt(std::fabs(shortterm * global));
 
-          break;
+        if (shortterm < 0 && global < 0) {
+          loudness *= -1;
         }
-        case Reference::geometric_mean_si: {
-          loudness = std::sqrt(std::fabs(shortterm * global));
 
-          if (shortterm < 0 && global < 0) {
-            loudness *= -1;
-          }
-
-          break;
-        }
+        break;
       }
+    }
 
-      const double diff = target - loudness;
+    const double diff = target - loudness;
 
-      // 10^(diff/20). The way below should be faster than using pow
-      const double gain = std::exp((diff / 20.0) * std::log(10.0));
+    // 10^(diff/20). The way below should be faster than using pow
+    const double gain = std::exp((diff / 20.0) * std::log(10.0));
 
-      const double peak = (peak_L > peak_R) ? peak_L : peak_R;
+    const double peak = (peak_L > peak_R) ? peak_L : peak_R;
 
-      const auto db_peak = util::linear_to_db(peak);
+    const auto db_peak = util::linear_to_db(peak);
 
-      if (db_peak > util::minimum_db_level) {
-        if (gain * peak < 1.0) {
-          internal_output_gain = gain;
-        }
+    if (db_peak > util::minimum_db_level) {
+      if (gain * peak < 1.0) {
+        internal_output_gain = gain;
       }
     }
   }
@@ -392,13 +331,17 @@ void AutoGain::process(std::span<float>& left_in,
     get_peaks(left_in, right_in, left_out, right_out);
 
     if (send_notifications) {
-      results.emit(loudness, internal_output_gain, momentary, shortterm, global, relative, range);
+      post_meters({loudness, internal_output_gain, momentary, shortterm, global, relative, range});
 
       notify();
     }
   }
 }
 
+void AutoGain::emit_meters(const MeterValues& values) {
+  results.emit(values[0U], values[1U], values[2U], values[3U], values[4U], values[5U], values[6U]);
+}
+
 auto AutoGain::get_latency_seconds() -> float {
   return 0.0F;
 }
@@ -33,6 +33,8 @@
 #include <string>
 #include <vector>
 #include "autogain.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -63,7 +65,7 @@ struct _AutogainBox {
   GtkLabel *input_level_left_label, *input_level_right_label, *output_level_left_label, *output_level_right_label,
       *plugin_credit;
 
-  GtkSpinButton *target, *silence_threshold, *maximum_history;
+  GtkSpinButton *target, *silence_threshold, *maximum_history, *statistics_interval;
 
   GtkLevelBar *m_level, *s_level, *i_level, *r_level, *g_level, *l_level, *lra_level;
 
@@ -103,39 +105,15 @@ void setup(AutogainBox* self, std::shared_ptr<AutoGain> autogain, const std::str
 
   self->data->autogain = autogain;
 
-  self->settings = g_settings_new_with_path(tags::schema::autogain::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::autogain::id, schema_path.c_str());
 
   autogain->set_post_messages(true);
 
-  self->data->connections.push_back(autogain->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(autogain->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), autogain,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   self->data->connections.push_back(autogain->results.connect([=](const double loudness, const double gain,
                                                                   const double momentary, const double shortterm,
@@ -186,8 +164,8 @@ void setup(AutogainBox* self, std::shared_ptr<AutoGain> autogain, const std::str
 
   gsettings_bind_widgets<"input-gain", "output-gain">(self->settings, self->input_gain, self->output_gain);
 
-  gsettings_bind_widgets<"target", "silence-threshold", "maximum-history">(
-      self->settings, self->target, self->silence_threshold, self->maximum_history);
+  gsettings_bind_widgets<"target", "silence-threshold", "maximum-history", "statistics-interval">(
+      self->settings, self->target, self->silence_threshold, self->maximum_history, self->statistics_interval);
 
   ui::gsettings_bind_enum_to_combo_widget(self->settings, "reference", self->reference);
 }
@@ -195,6 +173,8 @@ void setup(AutogainBox* self, std::shared_ptr<AutoGain> autogain, const std::str
 void dispose(GObject* object) {
   auto* self = EE_AUTOGAIN_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -249,6 +229,7 @@ void autogain_box_class_init(AutogainBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, AutogainBox, target);
   gtk_widget_class_bind_template_child(widget_class, AutogainBox, silence_threshold);
   gtk_widget_class_bind_template_child(widget_class, AutogainBox, maximum_history);
+  gtk_widget_class_bind_template_child(widget_class, AutogainBox, statistics_interval);
   gtk_widget_class_bind_template_child(widget_class, AutogainBox, reference);
   gtk_widget_class_bind_template_child(widget_class, AutogainBox, reset_history);
 
@@ -282,6 +263,7 @@ void autogain_box_init(AutogainBox* self) {
 
   prepare_spinbuttons<"dB">(self->target, self->silence_threshold);
   prepare_spinbuttons<"s">(self->maximum_history);
+  prepare_spinbuttons<"ms">(self->statistics_interval);
 }
 
 auto create() -> AutogainBox* {
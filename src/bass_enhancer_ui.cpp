@@ -38,6 +38,8 @@
 #include <string>
 #include <vector>
 #include "bass_enhancer.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -101,39 +103,15 @@ void setup(BassEnhancerBox* self, std::shared_ptr<BassEnhancer> bass_enhancer, c
 
   self->data->bass_enhancer = bass_enhancer;
 
-  self->settings = g_settings_new_with_path(tags::schema::bass_enhancer::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::bass_enhancer::id, schema_path.c_str());
 
   bass_enhancer->set_post_messages(true);
 
-  self->data->connections.push_back(bass_enhancer->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(bass_enhancer->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), bass_enhancer,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   self->data->connections.push_back(bass_enhancer->harmonics.connect([=](const double value) {
     g_object_ref(self);
@@ -166,6 +144,8 @@ void setup(BassEnhancerBox* self, std::shared_ptr<BassEnhancer> bass_enhancer, c
 void dispose(GObject* object) {
   auto* self = EE_BASS_ENHANCER_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -44,6 +44,8 @@ BassLoudness::BassLoudness(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://drobilla.net/plugins/mda/Loudness is not installed");
   }
@@ -30,6 +30,8 @@
 #include <string>
 #include <vector>
 #include "bass_loudness.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -85,39 +87,15 @@ void setup(BassLoudnessBox* self, std::shared_ptr<BassLoudness> bass_loudness, c
 
   self->data->bass_loudness = bass_loudness;
 
-  self->settings = g_settings_new_with_path(tags::schema::bass_loudness::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::bass_loudness::id, schema_path.c_str());
 
   bass_loudness->set_post_messages(true);
 
-  self->data->connections.push_back(bass_loudness->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(bass_loudness->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), bass_loudness,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   gtk_label_set_text(self->plugin_credit, ui::get_plugin_credit_translated(self->data->bass_loudness->package).c_str());
 
@@ -129,6 +107,8 @@ void setup(BassLoudnessBox* self, std::shared_ptr<BassLoudness> bass_loudness, c
 void dispose(GObject* object) {
   auto* self = EE_BASS_LOUDNESS_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -50,6 +50,8 @@ Compressor::Compressor(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/sc_compressor_stereo is not installed");
   }
@@ -179,15 +181,7 @@ void Compressor::process(std::span<float>& left_in,
 
     latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
   }
@@ -208,10 +202,7 @@ void Compressor::process(std::span<float>& left_in,
       envelope_port_value =
           0.5F * (lv2_wrapper->get_control_port_value("elm_l") + lv2_wrapper->get_control_port_value("elm_r"));
 
-      reduction.emit(reduction_port_value);
-      sidechain.emit(sidechain_port_value);
-      curve.emit(curve_port_value);
-      envelope.emit(envelope_port_value);
+      post_meters({reduction_port_value, sidechain_port_value, curve_port_value, envelope_port_value});
 
       notify();
     }
@@ -219,6 +210,10 @@ void Compressor::process(std::span<float>& left_in,
 }
 
 void Compressor::update_sidechain_links(const std::string& key) {
+  if (pm == nullptr) {
+    return;
+  }
+
   if (util::gsettings_get_string(settings, "sidechain-type") != "External") {
     pm->destroy_links(list_proxies);
 
@@ -252,6 +247,22 @@ void Compressor::update_probe_links() {
   update_sidechain_links("");
 }
 
+void Compressor::reset_meters() {
+  reduction_port_value = 1.0F;
+  sidechain_port_value = 0.0F;
+  curve_port_value = 0.0F;
+  envelope_port_value = 0.0F;
+
+  post_meters({reduction_port_value, sidechain_port_value, curve_port_value, envelope_port_value});
+}
+
+void Compressor::emit_meters(const MeterValues& values) {
+  reduction.emit(static_cast<float>(values[0U]));
+  sidechain.emit(static_cast<float>(values[1U]));
+  curve.emit(static_cast<float>(values[2U]));
+  envelope.emit(static_cast<float>(values[3U]));
+}
+
 auto Compressor::get_latency_seconds() -> float {
   return this->latency_value;
 }
@@ -34,9 +34,11 @@
 #include <string>
 #include <vector>
 #include "compressor.hpp"
+#include "meters_aggregator.hpp"
 #include "node_info_holder.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "settings_store.hpp"
 #include "tags_pipewire.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -165,7 +167,7 @@ void setup(CompressorBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::compressor::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::compressor::id, schema_path.c_str());
 
   compressor->set_post_messages(true);
 
@@ -187,35 +189,11 @@ void setup(CompressorBox* self,
     }
   }
 
-  self->data->connections.push_back(compressor->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(compressor->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), compressor,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   self->data->connections.push_back(compressor->reduction.connect([=](const float value) {
     g_object_ref(self);
@@ -410,6 +388,8 @@ void dispose(GObject* object) {
 
   self->data->compressor->close_native_ui();
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -21,7 +21,6 @@
 #include <gio/gio.h>
 #include <glib-object.h>
 #include <glib.h>
-#include <sched.h>
 #include <sys/types.h>
 #include <zita-convolver.h>
 #include <algorithm>
@@ -33,6 +32,8 @@
 #include <span>
 #include <string>
 #include <vector>
+#include "dsp_threads.hpp"
+#include "file_catalogue.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "resampler.hpp"
@@ -40,14 +41,6 @@
 #include "tags_resources.hpp"
 #include "util.hpp"
 
-namespace {
-
-constexpr auto CONVPROC_SCHEDULER_PRIORITY = 0;
-
-constexpr auto CONVPROC_SCHEDULER_CLASS = SCHED_FIFO;
-
-}  // namespace
-
 Convolver::Convolver(const std::string& tag,
                      const std::string& schema,
                      const std::string& schema_path,
@@ -88,8 +81,7 @@ Convolver::Convolver(const std::string& tag,
                                             std::scoped_lock<std::mutex> lock(self->data_mutex);
 
                                             if (self->kernel_is_initialized) {
-                                              self->kernel_L = self->original_kernel_L;
-                                              self->kernel_R = self->original_kernel_R;
+                                              self->reset_kernels();
 
                                               self->set_kernel_stereo_width();
                                               self->apply_kernel_autogain();
@@ -181,13 +173,14 @@ void Convolver::setup() {
     read_kernel_file();
 
     if (kernel_is_initialized) {
-      kernel_L = original_kernel_L;
-      kernel_R = original_kernel_R;
+      reset_kernels();
 
       set_kernel_stereo_width();
       apply_kernel_autogain();
 
-      setup_zita();
+      if (!suspended) {
+        setup_zita();
+      }
     }
 
     std::scoped_lock<std::mutex> lock(data_mutex);
@@ -196,6 +189,44 @@ void Convolver::setup() {
   });
 }
 
+void Convolver::suspend() {
+  std::scoped_lock<std::mutex> lock(data_mutex);
+
+  suspended = true;
+
+  ready = false;
+
+  zita_ready = false;
+
+  if (conv != nullptr) {
+    conv->stop_process();
+
+    conv->cleanup();
+
+    delete conv;
+
+    conv = nullptr;
+  }
+
+  util::debug(log_tag + name + ": zita engine released");
+}
+
+void Convolver::resume() {
+  if (!suspended) {
+    return;
+  }
+
+  suspended = false;
+
+  // The kernels are still in memory. Only the engine has to be created again.
+
+  setup_zita();
+
+  std::scoped_lock<std::mutex> lock(data_mutex);
+
+  ready = kernel_is_initialized && zita_ready;
+}
+
 void Convolver::process(std::span<float>& left_in,
                         std::span<float>& right_in,
                         std::span<float>& left_out,
@@ -284,9 +315,7 @@ void Convolver::process(std::span<float>& left_in,
   if (notify_latency) {
     latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this] { latency.emit(); });
+    notify_latency_change();
 
     update_filter_params();
 
@@ -323,8 +352,10 @@ auto Convolver::search_irs_path(const std::string& name) -> std::string {
   } else {
     // Search irs file in community package paths.
     for (const auto& xdg_irs_dir : system_data_dir_irs) {
-      if (util::search_filename(std::filesystem::path{xdg_irs_dir + "/" + community_package}, irs_filename,
-                                irs_full_path, 3U)) {
+      irs_full_path =
+          file_catalogue::find(std::filesystem::path{xdg_irs_dir + "/" + community_package}, irs_filename, 3U);
+
+      if (!irs_full_path.empty()) {
         break;
       }
     }
@@ -371,46 +402,90 @@ void Convolver::read_kernel_file() {
   util::debug(log_tag + name + ": irs channels: " + util::to_string(file.channels()));
   util::debug(log_tag + name + ": irs frames: " + util::to_string(file.frames()));
 
-  // for now only stereo irs files are supported
+  /*
+    Stereo files have one channel per output. True stereo files have 4 channels in the order L -> L, L -> R, R -> L and
+    R -> R. Both are handled by the same zita engine. As zita computes the spectrum of each input only once and
+    reuses it for every output it feeds the cross paths cost much less than two extra convolvers.
+  */
 
-  if (file.channels() != 2) {
-    util::warning(log_tag + name + " Only stereo impulse responses are supported.");
+  if (file.channels() != 2 && file.channels() != 4) {
+    util::warning(log_tag + name + " Only stereo and true stereo impulse responses are supported.");
     util::warning(log_tag + name + " The impulse file was not loaded!");
 
     return;
   }
 
+  const auto n_channels = static_cast<size_t>(file.channels());
+
   std::vector<float> buffer(file.frames() * file.channels());
   std::vector<float> buffer_L(file.frames());
   std::vector<float> buffer_R(file.frames());
+  std::vector<float> buffer_LR;
+  std::vector<float> buffer_RL;
 
   file.readf(buffer.data(), file.frames());
 
-  for (size_t n = 0U; n < buffer_L.size(); n++) {
-    buffer_L[n] = buffer[2U * n];
-    buffer_R[n] = buffer[2U * n + 1U];
+  if (n_channels == 2U) {
+    for (size_t n = 0U; n < buffer_L.size(); n++) {
+      buffer_L[n] = buffer[2U * n];
+      buffer_R[n] = buffer[2U * n + 1U];
+    }
+  } else {
+    buffer_LR.resize(file.frames());
+    buffer_RL.resize(file.frames());
+
+    for (size_t n = 0U; n < buffer_L.size(); n++) {
+      buffer_L[n] = buffer[4U * n];
+      buffer_LR[n] = buffer[4U * n + 1U];
+      buffer_RL[n] = buffer[4U * n + 2U];
+      buffer_R[n] = buffer[4U * n + 3U];
+    }
   }
 
-  if (file.samplerate() != static_cast<int>(rate)) {
-    util::debug(log_tag + name + " resampling the kernel to " + util::to_string(rate));
+  true_stereo = n_channels == 4U;
+
+  auto resample_kernel = [&](const std::vector<float>& kernel) -> std::vector<float> {
+    if (kernel.empty() || file.samplerate() == static_cast<int>(rate)) {
+      return kernel;
+    }
 
     auto resampler = std::make_unique<Resampler>(file.samplerate(), rate);
 
-    original_kernel_L = resampler->process(buffer_L, true);
+    return resampler->process(kernel, true);
+  };
 
-    resampler = std::make_unique<Resampler>(file.samplerate(), rate);
+  if (file.samplerate() != static_cast<int>(rate)) {
+    util::debug(log_tag + name + " resampling the kernel to " + util::to_string(rate));
+  }
 
-    original_kernel_R = resampler->process(buffer_R, true);
-  } else {
-    original_kernel_L = buffer_L;
-    original_kernel_R = buffer_R;
+  original_kernel_L = resample_kernel(buffer_L);
+  original_kernel_R = resample_kernel(buffer_R);
+  original_kernel_LR = resample_kernel(buffer_LR);
+  original_kernel_RL = resample_kernel(buffer_RL);
+
+  if (true_stereo) {
+    // the resampler output length may differ by a frame between channels
+
+    original_kernel_R.resize(original_kernel_L.size());
+    original_kernel_LR.resize(original_kernel_L.size());
+    original_kernel_RL.resize(original_kernel_L.size());
   }
 
+  tail_value = static_cast<float>(file.frames()) / static_cast<float>(file.samplerate());
+
   kernel_is_initialized = true;
 
   util::debug(log_tag + name + ": kernel correctly initialized");
 }
 
+void Convolver::reset_kernels() {
+  kernel_L = original_kernel_L;
+  kernel_R = original_kernel_R;
+
+  kernel_LR = original_kernel_LR;
+  kernel_RL = original_kernel_RL;
+}
+
 void Convolver::apply_kernel_autogain() {
   if (!do_autogain) {
     return;
@@ -420,19 +495,28 @@ void Convolver::apply_kernel_autogain() {
     return;
   }
 
-  const float abs_peak_L =
-      std::ranges::max(kernel_L, [](const auto& a, const auto& b) { return (std::fabs(a) < std::fabs(b)); });
-  const float abs_peak_R =
-      std::ranges::max(kernel_R, [](const auto& a, const auto& b) { return (std::fabs(a) < std::fabs(b)); });
+  auto abs_peak = [](const std::vector<float>& kernel) {
+    if (kernel.empty()) {
+      return 0.0F;
+    }
+
+    return std::fabs(
+        std::ranges::max(kernel, [](const auto& a, const auto& b) { return (std::fabs(a) < std::fabs(b)); }));
+  };
 
-  const float peak = (abs_peak_L > abs_peak_R) ? abs_peak_L : abs_peak_R;
+  const float peak = std::max({abs_peak(kernel_L), abs_peak(kernel_R), abs_peak(kernel_LR), abs_peak(kernel_RL)});
+
+  if (peak == 0.0F) {
+    return;
+  }
 
   // normalize
 
-  std::ranges::for_each(kernel_L, [&](auto& v) { v /= peak; });
-  std::ranges::for_each(kernel_R, [&](auto& v) { v /= peak; });
+  for (auto* kernel : {&kernel_L, &kernel_R, &kernel_LR, &kernel_RL}) {
+    std::ranges::for_each(*kernel, [&](auto& v) { v /= peak; });
+  }
 
-  // find average power
+  // find average power. In true stereo mode each output is fed by a direct and a cross path.
 
   float power_L = 0.0F;
   float power_R = 0.0F;
@@ -440,14 +524,18 @@ void Convolver::apply_kernel_autogain() {
   std::ranges::for_each(kernel_L, [&](const auto& v) { power_L += v * v; });
   std::ranges::for_each(kernel_R, [&](const auto& v) { power_R += v * v; });
 
+  std::ranges::for_each(kernel_RL, [&](const auto& v) { power_L += v * v; });
+  std::ranges::for_each(kernel_LR, [&](const auto& v) { power_R += v * v; });
+
   const float power = std::max(power_L, power_R);
 
   const float autogain = std::min(1.0F, 1.0F / std::sqrt(power));
 
   util::debug(log_tag + "autogain factor: " + util::to_string(autogain));
 
-  std::ranges::for_each(kernel_L, [&](auto& v) { v *= autogain; });
-  std::ranges::for_each(kernel_R, [&](auto& v) { v *= autogain; });
+  for (auto* kernel : {&kernel_L, &kernel_R, &kernel_LR, &kernel_RL}) {
+    std::ranges::for_each(*kernel, [&](auto& v) { v *= autogain; });
+  }
 }
 
 /*
@@ -458,12 +546,33 @@ void Convolver::set_kernel_stereo_width() {
   const float w = static_cast<float>(ir_width) * 0.01F;
   const float x = (1.0F - w) / (1.0F + w);  // M-S coeff.; L_out = L + x*R; R_out = R + x*L
 
-  for (uint i = 0U; i < original_kernel_L.size(); i++) {
-    const auto L = original_kernel_L[i];
-    const auto R = original_kernel_R[i];
+  if (!true_stereo) {
+    for (uint i = 0U; i < original_kernel_L.size(); i++) {
+      const auto L = original_kernel_L[i];
+      const auto R = original_kernel_R[i];
 
-    kernel_L[i] = L + x * R;
-    kernel_R[i] = R + x * L;
+      kernel_L[i] = L + x * R;
+      kernel_R[i] = R + x * L;
+    }
+
+    return;
+  }
+
+  /*
+    In true stereo mode the width is applied to the outputs. As L_out = L_in * LL + R_in * RL and
+    R_out = L_in * LR + R_in * RR mixing the outputs is the same as mixing the kernels feeding them.
+  */
+
+  for (uint i = 0U; i < original_kernel_L.size(); i++) {
+    const auto LL = original_kernel_L[i];
+    const auto LR = original_kernel_LR[i];
+    const auto RL = original_kernel_RL[i];
+    const auto RR = original_kernel_R[i];
+
+    kernel_L[i] = LL + x * LR;
+    kernel_LR[i] = LR + x * LL;
+    kernel_RL[i] = RL + x * RR;
+    kernel_R[i] = RR + x * RL;
   }
 }
 
@@ -489,7 +598,8 @@ void Convolver::setup_zita() {
 
   conv->set_options(0);
 
-  int ret = conv->configure(2, 2, max_convolution_size, buffer_size, buffer_size, buffer_size, 0.0F /*density*/);
+  int ret = conv->configure(2, 2, max_convolution_size, buffer_size, buffer_size,
+                           dsp_threads::get_max_partition(buffer_size), 0.0F /*density*/);
 
   if (ret != 0) {
     util::warning(log_tag + name + " can't initialise zita-convolver engine: " + util::to_string(ret, ""));
@@ -513,7 +623,25 @@ void Convolver::setup_zita() {
     return;
   }
 
-  ret = conv->start_process(CONVPROC_SCHEDULER_PRIORITY, CONVPROC_SCHEDULER_CLASS);
+  if (true_stereo) {
+    ret = conv->impdata_create(0, 1, 1, kernel_LR.data(), 0, static_cast<int>(kernel_LR.size()));
+
+    if (ret != 0) {
+      util::warning(log_tag + name + " left to right impdata_create failed: " + util::to_string(ret, ""));
+
+      return;
+    }
+
+    ret = conv->impdata_create(1, 0, 1, kernel_RL.data(), 0, static_cast<int>(kernel_RL.size()));
+
+    if (ret != 0) {
+      util::warning(log_tag + name + " right to left impdata_create failed: " + util::to_string(ret, ""));
+
+      return;
+    }
+  }
+
+  ret = dsp_threads::start(conv);
 
   if (ret != 0) {
     util::warning(log_tag + name + " start_process failed: " + util::to_string(ret, ""));
@@ -555,13 +683,14 @@ void Convolver::prepare_kernel() {
   read_kernel_file();
 
   if (kernel_is_initialized) {
-    kernel_L = original_kernel_L;
-    kernel_R = original_kernel_R;
+    reset_kernels();
 
     set_kernel_stereo_width();
     apply_kernel_autogain();
 
-    setup_zita();
+    if (!suspended) {
+      setup_zita();
+    }
 
     data_mutex.lock();
 
@@ -25,6 +25,7 @@
 #include <gtk/gtkdropdown.h>
 #include <sndfile.h>
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <execution>
 #include <filesystem>
@@ -125,8 +126,8 @@ void combine_kernels(ConvolverMenuCombine* self,
     return;
   }
 
-  auto [rate1, kernel_1_L, kernel_1_R] = ui::convolver::read_kernel(irs_dir, irs_ext, kernel_1_name);
-  auto [rate2, kernel_2_L, kernel_2_R] = ui::convolver::read_kernel(irs_dir, irs_ext, kernel_2_name);
+  auto [rate1, kernel_1] = ui::convolver::read_kernel_paths(irs_dir, irs_ext, kernel_1_name);
+  auto [rate2, kernel_2] = ui::convolver::read_kernel_paths(irs_dir, irs_ext, kernel_2_name);
 
   if (rate1 == 0 || rate2 == 0) {
     g_object_ref(self);
@@ -136,58 +137,95 @@ void combine_kernels(ConvolverMenuCombine* self,
     return;
   }
 
+  auto resample = [](std::array<std::vector<float>, 4>& paths, const int& rate_in, const int& rate_out) {
+    for (auto& path : paths) {
+      if (!path.empty()) {
+        path = std::make_unique<Resampler>(rate_in, rate_out)->process(path, true);
+      }
+    }
+  };
+
   if (rate1 > rate2) {
     util::debug("resampling the kernel " + kernel_2_name + " to " + util::to_string(rate1) + " Hz");
 
-    auto resampler = std::make_unique<Resampler>(rate2, rate1);
+    resample(kernel_2, rate2, rate1);
+  } else if (rate2 > rate1) {
+    util::debug("resampling the kernel " + kernel_1_name + " to " + util::to_string(rate2) + " Hz");
+
+    resample(kernel_1, rate1, rate2);
+  }
 
-    kernel_2_L = resampler->process(kernel_2_L, true);
+  /*
+    The paths are indexed as 2 * input + output. Applying kernel 1 and then kernel 2 gives the path i -> j as the sum
+    over k of (i -> k of kernel 1) convolved with (k -> j of kernel 2). For two stereo files the cross paths are empty
+    and this is the usual channel by channel convolution.
+  */
 
-    resampler = std::make_unique<Resampler>(rate2, rate1);
+  const auto length = kernel_1[0].size() + kernel_2[0].size() - 1U;
 
-    kernel_2_R = resampler->process(kernel_2_R, true);
-  } else if (rate2 > rate1) {
-    util::debug("resampling the kernel " + kernel_1_name + " to " + util::to_string(rate2) + " Hz");
+  std::array<std::vector<float>, 4> kernel;
 
-    auto resampler = std::make_unique<Resampler>(rate1, rate2);
+  for (size_t i = 0U; i < 2U; i++) {
+    for (size_t j = 0U; j < 2U; j++) {
+      for (size_t k = 0U; k < 2U; k++) {
+        const auto& a = kernel_1[2U * i + k];
+        const auto& b = kernel_2[2U * k + j];
 
-    kernel_1_L = resampler->process(kernel_1_L, true);
+        if (a.empty() || b.empty()) {
+          continue;
+        }
 
-    resampler = std::make_unique<Resampler>(rate1, rate2);
+        std::vector<float> c(a.size() + b.size() - 1U);
 
-    kernel_1_R = resampler->process(kernel_1_R, true);
+        // As the convolution is commutative we change the order based on which will run faster.
+
+        if (a.size() > b.size()) {
+          direct_conv(a, b, c);
+        } else {
+          direct_conv(b, a, c);
+        }
+
+        auto& path = kernel[2U * i + j];
+
+        path.resize(length, 0.0F);
+
+        for (size_t n = 0U; n < c.size() && n < length; n++) {
+          path[n] += c[n];
+        }
+      }
+    }
   }
 
-  std::vector<float> kernel_L(kernel_1_L.size() + kernel_2_L.size() - 1U);
-  std::vector<float> kernel_R(kernel_1_R.size() + kernel_2_R.size() - 1U);
+  const auto true_stereo = !kernel[1].empty() || !kernel[2].empty();
 
-  // As the convolution is commutative we change the order based on which will run faster.
+  const size_t n_channels = true_stereo ? 4U : 2U;
 
-  if (kernel_1_L.size() > kernel_2_L.size()) {
-    direct_conv(kernel_1_L, kernel_2_L, kernel_L);
-    direct_conv(kernel_1_R, kernel_2_R, kernel_R);
-  } else {
-    direct_conv(kernel_2_L, kernel_1_L, kernel_L);
-    direct_conv(kernel_2_R, kernel_1_R, kernel_R);
+  for (auto& path : kernel) {
+    path.resize(length, 0.0F);
   }
 
-  std::vector<float> buffer(kernel_L.size() * 2U);  // 2 channels interleaved
+  std::vector<float> buffer(length * n_channels);  // channels interleaved
 
-  for (size_t n = 0U; n < kernel_L.size(); n++) {
-    buffer[2U * n] = kernel_L[n];
-    buffer[2U * n + 1U] = kernel_R[n];
+  for (size_t n = 0U; n < length; n++) {
+    if (true_stereo) {
+      for (size_t c = 0U; c < n_channels; c++) {
+        buffer[n_channels * n + c] = kernel[c][n];
+      }
+    } else {
+      buffer[2U * n] = kernel[0][n];
+      buffer[2U * n + 1U] = kernel[3][n];
+    }
   }
 
   const auto output_file_path = irs_dir / std::filesystem::path{output_file_name + irs_ext};
 
   auto mode = SFM_WRITE;
   auto format = SF_FORMAT_WAV | SF_FORMAT_PCM_32;
-  auto n_channels = 2;
   auto rate = (rate1 > rate2) ? rate1 : rate2;
 
-  auto sndfile = SndfileHandle(output_file_path.string(), mode, format, n_channels, rate);
+  auto sndfile = SndfileHandle(output_file_path.string(), mode, format, static_cast<int>(n_channels), rate);
 
-  sndfile.writef(buffer.data(), static_cast<sf_count_t>(kernel_L.size()));
+  sndfile.writef(buffer.data(), static_cast<sf_count_t>(length));
 
   util::debug("combined kernel saved: " + output_file_path.string());
 
@@ -34,6 +34,7 @@
 #include <string>
 #include "application.hpp"
 #include "config.h"
+#include "settings_store.hpp"
 #include "tags_app.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -99,8 +100,8 @@ auto import_irs_file(const std::string& file_path) -> ImpulseImportState {
     return ImpulseImportState::no_frame;
   }
 
-  if (file.channels() != 2) {
-    util::warning("Only stereo impulse files are supported!");
+  if (file.channels() != 2 && file.channels() != 4) {
+    util::warning("Only stereo and true stereo impulse files are supported!");
     util::warning(file_path + " loading failed");
 
     return ImpulseImportState::no_stereo;
@@ -132,7 +133,7 @@ void notify_import_error(const ImpulseImportState& import_state, ConvolverMenuIm
       break;
     }
     case ImpulseImportState::no_stereo: {
-      descr = _("Only Stereo Impulse Files Are Supported");
+      descr = _("Only Stereo and True Stereo Impulse Files Are Supported");
 
       break;
     }
@@ -338,7 +339,7 @@ void setup(ConvolverMenuImpulses* self,
 
   self->convolver = convolver;
 
-  self->settings = g_settings_new_with_path(tags::schema::convolver::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::convolver::id, schema_path.c_str());
 
   setup_listview(self);
 }
@@ -48,6 +48,8 @@
 #include "convolver_menu_combine.hpp"
 #include "convolver_menu_impulses.hpp"
 #include "convolver_ui_common.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -512,33 +514,17 @@ void setup(ConvolverBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::convolver::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::convolver::id, schema_path.c_str());
 
   convolver->set_post_messages(true);
 
   ui::convolver_menu_impulses::setup(self->impulses_menu, schema_path, application, convolver);
 
-  self->data->connections.push_back(convolver->input_level.connect([=](const float left, const float right) {
-    util::idle_add([=]() {
-      if (get_ignore_filter_idle_add(serial)) {
-        return;
-      }
-
-      update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                   self->input_level_right_label, left, right);
-    });
-  }));
-
-  self->data->connections.push_back(convolver->output_level.connect([=](const float left, const float right) {
-    util::idle_add([=]() {
-      if (get_ignore_filter_idle_add(serial)) {
-        return;
-      }
-
-      update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                   self->output_level_right_label, left, right);
-    });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), convolver,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   self->data->gconnections.push_back(g_signal_connect(
       self->settings, "changed::kernel-name", G_CALLBACK(+[](GSettings* settings, char* key, ConvolverBox* self) {
@@ -562,6 +548,8 @@ void setup(ConvolverBox* self,
 void dispose(GObject* object) {
   auto* self = EE_CONVOLVER_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   g_file_monitor_cancel(self->folder_monitor);
@@ -18,11 +18,13 @@
  */
 
 #include "convolver_ui_common.hpp"
+#include <array>
 #include <cstddef>
 #include <filesystem>
 #include <sndfile.hh>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 #include "util.hpp"
 
@@ -30,10 +32,18 @@ namespace ui::convolver {
 
 auto read_kernel(std::filesystem::path irs_dir, const std::string& irs_ext, const std::string& file_name)
     -> std::tuple<int, std::vector<float>, std::vector<float>> {
+  // For true stereo files only the direct paths are returned
+
+  auto [rate, paths] = read_kernel_paths(std::move(irs_dir), irs_ext, file_name);
+
+  return std::make_tuple(rate, std::move(paths[0]), std::move(paths[3]));
+}
+
+auto read_kernel_paths(std::filesystem::path irs_dir, const std::string& irs_ext, const std::string& file_name)
+    -> std::tuple<int, std::array<std::vector<float>, 4>> {
   int rate = 0;
   std::vector<float> buffer;
-  std::vector<float> kernel_L;
-  std::vector<float> kernel_R;
+  std::array<std::vector<float>, 4> paths;
 
   auto file_path = irs_dir / std::filesystem::path{file_name};
 
@@ -46,32 +56,46 @@ auto read_kernel(std::filesystem::path irs_dir, const std::string& irs_ext, cons
   if (!std::filesystem::exists(file_path)) {
     util::debug("file: " + file_path.string() + " does not exist");
 
-    return std::make_tuple(rate, kernel_L, kernel_R);
+    return std::make_tuple(rate, paths);
   }
 
   auto sndfile = SndfileHandle(file_path.string());
 
-  if (sndfile.channels() != 2 || sndfile.frames() == 0) {
-    util::warning(" Only stereo impulse responses are supported.");
+  if ((sndfile.channels() != 2 && sndfile.channels() != 4) || sndfile.frames() == 0) {
+    util::warning(" Only stereo and true stereo impulse responses are supported.");
     util::warning(" The impulse file was not loaded!");
 
-    return std::make_tuple(rate, kernel_L, kernel_R);
+    return std::make_tuple(rate, paths);
   }
 
-  buffer.resize(sndfile.frames() * sndfile.channels());
-  kernel_L.resize(sndfile.frames());
-  kernel_R.resize(sndfile.frames());
+  const auto n_channels = static_cast<size_t>(sndfile.channels());
+  const auto n_frames = static_cast<size_t>(sndfile.frames());
+
+  buffer.resize(n_frames * n_channels);
 
   sndfile.readf(buffer.data(), sndfile.frames());
 
-  for (size_t n = 0U; n < kernel_L.size(); n++) {
-    kernel_L[n] = buffer[2U * n];
-    kernel_R[n] = buffer[2U * n + 1U];
+  // A stereo file has the channels L -> L and R -> R. A true stereo file has all the four paths.
+
+  const auto true_stereo = n_channels == 4U;
+
+  for (size_t p = 0U; p < paths.size(); p++) {
+    if (!true_stereo && (p == 1U || p == 2U)) {
+      continue;
+    }
+
+    const auto channel = true_stereo ? p : ((p == 0U) ? 0U : 1U);
+
+    paths[p].resize(n_frames);
+
+    for (size_t n = 0U; n < n_frames; n++) {
+      paths[p][n] = buffer[n_channels * n + channel];
+    }
   }
 
   rate = sndfile.samplerate();
 
-  return std::make_tuple(rate, kernel_L, kernel_R);
+  return std::make_tuple(rate, paths);
 }
 
 }  // namespace ui::convolver
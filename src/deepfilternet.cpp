@@ -18,16 +18,24 @@
  */
 
 #include "deepfilternet.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <sys/types.h>
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <span>
 #include <string>
+#include <thread>
 #include <vector>
+#include "dsp_threads.hpp"
 #include "ladspa_wrapper.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
-#include "resampler.hpp"
+#include "polyphase_resampler.hpp"
+#include "spsc_ring.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
 
@@ -51,24 +59,66 @@ DeepFilterNet::DeepFilterNet(const std::string& tag,
     util::debug(log_tag + "libdeep_filter_ladspa is not installed");
   }
 
-  ladspa_wrapper->bind_key_double_db_exponential<"Attenuation Limit (dB)", "attenuation-limit", false>(settings);
+  // the mono instance is used when the microphone is mono, so the model runs only once per frame
 
-  ladspa_wrapper->bind_key_double_db_exponential<"Min processing threshold (dB)", "min-processing-threshold", false>(
-      settings);
+  ladspa_wrapper_mono = std::make_unique<ladspa::LadspaWrapper>("libdeep_filter_ladspa.so", "deep_filter_mono");
 
-  ladspa_wrapper
-      ->bind_key_double_db_exponential<"Max ERB processing threshold (dB)", "max-erb-processing-threshold", false>(
-          settings);
+  for (auto* wrapper : {ladspa_wrapper.get(), ladspa_wrapper_mono.get()}) {
+    wrapper->bind_key_double_db_exponential<"Attenuation Limit (dB)", "attenuation-limit", false>(settings);
 
-  ladspa_wrapper
-      ->bind_key_double_db_exponential<"Max DF processing threshold (dB)", "max-df-processing-threshold", false>(
-          settings);
+    wrapper->bind_key_double_db_exponential<"Min processing threshold (dB)", "min-processing-threshold", false>(
+        settings);
 
-  ladspa_wrapper->bind_key_int<"Min Processing Buffer (frames)", "min-processing-buffer">(settings);
+    wrapper->bind_key_double_db_exponential<"Max ERB processing threshold (dB)", "max-erb-processing-threshold",
+                                            false>(settings);
 
-  ladspa_wrapper->bind_key_double<"Post Filter Beta", "post-filter-beta">(settings);
+    wrapper->bind_key_double_db_exponential<"Max DF processing threshold (dB)", "max-df-processing-threshold", false>(
+        settings);
+
+    wrapper->bind_key_int<"Min Processing Buffer (frames)", "min-processing-buffer">(settings);
+
+    wrapper->bind_key_double<"Post Filter Beta", "post-filter-beta">(settings);
+  }
 
   setup_input_output_gain();
+
+  setup_channel_mode();
+
+  async_processing = g_settings_get_boolean(settings, "async-processing") != 0;
+  async_buffer_ms = g_settings_get_double(settings, "async-buffer");
+
+  auto on_async_changed = +[](GSettings* settings, char* key, gpointer user_data) {
+    auto* self = static_cast<DeepFilterNet*>(user_data);
+
+    {
+      std::scoped_lock<std::mutex, std::mutex> lock(self->data_mutex, self->worker_mutex);
+
+      self->async_processing = g_settings_get_boolean(settings, "async-processing") != 0;
+      self->async_buffer_ms = g_settings_get_double(settings, "async-buffer");
+
+      // both modes share the resamplers but use them in different ways
+
+      for (auto* r : {self->resampler_inL.get(), self->resampler_inR.get(), self->resampler_outL.get(),
+                      self->resampler_outR.get()}) {
+        if (r != nullptr) {
+          r->reset();
+        }
+      }
+
+      self->init_async();
+    }
+
+    // joined outside of the locks because the worker takes worker_mutex
+
+    if (!self->async_processing) {
+      self->stop_worker();
+    }
+
+    self->update_latency();
+  };
+
+  gconnections.push_back(g_signal_connect(settings, "changed::async-processing", G_CALLBACK(on_async_changed), this));
+  gconnections.push_back(g_signal_connect(settings, "changed::async-buffer", G_CALLBACK(on_async_changed), this));
 }
 
 DeepFilterNet::~DeepFilterNet() {
@@ -76,6 +126,8 @@ DeepFilterNet::~DeepFilterNet() {
     disconnect_from_pw();
   }
 
+  stop_worker();
+
   util::debug(log_tag + name + " destroyed");
 }
 
@@ -89,51 +141,275 @@ void DeepFilterNet::setup() {
   resample = rate != 48000;
   resampler_ready = !resample;
 
+  async_ready = false;
+
   util::idle_add([&, this] {
-    ladspa_wrapper->n_samples = n_samples;
-    std::scoped_lock<std::mutex> lock(data_mutex);
+    {
+      std::scoped_lock<std::mutex, std::mutex> lock(data_mutex, worker_mutex);
 
-    if (ladspa_wrapper->get_rate() != 48000) {
-      ladspa_wrapper->create_instance(48000);
-      ladspa_wrapper->activate();
-    }
+      ladspa_wrapper->n_samples = n_samples;
+
+      if (ladspa_wrapper->get_rate() != 48000 && !suspended) {
+        ladspa_wrapper->create_instance(48000);
+        ladspa_wrapper->activate();
+      }
+
+      if (ladspa_wrapper_mono->found_plugin()) {
+        ladspa_wrapper_mono->n_samples = n_samples;
+
+        if (ladspa_wrapper_mono->get_rate() != 48000 && !suspended) {
+          ladspa_wrapper_mono->create_instance(48000);
+          ladspa_wrapper_mono->activate();
+        }
+      }
 
-    if (resample && !resampler_ready) {
-      resampler_inL = std::make_unique<Resampler>(rate, 48000);
-      resampler_inR = std::make_unique<Resampler>(rate, 48000);
-      resampler_outL = std::make_unique<Resampler>(48000, rate);
-      resampler_outR = std::make_unique<Resampler>(48000, rate);
+      if (resample && !resampler_ready) {
+        const auto quality =
+            PolyphaseResampler::quality_from_int(g_settings_get_enum(global_settings, "resampler-quality"));
 
-      std::vector<float> dummy(n_samples);
+        const auto max_frames = std::max(n_samples, PolyphaseResampler::default_max_input_frames);
 
-      const auto resampled_inL = resampler_inL->process(dummy, false);
-      const auto resampled_inR = resampler_inR->process(dummy, false);
+        resampler_inL = std::make_unique<PolyphaseResampler>(rate, 48000, max_frames, quality);
+        resampler_inR = std::make_unique<PolyphaseResampler>(rate, 48000, max_frames, quality);
 
-      resampled_outL.resize(resampled_inL.size());
-      resampled_outR.resize(resampled_inR.size());
+        const auto max_resampled_frames = static_cast<uint>(resampler_inL->get_max_output_frames(max_frames));
 
-      resampler_outL->process(resampled_inL, false);
-      resampler_outR->process(resampled_inR, false);
+        resampler_outL = std::make_unique<PolyphaseResampler>(48000, rate, max_resampled_frames, quality);
+        resampler_outR = std::make_unique<PolyphaseResampler>(48000, rate, max_resampled_frames, quality);
 
-      carryover_l.clear();
-      carryover_r.clear();
-      carryover_l.reserve(4);  // chosen by fair dice roll.
-      carryover_r.reserve(4);  // guaranteed to be random.
-      carryover_l.push_back(0.0F);
-      carryover_r.push_back(0.0F);
+        resampled_inL.resize(max_resampled_frames);
+        resampled_inR.resize(max_resampled_frames);
+        resampled_outL.resize(max_resampled_frames);
+        resampled_outR.resize(max_resampled_frames);
 
-      resampler_ready = true;
+        resampler_latency = static_cast<float>(resampler_inL->get_latency_frames()) / 48000.0F +
+                            static_cast<float>(resampler_outL->get_fixed_latency_frames()) / static_cast<float>(rate);
+
+        resampler_latency_async =
+            static_cast<float>(resampler_inL->get_latency_frames()) / 48000.0F +
+            static_cast<float>(resampler_outL->get_latency_frames()) / static_cast<float>(rate);
+
+        resampler_ready = true;
+      }
+
+      init_async();
     }
+
+    update_latency();
   });
 }
 
+void DeepFilterNet::suspend() {
+  std::scoped_lock<std::mutex, std::mutex> lock(data_mutex, worker_mutex);
+
+  if (suspended || !ladspa_wrapper->found_plugin()) {
+    return;
+  }
+
+  suspended = true;
+
+  // process() passes the audio through while there is no instance
+
+  ladspa_wrapper->destroy_instance();
+
+  if (ladspa_wrapper_mono->found_plugin()) {
+    ladspa_wrapper_mono->destroy_instance();
+  }
+
+  util::debug(log_tag + name + " model instances released");
+}
+
+void DeepFilterNet::resume() {
+  std::scoped_lock<std::mutex, std::mutex> lock(data_mutex, worker_mutex);
+
+  if (!suspended) {
+    return;
+  }
+
+  suspended = false;
+
+  // nothing to restore if setup() has not run yet
+
+  if (n_samples == 0U) {
+    return;
+  }
+
+  ladspa_wrapper->create_instance(48000);
+  ladspa_wrapper->activate();
+
+  if (ladspa_wrapper_mono->found_plugin()) {
+    ladspa_wrapper_mono->create_instance(48000);
+    ladspa_wrapper_mono->activate();
+  }
+}
+
+void DeepFilterNet::init_async() {
+  // data_mutex and worker_mutex have to be locked by the caller
+
+  async_ready = false;
+
+  if (!async_processing || rate == 0U || n_samples == 0U) {
+    return;
+  }
+
+  // The worker only exists while the asynchronous mode is enabled. It waits for worker_mutex, held by our caller.
+
+  if (package_installed && !worker.joinable()) {
+    worker_exit = false;
+
+    worker = std::thread([this]() {
+      // The worker must never compete with the PipeWire data loop. The asynchronous buffer absorbs its jitter.
+
+      dsp_threads::apply_to_current_thread(name + " worker", false);
+
+      worker_loop();
+    });
+  }
+
+  const auto max_frames = std::max(n_samples, PolyphaseResampler::default_max_input_frames);
+
+  async_latency_frames = static_cast<uint>(async_buffer_ms * 0.001 * static_cast<double>(rate));
+
+  // the worker may be one block behind while the realtime thread writes the next one
+
+  const auto capacity = static_cast<size_t>(async_latency_frames) + 4U * max_frames;
+
+  ring_inL = std::make_unique<SpscRing<float>>(capacity);
+  ring_inR = std::make_unique<SpscRing<float>>(capacity);
+  ring_outL = std::make_unique<SpscRing<float>>(capacity);
+  ring_outR = std::make_unique<SpscRing<float>>(capacity);
+
+  const std::vector<float> silence(async_latency_frames, 0.0F);
+
+  ring_outL->push(silence);
+  ring_outR->push(silence);
+
+  async_deficit = 0U;
+
+  work_inL.resize(max_frames);
+  work_inR.resize(max_frames);
+
+  // the output resampler may produce a couple of frames more than it received at the original rate
+
+  work_outL.resize(static_cast<size_t>(max_frames) + 8U);
+  work_outR.resize(static_cast<size_t>(max_frames) + 8U);
+
+  async_ready = true;
+}
+
+void DeepFilterNet::stop_worker() {
+  if (!worker.joinable()) {
+    return;
+  }
+
+  worker_exit = true;
+  worker_signal = true;
+
+  worker_signal.notify_one();
+
+  worker.join();
+}
+
+void DeepFilterNet::update_latency() {
+  latency_value = get_latency_seconds();
+
+  util::debug(log_tag + name + " latency: " + util::to_string(latency_value.load(), "") + " s");
+
+  latency.emit();
+
+  update_filter_params();
+}
+
+void DeepFilterNet::run_model(std::span<float> inL,
+                              std::span<float> inR,
+                              std::span<float> outL,
+                              std::span<float> outR,
+                              const bool& mono) {
+  auto* wrapper = (mono && ladspa_wrapper_mono->has_instance()) ? ladspa_wrapper_mono.get() : ladspa_wrapper.get();
+
+  wrapper->n_samples = inL.size();
+  wrapper->connect_data_ports(inL, inR, outL, outR);
+
+  wrapper->run();
+
+  if (wrapper == ladspa_wrapper_mono.get()) {
+    std::ranges::copy(outL, outR.begin());
+  }
+}
+
+auto DeepFilterNet::process_block(std::span<float> inL, std::span<float> inR, const bool& mono) -> size_t {
+  // worker thread. It returns how many frames were written to work_outL and work_outR
+
+  if (!ladspa_wrapper->has_instance() || !resampler_ready) {
+    std::ranges::copy(inL, work_outL.begin());
+    std::ranges::copy(inR, work_outR.begin());
+
+    return inL.size();
+  }
+
+  if (!resample) {
+    run_model(inL, inR, std::span(work_outL).first(inL.size()), std::span(work_outR).first(inR.size()), mono);
+
+    return inL.size();
+  }
+
+  const auto n_resampled = resampler_inL->process(inL, resampled_inL);
+
+  resampler_inR->process(inR, resampled_inR);
+
+  const auto outL = std::span(resampled_outL).first(n_resampled);
+  const auto outR = std::span(resampled_outR).first(n_resampled);
+
+  run_model(std::span(resampled_inL).first(n_resampled), std::span(resampled_inR).first(n_resampled), outL, outR,
+            mono);
+
+  const auto n_out = resampler_outL->process(outL, work_outL);
+
+  resampler_outR->process(outR, work_outR);
+
+  return n_out;
+}
+
+void DeepFilterNet::worker_loop() {
+  while (true) {
+    worker_signal.wait(false);
+
+    worker_signal = false;
+
+    if (worker_exit) {
+      break;
+    }
+
+    std::scoped_lock<std::mutex> lock(worker_mutex);
+
+    // the right ring is written after the left one, so its size is the number of complete frames
+
+    while (async_ready) {
+      const auto n = std::min(ring_inR->size(), work_inL.size());
+
+      if (n == 0U) {
+        break;
+      }
+
+      ring_inL->pop(std::span(work_inL).first(n));
+      ring_inR->pop(std::span(work_inR).first(n));
+
+      const auto n_out = process_block(std::span(work_inL).first(n), std::span(work_inR).first(n), async_mono);
+
+      ring_outL->push(std::span(work_outL).first(n_out));
+      ring_outR->push(std::span(work_outR).first(n_out));
+    }
+  }
+}
+
 void DeepFilterNet::process(std::span<float>& left_in,
                             std::span<float>& right_in,
                             std::span<float>& left_out,
                             std::span<float>& right_out) {
   std::scoped_lock<std::mutex> lock(data_mutex);
 
-  if (!ladspa_wrapper->found_plugin() || !ladspa_wrapper->has_instance() || bypass) {
+  if (!ladspa_wrapper->found_plugin() || !ladspa_wrapper->has_instance() || bypass || !resampler_ready ||
+      (async_processing && !async_ready)) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -144,53 +420,73 @@ void DeepFilterNet::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  if (resample) {
-    const auto& resampled_inL = resampler_inL->process(left_in, false);
-    const auto& resampled_inR = resampler_inR->process(right_in, false);
+  const bool mono = use_mono_path(left_in, right_in);
 
-    resampled_outL.resize(resampled_inL.size());
-    resampled_outR.resize(resampled_inR.size());
+  if (async_processing) {
+    async_mono = mono;
 
-    ladspa_wrapper->n_samples = resampled_inL.size();
-    ladspa_wrapper->connect_data_ports(resampled_inL, resampled_inR, resampled_outL, resampled_outR);
-  } else {
-    ladspa_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
-  }
+    ring_inL->push(left_in);
+    ring_inR->push(right_in);
 
-  ladspa_wrapper->run();
+    worker_signal = true;
 
-  if (resample) {
-    const auto& outL = resampler_outL->process(resampled_outL, false);
-    const auto& outR = resampler_outR->process(resampled_outR, false);
+    worker_signal.notify_one();
 
-    auto carryover_end_l = std::min(carryover_l.size(), left_out.size());
-    auto carryover_end_r = std::min(carryover_r.size(), right_out.size());
+    // frames the worker delivers late are dropped so that the latency stays the same after an underrun
 
-    auto left_offset =
-        carryover_end_l + outL.size() > left_out.size() ? carryover_end_l : left_out.size() - outL.size();
-    auto right_offset =
-        carryover_end_r + outR.size() > right_out.size() ? carryover_end_r : right_out.size() - outR.size();
+    auto available = ring_outR->size();
 
-    auto left_count = std::min(outL.size(), left_out.size() - left_offset);
-    auto right_count = std::min(outR.size(), right_out.size() - right_offset);
+    if (async_deficit > 0U) {
+      const auto n = std::min(async_deficit, available);
 
-    std::copy(carryover_l.begin(), carryover_l.begin() + carryover_end_l, left_out.begin());
-    std::copy(carryover_r.begin(), carryover_r.begin() + carryover_end_r, right_out.begin());
+      ring_outL->discard(n);
+      ring_outR->discard(n);
 
-    carryover_l.erase(carryover_l.begin(), carryover_l.begin() + carryover_end_l);
-    carryover_r.erase(carryover_r.begin(), carryover_r.begin() + carryover_end_r);
+      async_deficit -= n;
+      available -= n;
+    }
 
-    std::fill(left_out.begin() + carryover_end_l, left_out.begin() + left_offset, 0);
-    std::fill(right_out.begin() + carryover_end_r, right_out.begin() + right_offset, 0);
+    const auto n = std::min(available, left_out.size());
 
-    std::copy(outL.begin(), outL.begin() + left_count, left_out.begin() + left_offset);
-    std::copy(outR.begin(), outR.begin() + right_count, right_out.begin() + right_offset);
+    ring_outL->pop(left_out.first(n));
+    ring_outR->pop(right_out.first(n));
 
-    carryover_l.insert(carryover_l.end(), outL.begin() + left_count, outL.end());
-    carryover_r.insert(carryover_r.end(), outR.begin() + right_count, outR.end());
+    if (n < left_out.size()) {
+      std::fill(left_out.begin() + n, left_out.end(), 0.0F);
+      std::fill(right_out.begin() + n, right_out.end(), 0.0F);
 
-    std::fill(left_out.begin() + left_offset + left_count, left_out.end(), 0);
-    std::fill(right_out.begin() + right_offset + right_count, right_out.end(), 0);
+      async_deficit += left_out.size() - n;
+    }
+  } else {
+    // the worker may still be finishing a block right after the asynchronous mode is disabled
+
+    std::unique_lock<std::mutex> worker_lock(worker_mutex, std::try_to_lock);
+
+    if (!worker_lock.owns_lock()) {
+      std::copy(left_in.begin(), left_in.end(), left_out.begin());
+      std::copy(right_in.begin(), right_in.end(), right_out.begin());
+
+      return;
+    }
+
+    if (resample) {
+      const auto n_resampled = resampler_inL->process(left_in, resampled_inL);
+
+      resampler_inR->process(right_in, resampled_inR);
+
+      const auto outL = std::span(resampled_outL).first(n_resampled);
+      const auto outR = std::span(resampled_outR).first(n_resampled);
+
+      run_model(std::span(resampled_inL).first(n_resampled), std::span(resampled_inR).first(n_resampled), outL, outR,
+                mono);
+
+      // the output resamplers always produce one full quantum with a constant latency
+
+      resampler_outL->process_fixed(outL, left_out);
+      resampler_outR->process_fixed(outR, right_out);
+    } else {
+      run_model(left_in, right_in, left_out, right_out, mono);
+    }
   }
 
   if (output_gain != 1.0F) {
@@ -207,5 +503,14 @@ void DeepFilterNet::process(std::span<float>& left_in,
 }
 
 auto DeepFilterNet::get_latency_seconds() -> float {
-  return 0.02F + 1.0F / rate;
+  if (rate == 0U) {
+    return 0.0F;
+  }
+
+  if (async_processing) {
+    return 0.02F + 1.0F / static_cast<float>(rate) + (resample ? resampler_latency_async : 0.0F) +
+           static_cast<float>(async_latency_frames) / static_cast<float>(rate);
+  }
+
+  return 0.02F + 1.0F / static_cast<float>(rate) + (resample ? resampler_latency : 0.0F);
 }
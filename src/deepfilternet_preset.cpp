@@ -45,6 +45,9 @@ void DeepFilterNetPreset::save(nlohmann::json& json) {
       g_settings_get_double(settings, "max-df-processing-threshold");
   json[section][instance_name]["min-processing-buffer"] = g_settings_get_int(settings, "min-processing-buffer");
   json[section][instance_name]["post-filter-beta"] = g_settings_get_double(settings, "post-filter-beta");
+  json[section][instance_name]["async-processing"] = g_settings_get_boolean(settings, "async-processing") != 0;
+  json[section][instance_name]["async-buffer"] = g_settings_get_double(settings, "async-buffer");
+  json[section][instance_name]["channel-mode"] = util::gsettings_get_string(settings, "channel-mode");
 }
 
 void DeepFilterNetPreset::load(const nlohmann::json& json) {
@@ -57,4 +60,7 @@ void DeepFilterNetPreset::load(const nlohmann::json& json) {
                      "max-df-processing-threshold");
   update_key<int>(json.at(section).at(instance_name), settings, "min-processing-buffer", "min-processing-buffer");
   update_key<double>(json.at(section).at(instance_name), settings, "post-filter-beta", "post-filter-beta");
+  update_key<bool>(json.at(section).at(instance_name), settings, "async-processing", "async-processing");
+  update_key<double>(json.at(section).at(instance_name), settings, "async-buffer", "async-buffer");
+  update_key<gchar*>(json.at(section).at(instance_name), settings, "channel-mode", "channel-mode");
 }
@@ -19,6 +19,7 @@
 
 #include "deepfilternet_ui.hpp"
 #include <STTypes.h>
+#include <adwaita.h>
 #include <gio/gio.h>
 #include <glib-object.h>
 #include <glib.h>
@@ -30,6 +31,8 @@
 #include <string>
 #include <vector>
 #include "deepfilternet.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -68,6 +71,12 @@ struct _DeepFilterNetBox {
   GtkSpinButton *min_processing_thresh, *max_erb_processing_thresh, *max_df_processing_thresh, *min_processing_buffer,
       *post_filter_beta;
 
+  AdwComboRow* channel_mode;
+
+  GtkSwitch* async_processing;
+
+  GtkSpinButton* async_buffer;
+
   GSettings* settings;
 
   Data* data;
@@ -91,39 +100,15 @@ void setup(DeepFilterNetBox* self, std::shared_ptr<DeepFilterNet> deepfilternet,
 
   self->data->deepfilternet = deepfilternet;
 
-  self->settings = g_settings_new_with_path(tags::schema::deepfilternet::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::deepfilternet::id, schema_path.c_str());
 
   deepfilternet->set_post_messages(true);
 
-  self->data->connections.push_back(deepfilternet->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(deepfilternet->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), deepfilternet,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   gtk_label_set_text(self->plugin_credit, ui::get_plugin_credit_translated(self->data->deepfilternet->package).c_str());
 
@@ -133,11 +118,18 @@ void setup(DeepFilterNetBox* self, std::shared_ptr<DeepFilterNet> deepfilternet,
                          "max-df-processing-threshold", "min-processing-buffer", "post-filter-beta">(
       self->settings, self->att_limit, self->min_processing_thresh, self->max_erb_processing_thresh,
       self->max_df_processing_thresh, self->min_processing_buffer, self->post_filter_beta);
+
+  ui::gsettings_bind_enum_to_combo_widget(self->settings, "channel-mode", self->channel_mode);
+
+  gsettings_bind_widgets<"async-processing", "async-buffer">(self->settings, self->async_processing,
+                                                             self->async_buffer);
 }
 
 void dispose(GObject* object) {
   auto* self = EE_DEEPFILTERNET_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -195,6 +187,9 @@ void deepfilternet_box_class_init(DeepFilterNetBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, DeepFilterNetBox, max_df_processing_thresh);
   gtk_widget_class_bind_template_child(widget_class, DeepFilterNetBox, min_processing_buffer);
   gtk_widget_class_bind_template_child(widget_class, DeepFilterNetBox, post_filter_beta);
+  gtk_widget_class_bind_template_child(widget_class, DeepFilterNetBox, channel_mode);
+  gtk_widget_class_bind_template_child(widget_class, DeepFilterNetBox, async_processing);
+  gtk_widget_class_bind_template_child(widget_class, DeepFilterNetBox, async_buffer);
 
   gtk_widget_class_bind_template_callback(widget_class, on_reset);
 }
@@ -209,6 +204,7 @@ void deepfilternet_box_init(DeepFilterNetBox* self) {
   prepare_spinbuttons<"dB">(self->max_df_processing_thresh);
   prepare_spinbuttons<"frames">(self->min_processing_buffer);
   prepare_spinbuttons<"dB">(self->post_filter_beta);
+  prepare_spinbuttons<"ms">(self->async_buffer);
 
   prepare_scales<"dB">(self->att_limit);
 
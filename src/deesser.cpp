@@ -44,6 +44,8 @@ Deesser::Deesser(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://calf.sourceforge.net/plugins/Deesser is not installed");
   }
@@ -126,14 +128,25 @@ void Deesser::process(std::span<float>& left_in,
       detected_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("detected"));
       compression_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("compression"));
 
-      detected.emit(detected_port_value);
-      compression.emit(compression_port_value);
+      post_meters({detected_port_value, compression_port_value});
 
       notify();
     }
   }
 }
 
+void Deesser::reset_meters() {
+  detected_port_value = 0.0;
+  compression_port_value = 1.0;
+
+  post_meters({detected_port_value, compression_port_value});
+}
+
+void Deesser::emit_meters(const MeterValues& values) {
+  detected.emit(values[0U]);
+  compression.emit(values[1U]);
+}
+
 auto Deesser::get_latency_seconds() -> float {
   return 0.0F;
 }
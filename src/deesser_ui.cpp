@@ -32,6 +32,8 @@
 #include <string>
 #include <vector>
 #include "deesser.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -95,39 +97,15 @@ void setup(DeesserBox* self, std::shared_ptr<Deesser> deesser, const std::string
 
   self->data->deesser = deesser;
 
-  self->settings = g_settings_new_with_path(tags::schema::deesser::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::deesser::id, schema_path.c_str());
 
   deesser->set_post_messages(true);
 
-  self->data->connections.push_back(deesser->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(deesser->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), deesser,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   self->data->connections.push_back(deesser->detected.connect([=](const double value) {
     g_object_ref(self);
@@ -207,6 +185,8 @@ void setup(DeesserBox* self, std::shared_ptr<Deesser> deesser, const std::string
 void dispose(GObject* object) {
   auto* self = EE_DEESSER_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
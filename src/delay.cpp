@@ -18,17 +18,25 @@
  */
 
 #include "delay.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
 #include <memory>
 #include <span>
 #include <string>
-#include "lv2_wrapper.hpp"
+#include "delay_line.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
 
+using namespace std::string_literals;
+
 Delay::Delay(const std::string& tag,
              const std::string& schema,
              const std::string& schema_path,
@@ -36,34 +44,29 @@ Delay::Delay(const std::string& tag,
              PipelineType pipe_type)
     : PluginBase(tag,
                  tags::plugin_name::delay,
-                 tags::plugin_package::lsp,
+                 tags::plugin_package::ee,
                  schema,
                  schema_path,
                  pipe_manager,
                  pipe_type) {
-  lv2_wrapper = std::make_unique<lv2::Lv2Wrapper>("http://lsp-plug.in/plugins/lv2/comp_delay_x2_stereo");
-
-  package_installed = lv2_wrapper->found_plugin;
-
-  if (!package_installed) {
-    util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/comp_delay_x2_stereo is not installed");
-  }
+  // the delay line only depends on the rate
 
-  lv2_wrapper->set_control_port_value("mode_l", 2);
-  lv2_wrapper->set_control_port_value("mode_r", 2);
+  quantum_needs_setup = false;
 
-  lv2_wrapper->bind_key_double<"time_l", "time-l">(settings);
-  lv2_wrapper->bind_key_double<"time_r", "time-r">(settings);
+  read_settings();
 
-  lv2_wrapper->bind_key_bool<"phase_l", "invert-phase-l">(settings);
-  lv2_wrapper->bind_key_bool<"phase_r", "invert-phase-r">(settings);
+  applied_levels = {dry_l, dry_r, wet_l, wet_r};
 
-  // The following controls can assume -inf
-  lv2_wrapper->bind_key_double_db<"dry_l", "dry-l", false>(settings);
-  lv2_wrapper->bind_key_double_db<"dry_r", "dry-r", false>(settings);
+  for (const auto* key :
+       {"time-l", "time-r", "dry-l", "dry-r", "wet-l", "wet-r", "invert-phase-l", "invert-phase-r"}) {
+    gconnections.push_back(g_signal_connect(settings, ("changed::"s + key).c_str(),
+                                            G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                              auto* self = static_cast<Delay*>(user_data);
 
-  lv2_wrapper->bind_key_double_db<"wet_l", "wet-l", false>(settings);
-  lv2_wrapper->bind_key_double_db<"wet_r", "wet-r", false>(settings);
+                                              self->read_settings();
+                                            }),
+                                            this));
+  }
 
   setup_input_output_gain();
 }
@@ -76,15 +79,32 @@ Delay::~Delay() {
   util::debug(log_tag + name + " destroyed");
 }
 
+void Delay::read_settings() {
+  // The dry and wet levels can assume -inf
+
+  auto level = [&](const char* key) {
+    const auto key_v = g_settings_get_double(settings, key);
+
+    return (key_v <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_v));
+  };
+
+  time_l = g_settings_get_double(settings, "time-l");
+  time_r = g_settings_get_double(settings, "time-r");
+
+  dry_l = level("dry-l");
+  dry_r = level("dry-r");
+
+  wet_l = (g_settings_get_boolean(settings, "invert-phase-l") != 0) ? -level("wet-l") : level("wet-l");
+  wet_r = (g_settings_get_boolean(settings, "invert-phase-r") != 0) ? -level("wet-r") : level("wet-r");
+}
+
 void Delay::setup() {
-  if (!lv2_wrapper->found_plugin) {
-    return;
-  }
+  // the delay line is only allocated again when the rate changes
 
-  lv2_wrapper->set_n_samples(n_samples);
+  if (delay_line == nullptr || delay_line_rate != rate) {
+    delay_line = std::make_unique<DelayLine>(rate * max_delay / 1000U);
 
-  if (lv2_wrapper->get_rate() != rate) {
-    lv2_wrapper->create_instance(rate);
+    delay_line_rate = rate;
   }
 }
 
@@ -92,7 +112,7 @@ void Delay::process(std::span<float>& left_in,
                     std::span<float>& right_in,
                     std::span<float>& left_out,
                     std::span<float>& right_out) {
-  if (!lv2_wrapper->found_plugin || !lv2_wrapper->has_instance() || bypass) {
+  if (delay_line == nullptr || bypass) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -103,33 +123,59 @@ void Delay::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  lv2_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
-  lv2_wrapper->run();
+  const auto frames_per_ms = static_cast<double>(rate) / 1000.0;
+
+  const auto delay_l = time_l.load(std::memory_order_relaxed) * frames_per_ms;
+  const auto delay_r = time_r.load(std::memory_order_relaxed) * frames_per_ms;
+
+  // the delay line crossfades by itself when the delays change
+
+  delay_line->process(left_in, right_in, left_out, right_out, delay_l, delay_r);
+
+  // the levels are ramped over the block so that a change does not click
+
+  const std::array<float, 4U> levels = {dry_l.load(std::memory_order_relaxed), dry_r.load(std::memory_order_relaxed),
+                                        wet_l.load(std::memory_order_relaxed), wet_r.load(std::memory_order_relaxed)};
+
+  if (levels == applied_levels) {
+    for (size_t n = 0U; n < left_out.size(); n++) {
+      left_out[n] = levels[2] * left_out[n] + levels[0] * left_in[n];
+      right_out[n] = levels[3] * right_out[n] + levels[1] * right_in[n];
+    }
+  } else {
+    std::array<float, 4U> step{};
+
+    for (size_t i = 0U; i < step.size(); i++) {
+      step[i] = (levels[i] - applied_levels[i]) / static_cast<float>(left_out.size());
+    }
+
+    for (size_t n = 0U; n < left_out.size(); n++) {
+      const auto t = static_cast<float>(n + 1U);
+
+      left_out[n] = (applied_levels[2] + t * step[2]) * left_out[n] + (applied_levels[0] + t * step[0]) * left_in[n];
+      right_out[n] =
+          (applied_levels[3] + t * step[3]) * right_out[n] + (applied_levels[1] + t * step[1]) * right_in[n];
+    }
+
+    applied_levels = levels;
+  }
 
   if (output_gain != 1.0F) {
     apply_gain(left_out, right_out, output_gain);
   }
 
   /*
-    This plugin gives the latency in number of samples
+    The delay is the latency of the output. The delay line does not add latency of its own.
   */
 
-  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value("out_latency"));
+  const auto lv = static_cast<uint>(std::lround(std::max(delay_l, delay_r)));
 
   if (latency_n_frames != lv) {
     latency_n_frames = lv;
 
     latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
   }
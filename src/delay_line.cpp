@@ -0,0 +1,176 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "delay_line.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+DelayLine::DelayLine(const uint& max_delay_frames)
+    : max_delay_frames(max_delay_frames),
+      mask(std::bit_ceil(static_cast<size_t>(max_delay_frames) + interpolation_frames + block_frames) - 1U),
+      buffer_left(mask + 1U, 0.0F),
+      buffer_right(mask + 1U, 0.0F),
+      faded(block_frames, 0.0F) {}
+
+void DelayLine::process(std::span<float> left, std::span<float> right, const uint& delay_frames) {
+  process(left, right, left, right, static_cast<double>(delay_frames), static_cast<double>(delay_frames));
+}
+
+void DelayLine::process(std::span<const float> left_in,
+                        std::span<const float> right_in,
+                        std::span<float> left_out,
+                        std::span<float> right_out,
+                        const double& delay_left,
+                        const double& delay_right) {
+  const auto max_delay = static_cast<double>(max_delay_frames);
+
+  const auto d_left = std::clamp(delay_left, 0.0, max_delay);
+  const auto d_right = std::clamp(delay_right, 0.0, max_delay);
+
+  const auto fade_left = previous_left >= 0.0 && previous_left != d_left;
+  const auto fade_right = previous_right >= 0.0 && previous_right != d_right;
+
+  const auto total = left_in.size();
+
+  for (size_t offset = 0U; offset < total; offset += block_frames) {
+    const auto count = std::min(block_frames, total - offset);
+
+    write(left_in.subspan(offset, count), right_in.subspan(offset, count));
+
+    read(buffer_left, left_out.subspan(offset, count), d_left);
+    read(buffer_right, right_out.subspan(offset, count), d_right);
+
+    if (fade_left) {
+      crossfade(buffer_left, left_out.subspan(offset, count), previous_left, offset, total);
+    }
+
+    if (fade_right) {
+      crossfade(buffer_right, right_out.subspan(offset, count), previous_right, offset, total);
+    }
+
+    write_position = (write_position + count) & mask;
+  }
+
+  if (total != 0U) {
+    previous_left = d_left;
+    previous_right = d_right;
+  }
+}
+
+void DelayLine::crossfade(const std::vector<float>& buffer,
+                          std::span<float> output,
+                          const double& previous_delay,
+                          const size_t& offset,
+                          const size_t& total) {
+  auto old_output = std::span(faded).first(output.size());
+
+  read(buffer, old_output, previous_delay);
+
+  const auto step = 1.0F / static_cast<float>(total);
+
+  for (size_t n = 0U; n < output.size(); n++) {
+    const auto w = static_cast<float>(offset + n + 1U) * step;
+
+    output[n] = old_output[n] + w * (output[n] - old_output[n]);
+  }
+}
+
+void DelayLine::write(std::span<const float> left, std::span<const float> right) {
+  // at most two contiguous copies, which the compiler turns into vectorized moves
+
+  const auto first = std::min(left.size(), buffer_left.size() - write_position);
+
+  const auto pos = static_cast<std::ptrdiff_t>(write_position);
+  const auto split = static_cast<std::ptrdiff_t>(first);
+
+  std::copy(left.begin(), left.begin() + split, buffer_left.begin() + pos);
+  std::copy(right.begin(), right.begin() + split, buffer_right.begin() + pos);
+
+  std::copy(left.begin() + split, left.end(), buffer_left.begin());
+  std::copy(right.begin() + split, right.end(), buffer_right.begin());
+}
+
+void DelayLine::read(const std::vector<float>& buffer, std::span<float> output, const double& delay) const {
+  const auto size = buffer.size();
+
+  const auto d_int = static_cast<size_t>(delay);
+
+  const auto frac = delay - static_cast<double>(d_int);
+
+  // position of the first output frame when the delay is d_int
+  const auto start = (write_position + size - d_int) & mask;
+
+  if (frac == 0.0) {
+    const auto first = std::min(output.size(), size - start);
+
+    const auto split = static_cast<std::ptrdiff_t>(first);
+
+    std::copy_n(buffer.begin() + static_cast<std::ptrdiff_t>(start), first, output.begin());
+    std::copy_n(buffer.begin(), output.size() - first, output.begin() + split);
+
+    return;
+  }
+
+  if (d_int == 0U) {
+    // Below one frame there is no older sample on both sides of the read position. Linear interpolation is used.
+
+    const auto a = static_cast<float>(1.0 - frac);
+    const auto b = static_cast<float>(frac);
+
+    for (size_t n = 0U; n < output.size(); n++) {
+      const auto p = (start + n) & mask;
+
+      output[n] = a * buffer[p] + b * buffer[(p + size - 1U) & mask];
+    }
+
+    return;
+  }
+
+  // Lagrange weights for the frames delayed by d_int - 1, d_int, d_int + 1 and d_int + 2. The read position is between
+  // the second and the third one, where the interpolation error is the smallest.
+
+  const auto u = 1.0 + frac;
+
+  const auto h0 = static_cast<float>(-(u - 1.0) * (u - 2.0) * (u - 3.0) / 6.0);
+  const auto h1 = static_cast<float>(u * (u - 2.0) * (u - 3.0) / 2.0);
+  const auto h2 = static_cast<float>(-u * (u - 1.0) * (u - 3.0) / 2.0);
+  const auto h3 = static_cast<float>(u * (u - 1.0) * (u - 2.0) / 6.0);
+
+  for (size_t n = 0U; n < output.size(); n++) {
+    const auto p = start + n + size;
+
+    output[n] = h0 * buffer[(p + 1U) & mask] + h1 * buffer[p & mask] + h2 * buffer[(p - 1U) & mask] +
+                h3 * buffer[(p - 2U) & mask];
+  }
+}
+
+void DelayLine::reset() {
+  std::ranges::fill(buffer_left, 0.0F);
+  std::ranges::fill(buffer_right, 0.0F);
+
+  write_position = 0U;
+
+  previous_left = -1.0;
+  previous_right = -1.0;
+}
@@ -30,6 +30,8 @@
 #include <string>
 #include <vector>
 #include "delay.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -62,8 +64,6 @@ struct _DelayBox {
 
   GtkSpinButton *time_l, *time_r, *dry_l, *dry_r, *wet_l, *wet_r;
 
-  GtkToggleButton* show_native_ui;
-
   GtkSwitch *invert_phase_l, *invert_phase_r;
 
   GSettings* settings;
@@ -78,14 +78,6 @@ void on_reset(DelayBox* self, GtkButton* btn) {
   util::reset_all_keys_except(self->settings);
 }
 
-void on_show_native_window(DelayBox* self, GtkToggleButton* btn) {
-  if (gtk_toggle_button_get_active(btn) != 0) {
-    self->data->delay->show_native_ui();
-  } else {
-    self->data->delay->close_native_ui();
-  }
-}
-
 void setup(DelayBox* self, std::shared_ptr<Delay> delay, const std::string& schema_path) {
   self->data->delay = delay;
 
@@ -97,39 +89,15 @@ void setup(DelayBox* self, std::shared_ptr<Delay> delay, const std::string& sche
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::delay::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::delay::id, schema_path.c_str());
 
   delay->set_post_messages(true);
 
-  self->data->connections.push_back(delay->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(delay->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), delay,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   gtk_label_set_text(self->plugin_credit, ui::get_plugin_credit_translated(self->data->delay->package).c_str());
 
@@ -156,15 +124,12 @@ void setup(DelayBox* self, std::shared_ptr<Delay> delay, const std::string& sche
   g_settings_bind(self->settings, "invert-phase-l", self->invert_phase_l, "active", G_SETTINGS_BIND_DEFAULT);
 
   g_settings_bind(self->settings, "invert-phase-r", self->invert_phase_r, "active", G_SETTINGS_BIND_DEFAULT);
-
-  g_settings_bind(ui::get_global_app_settings(), "show-native-plugin-ui", self->show_native_ui, "visible",
-                  G_SETTINGS_BIND_DEFAULT);
 }
 
 void dispose(GObject* object) {
   auto* self = EE_DELAY_BOX(object);
 
-  self->data->delay->close_native_ui();
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
 
   set_ignore_filter_idle_add(self->data->serial, true);
 
@@ -226,10 +191,7 @@ void delay_box_class_init(DelayBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, DelayBox, invert_phase_l);
   gtk_widget_class_bind_template_child(widget_class, DelayBox, invert_phase_r);
 
-  gtk_widget_class_bind_template_child(widget_class, DelayBox, show_native_ui);
-
   gtk_widget_class_bind_template_callback(widget_class, on_reset);
-  gtk_widget_class_bind_template_callback(widget_class, on_show_native_window);
 }
 
 void delay_box_init(DelayBox* self) {
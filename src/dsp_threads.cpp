@@ -0,0 +1,206 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dsp_threads.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <sys/types.h>
+#include <zita-convolver.h>
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "util.hpp"
+
+namespace dsp_threads {
+
+namespace {
+
+std::mutex config_mutex;
+
+Config current_config;
+
+auto clamp_priority(const int& priority, const int& policy) -> int {
+  return std::clamp(priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+}
+
+/*
+  zita does not check if its threads were created. Without permission to use realtime scheduling the engine would
+  wait forever for them in sync mode, so we check beforehand with a thread that exits right away.
+*/
+
+auto can_create_thread(const int& priority, const int& policy) -> bool {
+  pthread_attr_t attr;
+  sched_param param{};
+
+  param.sched_priority = clamp_priority(priority, policy);
+
+  pthread_attr_init(&attr);
+  pthread_attr_setschedpolicy(&attr, policy);
+  pthread_attr_setschedparam(&attr, &param);
+  pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+
+  pthread_t thread;
+
+  const bool created = pthread_create(&thread, &attr, [](void*) -> void* { return nullptr; }, nullptr) == 0;
+
+  pthread_attr_destroy(&attr);
+
+  if (created) {
+    pthread_join(thread, nullptr);
+  }
+
+  return created;
+}
+
+}  // namespace
+
+void set_config(Config config) {
+  std::scoped_lock<std::mutex> lock(config_mutex);
+
+  current_config = std::move(config);
+}
+
+auto get_config() -> Config {
+  std::scoped_lock<std::mutex> lock(config_mutex);
+
+  return current_config;
+}
+
+auto parse_cpu_list(const std::string& list) -> std::vector<int> {
+  std::vector<int> cpus;
+
+  std::stringstream stream(list);
+
+  for (std::string item; std::getline(stream, item, ',');) {
+    int first = -1;
+    int last = -1;
+
+    if (const auto dash = item.find('-'); dash != std::string::npos) {
+      if (!util::str_to_num(item.substr(0U, dash), first) || !util::str_to_num(item.substr(dash + 1U), last)) {
+        continue;
+      }
+    } else if (util::str_to_num(item, first)) {
+      last = first;
+    } else {
+      continue;
+    }
+
+    for (int cpu = std::max(first, 0); cpu <= std::min(last, CPU_SETSIZE - 1); cpu++) {
+      if (std::ranges::find(cpus, cpu) == cpus.end()) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+
+  return cpus;
+}
+
+auto get_max_partition(const uint& block_size) -> uint {
+  const auto threads = std::min(get_config().threads, 8U);
+
+  const auto max_partition = static_cast<uint>(std::min(static_cast<size_t>(block_size) << threads,
+                                                        static_cast<size_t>(Convproc::MAXPART)));
+
+  return std::max(block_size, max_partition);
+}
+
+auto start(Convproc* conv) -> int {
+  const auto config = get_config();
+
+  int policy = config.realtime ? SCHED_FIFO : SCHED_OTHER;
+
+  if (config.threads != 0U && policy != SCHED_OTHER && !can_create_thread(config.priority, policy)) {
+    util::warning("realtime scheduling is not allowed. The convolution threads will use the normal scheduler");
+
+    policy = SCHED_OTHER;
+  }
+
+  // The engine threads inherit the affinity of the thread that creates them
+
+  cpu_set_t previous_set;
+
+  bool pinned = false;
+
+  if (!config.cpus.empty() && pthread_getaffinity_np(pthread_self(), sizeof(previous_set), &previous_set) == 0) {
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+
+    for (const auto& cpu : config.cpus) {
+      CPU_SET(cpu, &set);
+    }
+
+    pinned = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+
+    if (!pinned) {
+      util::warning("could not pin the convolution threads to the selected cores");
+    }
+  }
+
+  const auto ret = conv->start_process(clamp_priority(config.priority, policy), policy);
+
+  if (pinned) {
+    pthread_setaffinity_np(pthread_self(), sizeof(previous_set), &previous_set);
+  }
+
+  return ret;
+}
+
+void apply_to_current_thread(const std::string& thread_name, const bool& allow_realtime) {
+  const auto config = get_config();
+
+  /*
+    The policy is always set, also when it is the normal scheduler. Otherwise the thread would inherit the policy of
+    the thread that created it, which can be a realtime one.
+  */
+
+  sched_param param{};
+
+  int policy = (config.realtime && allow_realtime) ? SCHED_FIFO : SCHED_OTHER;
+
+  param.sched_priority = (policy == SCHED_OTHER) ? 0 : clamp_priority(config.priority, policy);
+
+  if (pthread_setschedparam(pthread_self(), policy, &param) != 0 && policy != SCHED_OTHER) {
+    util::warning("realtime scheduling is not allowed. The " + thread_name + " thread will use the normal scheduler");
+
+    param.sched_priority = 0;
+
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+  }
+
+  if (!config.cpus.empty()) {
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+
+    for (const auto& cpu : config.cpus) {
+      CPU_SET(cpu, &set);
+    }
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+      util::warning("could not pin the " + thread_name + " thread to the selected cores");
+    }
+  }
+}
+
+}  // namespace dsp_threads
@@ -23,6 +23,7 @@
 #include <glib.h>
 #include <libintl.h>
 #include <cerrno>
+#include <csignal>
 #include <cstdlib>
 #include <exception>
 #include <iostream>
@@ -30,11 +31,16 @@
 #include <string>
 #include "application.hpp"
 #include "config.h"
+#include "settings_store.hpp"
 #include "util.hpp"
 
 auto sigterm(void* data) -> int {
   auto* app = G_APPLICATION(data);
 
+  // the settings changes still kept in memory are written before anything else can go wrong
+
+  settings_store::flush();
+
   app::hide_all_windows(app);
 
   g_application_quit(app);
@@ -62,7 +68,8 @@ auto main(int argc, char* argv[]) -> int {
 
     auto* app = app::application_new();
 
-    g_unix_signal_add(2, G_SOURCE_FUNC(sigterm), app);
+    g_unix_signal_add(SIGINT, G_SOURCE_FUNC(sigterm), app);
+    g_unix_signal_add(SIGTERM, G_SOURCE_FUNC(sigterm), app);
 
     auto status = g_application_run(app, argc, argv);
 
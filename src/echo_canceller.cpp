@@ -99,6 +99,8 @@ EchoCanceller::EchoCanceller(const std::string& tag,
       this));
 
   setup_input_output_gain();
+
+  setup_channel_mode();
 }
 
 EchoCanceller::~EchoCanceller() {
@@ -156,9 +158,10 @@ void EchoCanceller::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
+  const bool mono = use_mono_path(left_in, right_in);
+
   for (size_t j = 0U; j < left_in.size(); j++) {
     data_L[j] = static_cast<spx_int16_t>(left_in[j] * (SHRT_MAX + 1));
-    data_R[j] = static_cast<spx_int16_t>(right_in[j] * (SHRT_MAX + 1));
 
     /*
       This is a very naive and not corect attempt to mitigate the shortcomes discussed at
@@ -169,15 +172,27 @@ void EchoCanceller::process(std::span<float>& left_in,
   }
 
   speex_echo_cancellation(echo_state_L, data_L.data(), probe_mono.data(), filtered_L.data());
-  speex_echo_cancellation(echo_state_R, data_R.data(), probe_mono.data(), filtered_R.data());
 
   speex_preprocess_run(state_left, filtered_L.data());
-  speex_preprocess_run(state_right, filtered_R.data());
 
   for (size_t j = 0U; j < filtered_L.size(); j++) {
     left_out[j] = static_cast<float>(filtered_L[j]) * inv_short_max;
+  }
+
+  if (mono) {
+    std::ranges::copy(left_out, right_out.begin());
+  } else {
+    for (size_t j = 0U; j < right_in.size(); j++) {
+      data_R[j] = static_cast<spx_int16_t>(right_in[j] * (SHRT_MAX + 1));
+    }
 
-    right_out[j] = static_cast<float>(filtered_R[j]) * inv_short_max;
+    speex_echo_cancellation(echo_state_R, data_R.data(), probe_mono.data(), filtered_R.data());
+
+    speex_preprocess_run(state_right, filtered_R.data());
+
+    for (size_t j = 0U; j < filtered_R.size(); j++) {
+      right_out[j] = static_cast<float>(filtered_R[j]) * inv_short_max;
+    }
   }
 
   if (output_gain != 1.0F) {
@@ -187,15 +202,7 @@ void EchoCanceller::process(std::span<float>& left_in,
   if (notify_latency) {
     const float latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
 
@@ -47,6 +47,8 @@ void EchoCancellerPreset::save(nlohmann::json& json) {
   json[section][instance_name]["residual-echo-suppression"] = g_settings_get_int(settings, "residual-echo-suppression");
 
   json[section][instance_name]["near-end-suppression"] = g_settings_get_int(settings, "near-end-suppression");
+
+  json[section][instance_name]["channel-mode"] = util::gsettings_get_string(settings, "channel-mode");
 }
 
 void EchoCancellerPreset::load(const nlohmann::json& json) {
@@ -62,4 +64,6 @@ void EchoCancellerPreset::load(const nlohmann::json& json) {
                   "residual-echo-suppression");
 
   update_key<int>(json.at(section).at(instance_name), settings, "near-end-suppression", "near-end-suppression");
+
+  update_key<gchar*>(json.at(section).at(instance_name), settings, "channel-mode", "channel-mode");
 }
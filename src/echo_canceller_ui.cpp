@@ -19,6 +19,7 @@
 
 #include "echo_canceller_ui.hpp"
 #include <STTypes.h>
+#include <adwaita.h>
 #include <gio/gio.h>
 #include <glib-object.h>
 #include <glib.h>
@@ -30,6 +31,8 @@
 #include <string>
 #include <vector>
 #include "echo_canceller.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -62,6 +65,8 @@ struct _EchoCancellerBox {
 
   GtkSpinButton *filter_length, *residual_echo_suppression, *near_end_suppression;
 
+  AdwComboRow* channel_mode;
+
   GSettings* settings;
 
   Data* data;
@@ -85,39 +90,15 @@ void setup(EchoCancellerBox* self, std::shared_ptr<EchoCanceller> echo_canceller
 
   self->data->echo_canceller = echo_canceller;
 
-  self->settings = g_settings_new_with_path(tags::schema::echo_canceller::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::echo_canceller::id, schema_path.c_str());
 
   echo_canceller->set_post_messages(true);
 
-  self->data->connections.push_back(echo_canceller->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(echo_canceller->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), echo_canceller,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   gtk_label_set_text(self->plugin_credit,
                      ui::get_plugin_credit_translated(self->data->echo_canceller->package).c_str());
@@ -126,11 +107,15 @@ void setup(EchoCancellerBox* self, std::shared_ptr<EchoCanceller> echo_canceller
                          "near-end-suppression">(self->settings, self->input_gain, self->output_gain,
                                                  self->filter_length, self->residual_echo_suppression,
                                                  self->near_end_suppression);
+
+  ui::gsettings_bind_enum_to_combo_widget(self->settings, "channel-mode", self->channel_mode);
 }
 
 void dispose(GObject* object) {
   auto* self = EE_ECHO_CANCELLER_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -185,6 +170,7 @@ void echo_canceller_box_class_init(EchoCancellerBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, EchoCancellerBox, filter_length);
   gtk_widget_class_bind_template_child(widget_class, EchoCancellerBox, residual_echo_suppression);
   gtk_widget_class_bind_template_child(widget_class, EchoCancellerBox, near_end_suppression);
+  gtk_widget_class_bind_template_child(widget_class, EchoCancellerBox, channel_mode);
 
   gtk_widget_class_bind_template_callback(widget_class, on_reset);
 }
@@ -0,0 +1,334 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+  ee-bench: measures the cost of the process() method of every plugin without PipeWire, using OfflineHost. Each plugin
+  is created with the same factory used by the pipelines, but with a null PipeManager, and its settings are kept in the
+  GSettings memory backend so that the user configuration is never touched. The schemas have to be installed or
+  GSETTINGS_SCHEMA_DIR has to point to a directory with the compiled ones.
+
+  For every rate and quantum the plugin is set up as PipeWire would do, warmed up, and then fed with noise for the
+  requested amount of audio. The results are written to the standard output as json. The equalizer is measured
+  with its LSP and native engines, the second one being reported as equalizer-native.
+
+  The bench is always built with rt_checks. Its interposed allocator counts the allocations done by process() in a
+  second pass that is not timed, and the backtraces of all the calls it caught are written to its report when the
+  bench exits.
+*/
+
+#include <gio/gio.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "config.h"
+#include "effects_base.hpp"
+#include "equalizer.hpp"
+#include "offline_host.hpp"
+#include "pipeline_type.hpp"
+#include "plugin_base.hpp"
+#include "rt_checks.hpp"
+#include "settings_store.hpp"
+#include "tags_app.hpp"
+#include "tags_equalizer.hpp"
+#include "tags_plugin_name.hpp"
+#include "tags_schema.hpp"
+#include "util.hpp"
+
+namespace {
+
+constexpr auto rates = std::to_array<uint>({44100U, 48000U, 96000U});
+
+constexpr auto quanta = std::to_array<uint>({32U, 64U, 128U, 256U, 512U, 1024U, 2048U, 4096U});
+
+constexpr uint warmup_quanta = 32U;
+
+constexpr uint max_noise_quanta = 256U;  // the input is repeated after that
+
+auto percentile(std::vector<double> values, const double& p) -> double {
+  if (values.empty()) {
+    return 0.0;
+  }
+
+  const auto n = static_cast<size_t>(p * static_cast<double>(values.size() - 1U));
+
+  std::ranges::nth_element(values, values.begin() + static_cast<std::ptrdiff_t>(n));
+
+  return values[n];
+}
+
+/*
+  The default equalizer bands are flat and the native engine skips them. Every band gets a gain so that both engines
+  process 32 bands per channel.
+*/
+void prepare_equalizer(const std::string& path, const char* engine) {
+  auto* settings = settings_store::get(tags::schema::equalizer::id, path.c_str());
+
+  g_settings_set_string(settings, "engine", engine);
+
+  g_object_unref(settings);
+
+  for (const auto* channel : {"leftchannel/", "rightchannel/"}) {
+    auto* settings = settings_store::get(tags::schema::equalizer::channel_id, (path + channel).c_str());
+
+    using namespace tags::equalizer;
+
+    for (size_t n = 0U; n < band_gain.size(); n++) {
+      g_settings_set_string(settings, band_type[n].data(), "Bell");
+
+      g_settings_set_double(settings, band_gain[n].data(), (n % 2U == 0U) ? 3.0 : -3.0);
+    }
+
+    g_object_unref(settings);
+  }
+}
+
+auto run(OfflineHost& host, const uint& rate, const uint& quantum, const double& seconds) -> nlohmann::json {
+  // Some plugins finish their setup in the main loop or in worker threads. The host waits for the main loop.
+
+  host.configure(rate, quantum);
+
+  const auto iterations =
+      std::max(static_cast<uint>(seconds * static_cast<double>(rate) / static_cast<double>(quantum)), 1U);
+
+  // The noise is generated before anything is measured, so that only process() is timed
+
+  const auto n_noise_quanta = std::min(iterations, max_noise_quanta);
+
+  std::minstd_rand generator(1U);
+  std::uniform_real_distribution<float> noise(-0.1F, 0.1F);
+
+  std::vector<float> left_noise(static_cast<size_t>(n_noise_quanta) * quantum);
+  std::vector<float> right_noise(left_noise.size());
+
+  std::ranges::generate(left_noise, [&]() { return noise(generator); });
+  std::ranges::generate(right_noise, [&]() { return noise(generator); });
+
+  std::vector<float> left_out(quantum), right_out(quantum);
+
+  auto process = [&](const uint& n) {
+    const auto offset = static_cast<size_t>(n % n_noise_quanta) * quantum;
+
+    host.process(std::span(left_noise).subspan(offset, quantum), std::span(right_noise).subspan(offset, quantum),
+                 left_out, right_out);
+  };
+
+  for (uint n = 0U; n < warmup_quanta; n++) {
+    process(n);
+
+    OfflineHost::drain_main_context();
+  }
+
+  std::vector<double> times;
+
+  times.reserve(iterations);
+
+  double total = 0.0;
+
+  for (uint n = 0U; n < iterations; n++) {
+    const auto t0 = std::chrono::steady_clock::now();
+
+    process(n);
+
+    const auto t1 = std::chrono::steady_clock::now();
+
+    const auto ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+
+    times.push_back(ns);
+
+    total += ns;
+  }
+
+  /*
+    The allocations are counted in a second pass over the same input. Inside the realtime region the interposed
+    allocator of rt_checks records a backtrace of every call it catches, what would distort the timings above. It
+    also sees the allocations made by C code and by the LV2 libraries.
+  */
+
+  const auto first_allocation = rt_checks::get_allocation_count();
+
+  for (uint n = 0U; n < iterations; n++) {
+    rt_checks::ScopedRealtime realtime;
+
+    process(n);
+  }
+
+  nlohmann::json result;
+
+  result["rate"] = rate;
+  result["quantum"] = quantum;
+  result["iterations"] = iterations;
+  result["ns_per_sample"] = total / (static_cast<double>(iterations) * static_cast<double>(quantum));
+  result["mean_quantum_ns"] = total / static_cast<double>(iterations);
+  result["p99_quantum_ns"] = percentile(times, 0.99);
+  result["max_quantum_ns"] = *std::ranges::max_element(times);
+  result["realtime_load"] = total / (static_cast<double>(iterations) * 1e9 * quantum / rate);
+  result["allocations"] = rt_checks::get_allocation_count() - first_allocation;
+
+  return result;
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  // The bench must never write to the user settings
+
+  g_setenv("GSETTINGS_BACKEND", "memory", 1);
+
+  gchar* plugins_option = nullptr;
+  gdouble seconds = 1.0;
+
+  std::array<GOptionEntry, 3> entries{};
+
+  entries[0] = {"plugins", 'p', 0, G_OPTION_ARG_STRING, &plugins_option,
+                "Comma separated list of plugins to measure. All of them by default.", "LIST"};
+  entries[1] = {"seconds", 's', 0, G_OPTION_ARG_DOUBLE, &seconds,
+                "Amount of audio processed for each rate and quantum. The default is 1.", "SECONDS"};
+
+  auto* context = g_option_context_new("- measures the cost of the Easy Effects plugins");
+
+  g_option_context_add_main_entries(context, entries.data(), nullptr);
+
+  if (GError* error = nullptr; g_option_context_parse(context, &argc, &argv, &error) == 0) {
+    std::cerr << error->message << '\n';
+
+    g_error_free(error);
+    g_option_context_free(context);
+
+    return EXIT_FAILURE;
+  }
+
+  g_option_context_free(context);
+
+  auto* schema = g_settings_schema_source_lookup(g_settings_schema_source_get_default(), tags::app::id, 1);
+
+  if (schema == nullptr) {
+    std::cerr << "The Easy Effects schemas were not found. Set GSETTINGS_SCHEMA_DIR to the compiled schemas.\n";
+
+    return EXIT_FAILURE;
+  }
+
+  g_settings_schema_unref(schema);
+
+  std::vector<std::string> selected;
+
+  if (plugins_option != nullptr) {
+    std::stringstream stream(plugins_option);
+
+    for (std::string item; std::getline(stream, item, ',');) {
+      selected.push_back(item);
+    }
+
+    g_free(plugins_option);
+  }
+
+  const std::string schema_base_path = "/com/github/wwmm/easyeffects/streamoutputs/";
+
+  nlohmann::json report;
+
+  report["version"] = VERSION;
+  report["seconds"] = seconds;
+  report["plugins"] = nlohmann::json::array();
+
+  // The equalizer is measured with both of its engines
+
+  struct Variant {
+    std::string name, label;
+
+    const char* engine = nullptr;
+  };
+
+  std::vector<Variant> variants;
+
+  for (const auto& base_name : tags::plugin_name::list) {
+    const std::string name = base_name;
+
+    if (!selected.empty() && std::ranges::find(selected, name) == selected.end()) {
+      continue;
+    }
+
+    if (name == tags::plugin_name::equalizer) {
+      variants.push_back({.name = name, .label = name, .engine = "LSP"});
+      variants.push_back({.name = name, .label = name + "-native", .engine = "Native"});
+    } else {
+      variants.push_back({.name = name, .label = name});
+    }
+  }
+
+  for (const auto& [name, label, engine] : variants) {
+    if (engine != nullptr) {
+      prepare_equalizer(schema_base_path + "equalizer/0/", engine);
+    }
+
+    auto plugin = EffectsBase::create_plugin(name + "#0", "ee-bench: ", schema_base_path, nullptr,
+                                             PipelineType::output);
+
+    nlohmann::json entry;
+
+    entry["name"] = label;
+    entry["installed"] = plugin != nullptr && plugin->package_installed;
+    entry["results"] = nlohmann::json::array();
+
+    // The equalizer falls back to the native engine when the LSP plugin is missing
+
+    if (auto eq = std::dynamic_pointer_cast<Equalizer>(plugin); eq != nullptr && engine != nullptr) {
+      const bool native = std::string(engine) == "Native";
+
+      entry["installed"] = eq->using_native_engine() == native;
+    }
+
+    if (entry["installed"].get<bool>()) {
+      util::debug("measuring " + label);
+
+      OfflineHost host(plugin);
+
+      for (const auto& rate : rates) {
+        for (const auto& quantum : quanta) {
+          auto result = run(host, rate, quantum, seconds);
+
+          result["latency_seconds"] = host.get_latency_seconds();
+
+          entry["results"].push_back(result);
+        }
+      }
+    }
+
+    report["plugins"].push_back(entry);
+
+    plugin.reset();
+
+    OfflineHost::drain_main_context();
+  }
+
+  std::cout << std::setw(2) << report << '\n';
+
+  return EXIT_SUCCESS;
+}
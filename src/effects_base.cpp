@@ -22,11 +22,17 @@
 #include <glib-object.h>
 #include <glib.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <ranges>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 #include "autogain.hpp"
 #include "bass_enhancer.hpp"
 #include "bass_loudness.hpp"
@@ -47,6 +53,7 @@
 #include "limiter.hpp"
 #include "loudness.hpp"
 #include "maximizer.hpp"
+#include "metering_bus.hpp"
 #include "multiband_compressor.hpp"
 #include "multiband_gate.hpp"
 #include "output_level.hpp"
@@ -63,6 +70,14 @@
 #include "tags_schema.hpp"
 #include "util.hpp"
 
+namespace {
+
+auto is_linked(const std::vector<std::vector<std::string>>& stages, const std::string& name) -> bool {
+  return std::ranges::any_of(stages, [&](const auto& stage) { return std::ranges::find(stage, name) != stage.end(); });
+}
+
+}  // namespace
+
 EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager* pipe_manager, PipelineType pipe_type)
     : log_tag(std::move(tag)),
       pm(pipe_manager),
@@ -112,6 +127,8 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
                                                    for (auto& plugin : self->plugins | std::views::values) {
                                                      plugin->notification_time_window = 0.001F * v;
                                                    }
+
+                                                   self->start_events_source();
                                                  }),
                                                  this));
 
@@ -135,9 +152,19 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
   for (auto& plugin : plugins | std::views::values) {
     plugin->notification_time_window = notification_time_window;
   }
+
+  start_events_source();
 }
 
 EffectsBase::~EffectsBase() {
+  if (events_source_id != 0U) {
+    g_source_remove(events_source_id);
+  }
+
+  if (idle_source_id != 0U) {
+    g_source_remove(idle_source_id);
+  }
+
   for (auto& c : connections) {
     c.disconnect();
   }
@@ -155,6 +182,28 @@ EffectsBase::~EffectsBase() {
   util::debug("effects_base: destroyed");
 }
 
+void EffectsBase::start_events_source() {
+  if (events_source_id != 0U) {
+    g_source_remove(events_source_id);
+  }
+
+  // The levels are queued at most once per meters update interval, so draining at the same rate keeps the queues short
+
+  const auto interval = std::max(g_settings_get_int(global_settings, "meters-update-interval"), 1);
+
+  events_source_id = g_timeout_add(static_cast<guint>(interval), GSourceFunc(+[](EffectsBase* self) {
+                                     self->output_level->dispatch_events();
+                                     self->spectrum->dispatch_events();
+
+                                     for (const auto& plugin : self->plugins | std::views::values) {
+                                       plugin->dispatch_events();
+                                     }
+
+                                     return G_SOURCE_CONTINUE;
+                                   }),
+                                   this);
+}
+
 void EffectsBase::reset_settings() {
   util::reset_all_keys_except(settings, {"input-device", "output-device"});
 
@@ -165,6 +214,86 @@ void EffectsBase::reset_settings() {
   }
 }
 
+auto EffectsBase::create_plugin(const std::string& name) -> std::shared_ptr<PluginBase> {
+  return create_plugin(name, log_tag, schema_base_path, pm, pipeline_type);
+}
+
+auto EffectsBase::create_plugin(const std::string& name,
+                                const std::string& tag,
+                                const std::string& base_path,
+                                PipeManager* pipe_manager,
+                                PipelineType pipe_type) -> std::shared_ptr<PluginBase> {
+  auto instance_id = util::to_string(tags::plugin_name::get_id(name));
+
+  auto path = base_path + tags::plugin_name::get_base_name(name) + "/" + instance_id + "/";
+
+  path.erase(std::remove(path.begin(), path.end(), '_'), path.end());
+
+  std::shared_ptr<PluginBase> filter;
+
+  if (name.starts_with(tags::plugin_name::autogain)) {
+    filter = std::make_shared<AutoGain>(tag, tags::schema::autogain::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::bass_enhancer)) {
+    filter = std::make_shared<BassEnhancer>(tag, tags::schema::bass_enhancer::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::bass_loudness)) {
+    filter = std::make_shared<BassLoudness>(tag, tags::schema::bass_loudness::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::compressor)) {
+    filter = std::make_shared<Compressor>(tag, tags::schema::compressor::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::convolver)) {
+    filter = std::make_shared<Convolver>(tag, tags::schema::convolver::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::crossfeed)) {
+    filter = std::make_shared<Crossfeed>(tag, tags::schema::crossfeed::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::crystalizer)) {
+    filter = std::make_shared<Crystalizer>(tag, tags::schema::crystalizer::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::deepfilternet)) {
+    filter = std::make_shared<DeepFilterNet>(tag, tags::schema::deepfilternet::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::deesser)) {
+    filter = std::make_shared<Deesser>(tag, tags::schema::deesser::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::delay)) {
+    filter = std::make_shared<Delay>(tag, tags::schema::delay::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::echo_canceller)) {
+    filter = std::make_shared<EchoCanceller>(tag, tags::schema::echo_canceller::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::exciter)) {
+    filter = std::make_shared<Exciter>(tag, tags::schema::exciter::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::expander)) {
+    filter = std::make_shared<Expander>(tag, tags::schema::expander::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::equalizer)) {
+    filter = std::make_shared<Equalizer>(
+        tag, tags::schema::equalizer::id, path, tags::schema::equalizer::channel_id,
+        base_path + "equalizer/" + instance_id + "/leftchannel/",
+        base_path + "equalizer/" + instance_id + "/rightchannel/", pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::filter)) {
+    filter = std::make_shared<Filter>(tag, tags::schema::filter::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::gate)) {
+    filter = std::make_shared<Gate>(tag, tags::schema::gate::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::level_meter)) {
+    filter = std::make_shared<LevelMeter>(tag, tags::schema::level_meter::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::limiter)) {
+    filter = std::make_shared<Limiter>(tag, tags::schema::limiter::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::loudness)) {
+    filter = std::make_shared<Loudness>(tag, tags::schema::loudness::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::maximizer)) {
+    filter = std::make_shared<Maximizer>(tag, tags::schema::maximizer::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::multiband_compressor)) {
+    filter = std::make_shared<MultibandCompressor>(tag, tags::schema::multiband_compressor::id, path, pipe_manager,
+                                                   pipe_type);
+  } else if (name.starts_with(tags::plugin_name::multiband_gate)) {
+    filter = std::make_shared<MultibandGate>(tag, tags::schema::multiband_gate::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::pitch)) {
+    filter = std::make_shared<Pitch>(tag, tags::schema::pitch::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::reverb)) {
+    filter = std::make_shared<Reverb>(tag, tags::schema::reverb::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::rnnoise)) {
+    filter = std::make_shared<RNNoise>(tag, tags::schema::rnnoise::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::speex)) {
+    filter = std::make_shared<Speex>(tag, tags::schema::speex::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::stereo_tools)) {
+    filter = std::make_shared<StereoTools>(tag, tags::schema::stereo_tools::id, path, pipe_manager, pipe_type);
+  }
+
+  return filter;
+}
+
 void EffectsBase::create_filters_if_necessary() {
   const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
 
@@ -172,82 +301,72 @@ void EffectsBase::create_filters_if_necessary() {
     return;
   }
 
+  std::vector<std::string> new_names;
+
   for (const auto& name : list) {
-    if (plugins.contains(name)) {
+    if (!plugins.contains(name)) {
+      new_names.push_back(name);
+    }
+  }
+
+  if (new_names.empty()) {
+    return;
+  }
+
+  /*
+    Most of the startup time is spent in the plugin constructors scanning the LV2 world and loading libraries. They
+    do not touch PipeWire, so they run in parallel. The PipeWire filters are created afterwards in this thread.
+  */
+
+  std::vector<std::shared_ptr<PluginBase>> prepared(new_names.size());
+
+  std::atomic<size_t> next = 0U;
+
+  auto prepare = [&]() {
+    for (auto n = next++; n < new_names.size(); n = next++) {
+      prepared[n] = create_plugin(new_names[n]);
+    }
+  };
+
+  const auto n_threads =
+      std::clamp(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1U), new_names.size());
+
+  std::vector<std::thread> workers;
+
+  for (size_t n = 1U; n < n_threads; n++) {
+    workers.emplace_back(prepare);
+  }
+
+  prepare();
+
+  for (auto& t : workers) {
+    t.join();
+  }
+
+  for (size_t n = 0U; n < new_names.size(); n++) {
+    auto& filter = prepared[n];
+
+    if (filter == nullptr) {
+      util::warning(log_tag + "unknown plugin: " + new_names[n]);
+
       continue;
     }
 
-    auto instance_id = util::to_string(tags::plugin_name::get_id(name));
-
-    auto path = schema_base_path + tags::plugin_name::get_base_name(name) + "/" + instance_id + "/";
-
-    path.erase(std::remove(path.begin(), path.end(), '_'), path.end());
-
-    std::shared_ptr<PluginBase> filter;
-
-    if (name.starts_with(tags::plugin_name::autogain)) {
-      filter = std::make_shared<AutoGain>(log_tag, tags::schema::autogain::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::bass_enhancer)) {
-      filter = std::make_shared<BassEnhancer>(log_tag, tags::schema::bass_enhancer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::bass_loudness)) {
-      filter = std::make_shared<BassLoudness>(log_tag, tags::schema::bass_loudness::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::compressor)) {
-      filter = std::make_shared<Compressor>(log_tag, tags::schema::compressor::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::convolver)) {
-      filter = std::make_shared<Convolver>(log_tag, tags::schema::convolver::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::crossfeed)) {
-      filter = std::make_shared<Crossfeed>(log_tag, tags::schema::crossfeed::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::crystalizer)) {
-      filter = std::make_shared<Crystalizer>(log_tag, tags::schema::crystalizer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::deepfilternet)) {
-      filter = std::make_shared<DeepFilterNet>(log_tag, tags::schema::deepfilternet::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::deesser)) {
-      filter = std::make_shared<Deesser>(log_tag, tags::schema::deesser::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::delay)) {
-      filter = std::make_shared<Delay>(log_tag, tags::schema::delay::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::echo_canceller)) {
-      filter = std::make_shared<EchoCanceller>(log_tag, tags::schema::echo_canceller::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::exciter)) {
-      filter = std::make_shared<Exciter>(log_tag, tags::schema::exciter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::expander)) {
-      filter = std::make_shared<Expander>(log_tag, tags::schema::expander::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::equalizer)) {
-      filter = std::make_shared<Equalizer>(
-          log_tag, tags::schema::equalizer::id, path, tags::schema::equalizer::channel_id,
-          schema_base_path + "equalizer/" + instance_id + "/leftchannel/",
-          schema_base_path + "equalizer/" + instance_id + "/rightchannel/", pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::filter)) {
-      filter = std::make_shared<Filter>(log_tag, tags::schema::filter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::gate)) {
-      filter = std::make_shared<Gate>(log_tag, tags::schema::gate::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::level_meter)) {
-      filter = std::make_shared<LevelMeter>(log_tag, tags::schema::level_meter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::limiter)) {
-      filter = std::make_shared<Limiter>(log_tag, tags::schema::limiter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::loudness)) {
-      filter = std::make_shared<Loudness>(log_tag, tags::schema::loudness::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::maximizer)) {
-      filter = std::make_shared<Maximizer>(log_tag, tags::schema::maximizer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::multiband_compressor)) {
-      filter = std::make_shared<MultibandCompressor>(log_tag, tags::schema::multiband_compressor::id, path, pm,
-                                                     pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::multiband_gate)) {
-      filter = std::make_shared<MultibandGate>(log_tag, tags::schema::multiband_gate::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::pitch)) {
-      filter = std::make_shared<Pitch>(log_tag, tags::schema::pitch::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::reverb)) {
-      filter = std::make_shared<Reverb>(log_tag, tags::schema::reverb::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::rnnoise)) {
-      filter = std::make_shared<RNNoise>(log_tag, tags::schema::rnnoise::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::speex)) {
-      filter = std::make_shared<Speex>(log_tag, tags::schema::speex::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::stereo_tools)) {
-      filter = std::make_shared<StereoTools>(log_tag, tags::schema::stereo_tools::id, path, pm, pipeline_type);
+    filter->create_pw_filter();
+
+    // plugins added while the pipeline is suspended release their expensive state like the others did
+
+    if (suspended) {
+      filter->suspend();
     }
 
-    connections.push_back(filter->latency.connect([this]() { broadcast_pipeline_latency(); }));
+    connections.push_back(filter->latency.connect([this]() {
+      update_delay_compensation();
 
-    plugins.insert(std::make_pair(name, filter));
+      broadcast_pipeline_latency();
+    }));
+
+    plugins.insert(std::make_pair(new_names[n], filter));
   }
 }
 
@@ -282,24 +401,120 @@ void EffectsBase::remove_unused_filters() {
 }
 
 void EffectsBase::activate_filters() {
-  for (auto& plugin : plugins | std::views::values) {
-    plugin->set_active(true);
+  pm->lock();
+
+  for (const auto& plugin : plugins | std::views::values) {
+    if (plugin->connected_to_pw) {
+      plugin->set_active(true);
+    }
   }
+
+  const std::array<std::shared_ptr<PluginBase>, 2U> meters = {spectrum, output_level};
+
+  for (const auto& plugin : meters) {
+    if (plugin->connected_to_pw) {
+      plugin->set_active(true);
+    }
+  }
+
+  pm->sync_wait_unlock();
 }
 
 void EffectsBase::deactivate_filters() {
-  for (auto& plugin : plugins | std::views::values) {
-    plugin->set_active(false);
+  pm->lock();
+
+  for (const auto& plugin : plugins | std::views::values) {
+    if (plugin->connected_to_pw) {
+      plugin->set_active(false);
+    }
   }
+
+  const std::array<std::shared_ptr<PluginBase>, 2U> meters = {spectrum, output_level};
+
+  for (const auto& plugin : meters) {
+    if (plugin->connected_to_pw) {
+      plugin->set_active(false);
+    }
+  }
+
+  pm->sync_wait_unlock();
+}
+
+void EffectsBase::update_idle_state() {
+  if (apps_want_to_play()) {
+    if (idle_source_id != 0U) {
+      g_source_remove(idle_source_id);
+
+      idle_source_id = 0U;
+    }
+
+    if (suspended) {
+      resume_filters();
+    }
+
+    return;
+  }
+
+  if (suspended || idle_source_id != 0U || g_settings_get_boolean(global_settings, "idle-suspend-enable") == 0) {
+    return;
+  }
+
+  // the streams are checked again when the timeout expires, so short pauses do not suspend anything
+
+  const auto timeout = std::max(g_settings_get_int(global_settings, "idle-suspend-timeout"), 1);
+
+  idle_source_id = g_timeout_add_seconds(
+      static_cast<guint>(timeout), GSourceFunc(+[](EffectsBase* self) {
+        self->idle_source_id = 0U;
+
+        const auto enabled = g_settings_get_boolean(self->global_settings, "idle-suspend-enable") != 0;
+
+        if (enabled && !self->apps_want_to_play()) {
+          self->suspend_filters();
+        }
+
+        return G_SOURCE_REMOVE;
+      }),
+      this);
+}
+
+void EffectsBase::suspend_filters() {
+  util::debug(log_tag + "no stream is connected. Suspending the filters.");
+
+  suspended = true;
+
+  deactivate_filters();
+
+  for (const auto& plugin : plugins | std::views::values) {
+    plugin->suspend();
+  }
+}
+
+void EffectsBase::resume_filters() {
+  util::debug(log_tag + "a stream was connected. Resuming the filters.");
+
+  suspended = false;
+
+  for (const auto& plugin : plugins | std::views::values) {
+    plugin->resume();
+  }
+
+  activate_filters();
 }
 
 auto EffectsBase::get_pipeline_latency() -> float {
   float total = 0.0F;
 
-  for (const auto& name : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"))) {
-    if (plugins.contains(name)) {
-      total += plugins[name]->get_latency_seconds();
+  // the branches of a stage are aligned to the slowest one
+
+  for (const auto& stage : get_stages(util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins")))) {
+    float stage_latency = 0.0F;
+
+    for (const auto& name : stage) {
+      stage_latency = std::max(stage_latency, plugins[name]->get_latency_seconds());
     }
+
+    total += stage_latency;
   }
 
   return total * 1000.0F;
@@ -313,6 +528,106 @@ void EffectsBase::broadcast_pipeline_latency() {
   pipeline_latency.emit(latency_value);
 }
 
+void EffectsBase::log_link_timing(const std::string& operation,
+                                  const std::chrono::steady_clock::time_point& start,
+                                  const size_t& n_links) {
+  const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  util::debug(log_tag + "link timing: " + operation + " links=" + util::to_string(n_links) +
+              " ms=" + util::to_string(elapsed));
+}
+
+auto EffectsBase::get_stages(const std::vector<std::string>& list) -> std::vector<std::vector<std::string>> {
+  const auto parallel = util::gchar_array_to_vector(g_settings_get_strv(settings, "parallel-plugins"));
+
+  std::vector<std::vector<std::string>> stages;
+
+  for (const auto& name : list) {
+    if (!plugins.contains(name)) {
+      continue;
+    }
+
+    if (stages.empty() || std::ranges::find(parallel, name) == parallel.end()) {
+      stages.emplace_back();
+    }
+
+    stages.back().push_back(name);
+  }
+
+  return stages;
+}
+
+void EffectsBase::assign_metering_taps() {
+  for (const auto& [name, plugin] : plugins) {
+    if (!is_linked(linked_stages, name)) {
+      plugin->set_metering_taps(nullptr, nullptr);
+    }
+  }
+
+  auto previous = metering_bus->get_tap(MeteringBus::source_tap);
+
+  for (size_t n = 0U; n < linked_stages.size(); n++) {
+    const auto& stage = linked_stages[n];
+
+    // The output of a parallel stage is the mix made by PipeWire. It is measured by the plugins that read it.
+
+    auto mix = (stage.size() > 1U) ? metering_bus->get_tap("mix-" + util::to_string(n)) : nullptr;
+
+    for (const auto& name : stage) {
+      // level meters copy their input to the output, so both sides of them are the same tap
+
+      auto output = name.starts_with(tags::plugin_name::level_meter) ? previous : metering_bus->get_tap(name);
+
+      plugins[name]->set_metering_taps(previous, output);
+
+      if (mix == nullptr) {
+        mix = output;
+      }
+    }
+
+    previous = mix;
+  }
+
+  // spectrum and output level do not change the signal either
+
+  spectrum->set_metering_taps(previous, previous);
+  output_level->set_metering_taps(previous, previous);
+}
+
+void EffectsBase::update_delay_compensation() {
+  for (const auto& [name, plugin] : plugins) {
+    if (!is_linked(linked_stages, name)) {
+      plugin->set_compensation_delay(0.0F);
+    }
+  }
+
+  for (const auto& stage : linked_stages) {
+    float stage_latency = 0.0F;
+
+    for (const auto& name : stage) {
+      stage_latency = std::max(stage_latency, plugins[name]->get_latency_seconds());
+    }
+
+    for (const auto& name : stage) {
+      plugins[name]->set_compensation_delay(stage_latency - plugins[name]->get_latency_seconds());
+    }
+  }
+}
+
+void EffectsBase::update_branch_gains() {
+  for (const auto& [name, plugin] : plugins) {
+    if (!is_linked(linked_stages, name)) {
+      plugin->set_branch_gain(1.0F);
+    }
+  }
+
+  for (const auto& stage : linked_stages) {
+    for (const auto& name : stage) {
+      plugins[name]->set_branch_gain(1.0F / static_cast<float>(stage.size()));
+    }
+  }
+}
+
 auto EffectsBase::get_plugins_map() -> std::map<std::string, std::shared_ptr<PluginBase>> {
   return plugins;
 }
@@ -34,6 +34,7 @@
 #include <sigc++/connection.h>
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include "application.hpp"
 #include "apps_box.hpp"
@@ -68,6 +69,8 @@ struct Data {
 
   uint spectrum_rate, spectrum_n_bands;
 
+  uint64_t global_output_level_serial = 0U;
+
   float global_output_level_left, global_output_level_right, pipeline_latency_ms;
 
   std::vector<double> spectrum_mag, spectrum_x_axis, spectrum_freqs;
@@ -294,6 +297,38 @@ void on_listen_mic_toggled(EffectsBox* self, GtkToggleButton* button) {
   self->data->application->sie->set_listen_to_mic(gtk_toggle_button_get_active(button) != 0);
 }
 
+static gboolean global_output_level_update(GtkWidget* widget, GdkFrameClock* frame_clock, EffectsBox* self) {
+  if (!schedule_signal_idle) {
+    return G_SOURCE_CONTINUE;
+  }
+
+  const auto& output_level = self->data->effects_base->output_level;
+
+  // Nothing to redraw until the next level event
+  if (output_level->get_levels_serial() == self->data->global_output_level_serial) {
+    return G_SOURCE_CONTINUE;
+  }
+
+  self->data->global_output_level_serial = output_level->get_levels_serial();
+
+  const auto levels = output_level->get_levels();
+
+  self->data->global_output_level_left = levels[2];
+  self->data->global_output_level_right = levels[3];
+
+  gtk_label_set_text(self->label_global_output_level_left,
+                     fmt::format("{0:.0f}", self->data->global_output_level_left).c_str());
+
+  gtk_label_set_text(self->label_global_output_level_right,
+                     fmt::format("{0:.0f}", self->data->global_output_level_right).c_str());
+
+  gtk_widget_set_opacity(
+      GTK_WIDGET(self->saturation_icon),
+      (self->data->global_output_level_left > 0.0 || self->data->global_output_level_right > 0.0) ? 1.0 : 0.0);
+
+  return G_SOURCE_CONTINUE;
+}
+
 static gboolean spectrum_data_update(GtkWidget* widget, GdkFrameClock* frame_clock, EffectsBox* self) {
   if (!ui::chart::get_is_visible(self->spectrum_chart)) {
     return G_SOURCE_CONTINUE;
@@ -411,37 +446,8 @@ void setup(EffectsBox* self, app::Application* application, PipelineType pipelin
 
   // output level
 
-  self->data->connections.push_back(
-      self->data->effects_base->output_level->output_level.connect([=](const float left, const float right) {
-        self->data->global_output_level_left = left;
-        self->data->global_output_level_right = right;
-
-        if (!schedule_signal_idle) {
-          return;
-        }
-
-        g_idle_add((GSourceFunc) +
-                       [](EffectsBox* self) {
-                         if (!schedule_signal_idle) {
-                           return G_SOURCE_REMOVE;
-                         }
-
-                         gtk_label_set_text(self->label_global_output_level_left,
-                                            fmt::format("{0:.0f}", self->data->global_output_level_left).c_str());
-
-                         gtk_label_set_text(self->label_global_output_level_right,
-                                            fmt::format("{0:.0f}", self->data->global_output_level_right).c_str());
-
-                         gtk_widget_set_opacity(
-                             GTK_WIDGET(self->saturation_icon),
-                             (self->data->global_output_level_left > 0.0 || self->data->global_output_level_right > 0.0)
-                                 ? 1.0
-                                 : 0.0);
-
-                         return G_SOURCE_REMOVE;
-                       },
-                   self);
-      }));
+  gtk_widget_add_tick_callback(GTK_WIDGET(self->label_global_output_level_left),
+                               (GtkTickCallback)global_output_level_update, self, NULL);
 
   // spectrum array
 
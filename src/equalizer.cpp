@@ -23,21 +23,46 @@
 #include <glib.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <charconv>
 #include <map>
 #include <memory>
 #include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include "lv2_wrapper.hpp"
+#include "parametric_eq.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
+#include "settings_store.hpp"
 #include "tags_equalizer.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
 
 using namespace std::string_literals;
 
+namespace {
+
+// Index of keys like band12-gain. Returns -1 for the keys that do not belong to a band.
+auto band_index_from_key(std::string_view key) -> int {
+  if (!key.starts_with("band")) {
+    return -1;
+  }
+
+  key.remove_prefix(4U);
+
+  int index = -1;
+
+  if (auto [ptr, ec] = std::from_chars(key.data(), key.data() + key.size(), index); ec != std::errc()) {
+    return -1;
+  }
+
+  return index;
+}
+
+}  // namespace
+
 Equalizer::Equalizer(const std::string& tag,
                      const std::string& schema,
                      const std::string& schema_path,
@@ -53,14 +78,21 @@ Equalizer::Equalizer(const std::string& tag,
                  schema_path,
                  pipe_manager,
                  pipe_type),
-      settings_left(g_settings_new_with_path(schema_channel.c_str(), schema_channel_left_path.c_str())),
-      settings_right(g_settings_new_with_path(schema_channel.c_str(), schema_channel_right_path.c_str())) {
+      settings_left(settings_store::get(schema_channel.c_str(), schema_channel_left_path.c_str())),
+      settings_right(settings_store::get(schema_channel.c_str(), schema_channel_right_path.c_str())) {
   lv2_wrapper = std::make_unique<lv2::Lv2Wrapper>("http://lsp-plug.in/plugins/lv2/para_equalizer_x32_lr");
 
-  package_installed = lv2_wrapper->found_plugin;
+  // The native engine is used when the LSP plugin is missing, so the equalizer is always available
+
+  package_installed = true;
+
+  // the native engine only depends on the rate
 
-  if (!package_installed) {
-    util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/para_equalizer_x32_lr is not installed");
+  quantum_needs_setup = false;
+
+  if (!lv2_wrapper->found_plugin) {
+    util::debug(log_tag +
+                "http://lsp-plug.in/plugins/lv2/para_equalizer_x32_lr is not installed. Using the native engine.");
   }
 
   lv2_wrapper->bind_key_enum<"mode", "mode">(settings);
@@ -102,6 +134,47 @@ Equalizer::Equalizer(const std::string& tag,
       settings, "changed::split-channels",
       G_CALLBACK(+[](GSettings* settings, char* key, Equalizer* self) { self->on_split_channels(); }), this));
 
+  // native engine
+
+  for (uint n = 0U; n < max_bands; n++) {
+    update_native_band(0U, n);
+    update_native_band(1U, n);
+  }
+
+  update_native_engine();
+
+  native_eq->commit();
+
+  gconnections_left.push_back(g_signal_connect(settings_left, "changed",
+                                               G_CALLBACK(+[](GSettings* settings, char* key, Equalizer* self) {
+                                                 if (const auto n = band_index_from_key(key); n >= 0) {
+                                                   self->update_native_band(0U, static_cast<uint>(n));
+
+                                                   self->schedule_native_commit();
+                                                 }
+                                               }),
+                                               this));
+
+  gconnections_right.push_back(g_signal_connect(settings_right, "changed",
+                                                G_CALLBACK(+[](GSettings* settings, char* key, Equalizer* self) {
+                                                  if (const auto n = band_index_from_key(key); n >= 0) {
+                                                    self->update_native_band(1U, static_cast<uint>(n));
+
+                                                    self->schedule_native_commit();
+                                                  }
+                                                }),
+                                                this));
+
+  for (const auto* signal : {"changed::engine", "changed::balance", "changed::pitch-left", "changed::pitch-right"}) {
+    gconnections.push_back(g_signal_connect(settings, signal,
+                                            G_CALLBACK(+[](GSettings* settings, char* key, Equalizer* self) {
+                                              self->update_native_engine();
+
+                                              self->schedule_native_commit();
+                                            }),
+                                            this));
+  }
+
   setup_input_output_gain();
 }
 
@@ -116,6 +189,18 @@ Equalizer::~Equalizer() {
 
   this->gconnections_unified.clear();
 
+  for (auto& handler_id : gconnections_left) {
+    g_signal_handler_disconnect(settings_left, handler_id);
+  }
+
+  for (auto& handler_id : gconnections_right) {
+    g_signal_handler_disconnect(settings_right, handler_id);
+  }
+
+  if (native_commit_source_id != 0U) {
+    g_source_remove(native_commit_source_id);
+  }
+
   util::debug(log_tag + name + " destroyed");
 }
 
@@ -226,7 +311,59 @@ void Equalizer::on_split_channels() {
   }
 }
 
+void Equalizer::update_native_band(const uint& channel, const uint& index) {
+  if (index >= max_bands) {
+    return;
+  }
+
+  auto* channel_settings = (channel == 0U) ? settings_left : settings_right;
+
+  using namespace tags::equalizer;
+
+  native_eq->set_band(
+      channel, index,
+      {.type = static_cast<ParametricEq::Type>(g_settings_get_enum(channel_settings, band_type[index].data())),
+       .mode = static_cast<ParametricEq::Mode>(g_settings_get_enum(channel_settings, band_mode[index].data())),
+       .slope = static_cast<uint>(g_settings_get_enum(channel_settings, band_slope[index].data())),
+       .frequency = g_settings_get_double(channel_settings, band_frequency[index].data()),
+       .gain = g_settings_get_double(channel_settings, band_gain[index].data()),
+       .q = g_settings_get_double(channel_settings, band_q[index].data()),
+       .solo = g_settings_get_boolean(channel_settings, band_solo[index].data()) != 0,
+       .mute = g_settings_get_boolean(channel_settings, band_mute[index].data()) != 0});
+}
+
+void Equalizer::update_native_engine() {
+  native_eq->set_balance(g_settings_get_double(settings, "balance"));
+
+  native_eq->set_pitch(0U, g_settings_get_double(settings, "pitch-left"));
+  native_eq->set_pitch(1U, g_settings_get_double(settings, "pitch-right"));
+
+  use_native_engine = !lv2_wrapper->found_plugin || g_settings_get_enum(settings, "engine") == 1;
+}
+
+void Equalizer::schedule_native_commit() {
+  if (native_commit_source_id != 0U) {
+    return;
+  }
+
+  native_commit_source_id = g_idle_add(
+      +[](gpointer user_data) {
+        auto* self = static_cast<Equalizer*>(user_data);
+
+        self->native_commit_source_id = 0U;
+
+        self->native_eq->commit();
+
+        return G_SOURCE_REMOVE;
+      },
+      this);
+}
+
 void Equalizer::setup() {
+  native_eq->set_rate(rate);
+
+  native_eq->commit();
+
   if (!lv2_wrapper->found_plugin) {
     return;
   }
@@ -242,7 +379,9 @@ void Equalizer::process(std::span<float>& left_in,
                         std::span<float>& right_in,
                         std::span<float>& left_out,
                         std::span<float>& right_out) {
-  if (!lv2_wrapper->found_plugin || !lv2_wrapper->has_instance() || bypass) {
+  const bool native = use_native_engine;
+
+  if (bypass || (!native && (!lv2_wrapper->found_plugin || !lv2_wrapper->has_instance()))) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -253,33 +392,29 @@ void Equalizer::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  lv2_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
-  lv2_wrapper->run();
+  if (native) {
+    native_eq->process(left_in, right_in, left_out, right_out);
+  } else {
+    lv2_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
+    lv2_wrapper->run();
+  }
 
   if (output_gain != 1.0F) {
     apply_gain(left_out, right_out, output_gain);
   }
 
   /*
-    This plugin gives the latency in number of samples
+    The LSP plugin gives the latency in number of samples. The native engine has none.
   */
 
-  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value("out_latency"));
+  const auto lv = native ? 0U : static_cast<uint>(lv2_wrapper->get_control_port_value("out_latency"));
 
   if (latency_n_frames != lv) {
     latency_n_frames = lv;
 
     latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
   }
@@ -24,6 +24,7 @@
 #include <nlohmann/json_fwd.hpp>
 #include "plugin_preset_base.hpp"
 #include "preset_type.hpp"
+#include "settings_store.hpp"
 #include "tags_equalizer.hpp"
 #include "tags_plugin_name.hpp"
 #include "tags_schema.hpp"
@@ -37,19 +38,19 @@ EqualizerPreset::EqualizerPreset(PresetType preset_type, const int& index)
                        tags::schema::equalizer::output_path,
                        preset_type,
                        index) {
-  input_settings_left = g_settings_new_with_path(
+  input_settings_left = settings_store::get(
       tags::schema::equalizer::channel_id,
       (tags::schema::equalizer::input_path + util::to_string(index) + "/leftchannel/").c_str());
 
-  input_settings_right = g_settings_new_with_path(
+  input_settings_right = settings_store::get(
       tags::schema::equalizer::channel_id,
       (tags::schema::equalizer::input_path + util::to_string(index) + "/rightchannel/").c_str());
 
-  output_settings_left = g_settings_new_with_path(
+  output_settings_left = settings_store::get(
       tags::schema::equalizer::channel_id,
       (tags::schema::equalizer::output_path + util::to_string(index) + "/leftchannel/").c_str());
 
-  output_settings_right = g_settings_new_with_path(
+  output_settings_right = settings_store::get(
       tags::schema::equalizer::channel_id,
       (tags::schema::equalizer::output_path + util::to_string(index) + "/rightchannel/").c_str());
 
@@ -72,6 +73,8 @@ void EqualizerPreset::save(nlohmann::json& json) {
 
   json[section][instance_name]["mode"] = util::gsettings_get_string(settings, "mode");
 
+  json[section][instance_name]["engine"] = util::gsettings_get_string(settings, "engine");
+
   json[section][instance_name]["split-channels"] = g_settings_get_boolean(settings, "split-channels") != 0;
 
   json[section][instance_name]["balance"] = g_settings_get_double(settings, "balance");
@@ -126,6 +129,8 @@ void EqualizerPreset::load(const nlohmann::json& json) {
 
   update_key<gchar*>(json.at(section).at(instance_name), settings, "mode", "mode");
 
+  update_key<gchar*>(json.at(section).at(instance_name), settings, "engine", "engine");
+
   update_key<int>(json.at(section).at(instance_name), settings, "num-bands", "num-bands");
 
   update_key<bool>(json.at(section).at(instance_name), settings, "split-channels", "split-channels");
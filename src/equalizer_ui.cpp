@@ -46,6 +46,8 @@
 #include "application.hpp"
 #include "equalizer.hpp"
 #include "equalizer_band_box.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_equalizer.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -113,7 +115,7 @@ struct _EqualizerBox {
 
   GtkSpinButton *nbands, *balance, *pitch_left, *pitch_right;
 
-  GtkDropDown* mode;
+  GtkDropDown *mode, *engine;
 
   GtkToggleButton *split_channels, *show_native_ui;
 
@@ -1009,13 +1011,13 @@ void setup(EqualizerBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::equalizer::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::equalizer::id, schema_path.c_str());
 
   self->settings_left =
-      g_settings_new_with_path(tags::schema::equalizer::channel_id, (schema_path + "leftchannel/").c_str());
+      settings_store::get(tags::schema::equalizer::channel_id, (schema_path + "leftchannel/").c_str());
 
   self->settings_right =
-      g_settings_new_with_path(tags::schema::equalizer::channel_id, (schema_path + "rightchannel/").c_str());
+      settings_store::get(tags::schema::equalizer::channel_id, (schema_path + "rightchannel/").c_str());
 
   equalizer->set_post_messages(true);
 
@@ -1024,35 +1026,11 @@ void setup(EqualizerBox* self,
 
   build_all_bands(self);
 
-  self->data->connections.push_back(equalizer->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(equalizer->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), equalizer,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   gtk_label_set_text(self->plugin_credit, ui::get_plugin_credit_translated(self->data->equalizer->package).c_str());
 
@@ -1065,6 +1043,8 @@ void setup(EqualizerBox* self,
 
   ui::gsettings_bind_enum_to_combo_widget(self->settings, "mode", self->mode);
 
+  ui::gsettings_bind_enum_to_combo_widget(self->settings, "engine", self->engine);
+
   g_settings_bind(self->settings, "balance", gtk_spin_button_get_adjustment(self->balance), "value",
                   G_SETTINGS_BIND_DEFAULT);
 
@@ -1095,6 +1075,8 @@ void dispose(GObject* object) {
 
   self->data->equalizer->close_native_ui();
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -1156,6 +1138,7 @@ void equalizer_box_class_init(EqualizerBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, string_list_right);
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, nbands);
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, mode);
+  gtk_widget_class_bind_template_child(widget_class, EqualizerBox, engine);
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, split_channels);
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, balance);
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, pitch_left);
@@ -44,6 +44,8 @@ Exciter::Exciter(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://calf.sourceforge.net/plugins/Exciter is not installed");
   }
@@ -119,13 +121,23 @@ void Exciter::process(std::span<float>& left_in,
         return;
       }
 
-      harmonics.emit(harmonics_port_value);
+      post_meters({harmonics_port_value});
 
       notify();
     }
   }
 }
 
+void Exciter::reset_meters() {
+  harmonics_port_value = 0.0;
+
+  post_meters({harmonics_port_value});
+}
+
+void Exciter::emit_meters(const MeterValues& values) {
+  harmonics.emit(values[0U]);
+}
+
 auto Exciter::get_latency_seconds() -> float {
   return 0.0F;
 }
@@ -31,6 +31,8 @@
 #include <string>
 #include <vector>
 #include "exciter.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -94,39 +96,15 @@ void setup(ExciterBox* self, std::shared_ptr<Exciter> exciter, const std::string
 
   self->data->exciter = exciter;
 
-  self->settings = g_settings_new_with_path(tags::schema::exciter::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::exciter::id, schema_path.c_str());
 
   exciter->set_post_messages(true);
 
-  self->data->connections.push_back(exciter->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(exciter->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), exciter,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   self->data->connections.push_back(exciter->harmonics.connect([=](const double value) {
     g_object_ref(self);
@@ -168,6 +146,8 @@ void setup(ExciterBox* self, std::shared_ptr<Exciter> exciter, const std::string
 void dispose(GObject* object) {
   auto* self = EE_EXCITER_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -35,9 +35,11 @@
 #include <string>
 #include <vector>
 #include "expander.hpp"
+#include "meters_aggregator.hpp"
 #include "node_info_holder.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "settings_store.hpp"
 #include "tags_pipewire.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -137,7 +139,7 @@ void setup(ExpanderBox* self, std::shared_ptr<Expander> expander, const std::str
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::expander::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::expander::id, schema_path.c_str());
 
   expander->set_post_messages(true);
 
@@ -159,35 +161,11 @@ void setup(ExpanderBox* self, std::shared_ptr<Expander> expander, const std::str
     }
   }
 
-  self->data->connections.push_back(expander->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(expander->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), expander,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   self->data->connections.push_back(expander->reduction.connect([=](const float value) {
     g_object_ref(self);
@@ -376,6 +354,8 @@ void dispose(GObject* object) {
 
   self->data->expander->close_native_ui();
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
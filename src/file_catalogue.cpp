@@ -0,0 +1,267 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "file_catalogue.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#include "util.hpp"
+
+namespace file_catalogue {
+
+namespace {
+
+struct Directory {
+  std::filesystem::path path;
+
+  std::filesystem::file_time_type mtime;
+};
+
+struct Tree {
+  bool valid = false;
+
+  bool monitored = true;
+
+  std::vector<std::filesystem::path> files;  // relative to the root, in the order they were found
+
+  std::unordered_map<std::string, std::string> first_by_name;  // file name -> full path of its first occurrence
+
+  std::vector<Directory> directories;
+
+  std::vector<GFileMonitor*> monitors;
+};
+
+std::mutex catalogue_mutex;
+
+std::map<std::string, std::unique_ptr<Tree>> trees;  // indexed by root and depth
+
+/*
+  The monitors deliver their events in the main loop, while the lookups may happen in other threads. The handler
+  holds a copy of the tree key instead of a pointer because the tree may have been erased in the meantime.
+*/
+
+void on_monitor_changed(GFileMonitor* monitor,
+                        GFile* file,
+                        GFile* other_file,
+                        GFileMonitorEvent event_type,
+                        std::string* key) {
+  std::scoped_lock<std::mutex> lock(catalogue_mutex);
+
+  if (auto it = trees.find(*key); it != trees.end()) {
+    it->second->valid = false;
+  }
+}
+
+void release_monitors(Tree& tree) {
+  for (auto* monitor : tree.monitors) {
+    g_signal_handlers_disconnect_matched(monitor, G_SIGNAL_MATCH_FUNC, 0U, 0U, nullptr,
+                                         reinterpret_cast<gpointer>(on_monitor_changed), nullptr);
+
+    g_file_monitor_cancel(monitor);
+
+    g_object_unref(monitor);
+  }
+
+  tree.monitors.clear();
+}
+
+// The files of a directory are indexed before its subdirectories, like util::search_filename does
+
+void walk(Tree& tree,
+          const std::filesystem::path& root,
+          const std::filesystem::path& dir,
+          const uint& level,
+          const uint& max_depth) {
+  std::error_code ec;
+
+  tree.directories.push_back({.path = dir, .mtime = std::filesystem::last_write_time(dir, ec)});
+
+  std::vector<std::filesystem::path> subdirs;
+
+  try {
+    for (const auto& entry : std::filesystem::directory_iterator{dir}) {
+      if (entry.is_regular_file(ec)) {
+        tree.files.push_back(entry.path().lexically_relative(root));
+
+        tree.first_by_name.try_emplace(entry.path().filename().string(), entry.path().string());
+      } else if (level + 1U < max_depth && entry.is_directory(ec)) {
+        subdirs.push_back(entry.path());
+      }
+    }
+  } catch (const std::exception& e) {
+    util::warning(e.what());
+  }
+
+  for (const auto& subdir : subdirs) {
+    walk(tree, root, subdir, level + 1U, max_depth);
+  }
+}
+
+auto has_changed(const Tree& tree) -> bool {
+  std::error_code ec;
+
+  for (const auto& dir : tree.directories) {
+    if (std::filesystem::last_write_time(dir.path, ec) != dir.mtime) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void scan(Tree& tree, const std::string& key, const std::filesystem::path& root, const uint& max_depth) {
+  release_monitors(tree);
+
+  tree.files.clear();
+  tree.first_by_name.clear();
+  tree.directories.clear();
+
+  tree.monitored = true;
+
+  // a change made while we are walking marks the tree as invalid again
+
+  tree.valid = true;
+
+  walk(tree, root, root, 0U, max_depth);
+
+  for (const auto& dir : tree.directories) {
+    auto* gfile = g_file_new_for_path(dir.path.c_str());
+
+    auto* monitor = g_file_monitor_directory(gfile, G_FILE_MONITOR_NONE, nullptr, nullptr);
+
+    g_object_unref(gfile);
+
+    if (monitor == nullptr) {
+      tree.monitored = false;
+
+      continue;
+    }
+
+    g_signal_connect_data(monitor, "changed", G_CALLBACK(on_monitor_changed), new std::string(key),
+                          GClosureNotify(+[](std::string* data, GClosure* closure) { delete data; }),
+                          static_cast<GConnectFlags>(0));
+
+    tree.monitors.push_back(monitor);
+  }
+
+  /*
+    The monitors only exist after the walk. A directory that changed in between is caught by its modification time,
+    and the next lookup scans the tree again.
+  */
+
+  if (has_changed(tree)) {
+    tree.valid = false;
+  }
+
+  util::debug("indexed " + util::to_string(tree.files.size()) + " files in " + root.string());
+}
+
+auto get_tree(const std::filesystem::path& root, const uint& max_depth) -> Tree* {
+  const auto key = root.string() + ":" + util::to_string(max_depth);
+
+  std::error_code ec;
+
+  if (!std::filesystem::is_directory(root, ec)) {
+    if (auto it = trees.find(key); it != trees.end()) {
+      release_monitors(*it->second);
+
+      trees.erase(it);
+    }
+
+    return nullptr;
+  }
+
+  auto& tree = trees[key];
+
+  if (tree == nullptr) {
+    tree = std::make_unique<Tree>();
+  }
+
+  if (tree->valid && !tree->monitored && has_changed(*tree)) {
+    tree->valid = false;
+  }
+
+  if (!tree->valid) {
+    scan(*tree, key, root, max_depth);
+  }
+
+  return tree.get();
+}
+
+}  // namespace
+
+auto find(const std::filesystem::path& root, const std::string& filename, const uint& max_depth) -> std::string {
+  std::scoped_lock<std::mutex> lock(catalogue_mutex);
+
+  const auto* tree = get_tree(root, max_depth);
+
+  if (tree == nullptr) {
+    return "";
+  }
+
+  if (auto it = tree->first_by_name.find(filename); it != tree->first_by_name.end()) {
+    return it->second;
+  }
+
+  return "";
+}
+
+auto list(const std::filesystem::path& root, const std::string& extension, const uint& max_depth)
+    -> std::vector<std::filesystem::path> {
+  std::scoped_lock<std::mutex> lock(catalogue_mutex);
+
+  std::vector<std::filesystem::path> output;
+
+  const auto* tree = get_tree(root, max_depth);
+
+  if (tree == nullptr) {
+    return output;
+  }
+
+  for (const auto& file : tree->files) {
+    if (file.extension() == extension) {
+      output.push_back(file);
+    }
+  }
+
+  return output;
+}
+
+void clear() {
+  std::scoped_lock<std::mutex> lock(catalogue_mutex);
+
+  for (auto& tree : trees | std::views::values) {
+    release_monitors(*tree);
+  }
+
+  trees.clear();
+}
+
+}  // namespace file_catalogue
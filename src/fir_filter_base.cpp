@@ -18,7 +18,6 @@
  */
 
 #include "fir_filter_base.hpp"
-#include <sched.h>
 #include <sys/types.h>
 #include <zita-convolver.h>
 #include <algorithm>
@@ -28,16 +27,9 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include "dsp_threads.hpp"
 #include "util.hpp"
 
-namespace {
-
-constexpr auto CONVPROC_SCHEDULER_PRIORITY = 0;
-
-constexpr auto CONVPROC_SCHEDULER_CLASS = SCHED_FIFO;
-
-}  // namespace
-
 FirFilterBase::FirFilterBase(std::string tag) : log_tag(std::move(tag)) {}
 
 FirFilterBase::~FirFilterBase() {
@@ -162,7 +154,8 @@ void FirFilterBase::setup_zita() {
 
   conv->set_options(0);
 
-  int ret = conv->configure(2, 2, kernel.size(), n_samples, n_samples, n_samples, 0.0F /*density*/);
+  int ret = conv->configure(2, 2, kernel.size(), n_samples, n_samples, dsp_threads::get_max_partition(n_samples),
+                           0.0F /*density*/);
 
   if (ret != 0) {
     util::warning(log_tag + "can't initialise zita-convolver engine: " + util::to_string(ret, ""));
@@ -186,7 +179,7 @@ void FirFilterBase::setup_zita() {
     return;
   }
 
-  ret = conv->start_process(CONVPROC_SCHEDULER_PRIORITY, CONVPROC_SCHEDULER_CLASS);
+  ret = dsp_threads::start(conv);
 
   if (ret != 0) {
     util::warning(log_tag + "start_process failed: " + util::to_string(ret, ""));
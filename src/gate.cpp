@@ -50,6 +50,8 @@ Gate::Gate(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/sc_gate_stereo is not installed");
   }
@@ -177,15 +179,7 @@ void Gate::process(std::span<float>& left_in,
 
     latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
   }
@@ -211,14 +205,9 @@ void Gate::process(std::span<float>& left_in,
       envelope_port_value =
           0.5F * (lv2_wrapper->get_control_port_value("elm_l") + lv2_wrapper->get_control_port_value("elm_r"));
 
-      attack_zone_start.emit(attack_zone_start_port_value);
-      attack_threshold.emit(attack_threshold_port_value);
-      release_zone_start.emit(release_zone_start_port_value);
-      release_threshold.emit(release_threshold_port_value);
-      reduction.emit(reduction_port_value);
-      sidechain.emit(sidechain_port_value);
-      curve.emit(curve_port_value);
-      envelope.emit(envelope_port_value);
+      post_meters({attack_zone_start_port_value, attack_threshold_port_value, release_zone_start_port_value,
+                   release_threshold_port_value, reduction_port_value, sidechain_port_value, curve_port_value,
+                   envelope_port_value});
 
       notify();
     }
@@ -226,6 +215,10 @@ void Gate::process(std::span<float>& left_in,
 }
 
 void Gate::update_sidechain_links(const std::string& key) {
+  if (pm == nullptr) {
+    return;
+  }
+
   if (util::gsettings_get_string(settings, "sidechain-input") != "External") {
     pm->destroy_links(list_proxies);
 
@@ -259,6 +252,30 @@ void Gate::update_probe_links() {
   update_sidechain_links("");
 }
 
+void Gate::reset_meters() {
+  // the zones depend only on the parameters and keep their last values
+
+  reduction_port_value = 1.0F;
+  sidechain_port_value = 0.0F;
+  curve_port_value = 0.0F;
+  envelope_port_value = 0.0F;
+
+  post_meters({attack_zone_start_port_value, attack_threshold_port_value, release_zone_start_port_value,
+               release_threshold_port_value, reduction_port_value, sidechain_port_value, curve_port_value,
+               envelope_port_value});
+}
+
+void Gate::emit_meters(const MeterValues& values) {
+  attack_zone_start.emit(static_cast<float>(values[0U]));
+  attack_threshold.emit(static_cast<float>(values[1U]));
+  release_zone_start.emit(static_cast<float>(values[2U]));
+  release_threshold.emit(static_cast<float>(values[3U]));
+  reduction.emit(static_cast<float>(values[4U]));
+  sidechain.emit(static_cast<float>(values[5U]));
+  curve.emit(static_cast<float>(values[6U]));
+  envelope.emit(static_cast<float>(values[7U]));
+}
+
 auto Gate::get_latency_seconds() -> float {
   return this->latency_value;
 }
@@ -0,0 +1,364 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gated_loudness.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+KWeighting::KWeighting(const uint& rate) {
+  set_rate(rate);
+}
+
+void KWeighting::set_rate(const uint& rate) {
+  this->rate = std::max(rate, 1U);
+
+  subblock_frames = std::max(this->rate / 10U, 1U);
+
+  // K-weighting filter coefficients as given by ITU BS.1770 for any sample rate
+
+  double f0 = 1681.974450955533;
+  double q = 0.7071752369554196;
+  double k = std::tan(std::numbers::pi * f0 / static_cast<double>(this->rate));
+
+  const double gain = 3.999843853973347;
+  const double vh = std::pow(10.0, gain / 20.0);
+  const double vb = std::pow(vh, 0.4996667741545416);
+
+  double a0 = 1.0 + k / q + k * k;
+
+  Biquad pre;
+
+  pre.b0 = (vh + vb * k / q + k * k) / a0;
+  pre.b1 = 2.0 * (k * k - vh) / a0;
+  pre.b2 = (vh - vb * k / q + k * k) / a0;
+  pre.a1 = 2.0 * (k * k - 1.0) / a0;
+  pre.a2 = (1.0 - k / q + k * k) / a0;
+
+  f0 = 38.13547087602444;
+  q = 0.5003270373238773;
+  k = std::tan(std::numbers::pi * f0 / static_cast<double>(this->rate));
+
+  a0 = 1.0 + k / q + k * k;
+
+  Biquad rlb;
+
+  rlb.b0 = 1.0;
+  rlb.b1 = -2.0;
+  rlb.b2 = 1.0;
+  rlb.a1 = 2.0 * (k * k - 1.0) / a0;
+  rlb.a2 = (1.0 - k / q + k * k) / a0;
+
+  pre_filter.fill(pre);
+  rlb_filter.fill(rlb);
+
+  reset();
+}
+
+void KWeighting::reset() {
+  for (auto& f : pre_filter) {
+    f.z1 = f.z2 = 0.0;
+  }
+
+  for (auto& f : rlb_filter) {
+    f.z1 = f.z2 = 0.0;
+  }
+
+  subblock_position = 0U;
+  subblock_energy = 0.0;
+}
+
+GatedLoudness::GatedLoudness(const uint& max_history_seconds) {
+  set_max_history(max_history_seconds);
+
+  reset();
+}
+
+void GatedLoudness::Histogram::add(const double& block_energy) {
+  const auto loudness = energy_to_loudness(block_energy);
+
+  if (loudness < min_loudness) {
+    return;  // absolute gate
+  }
+
+  const auto bin = loudness_to_bin(loudness);
+
+  count[bin]++;
+  energy[bin] += block_energy;
+
+  total_count++;
+  total_energy += block_energy;
+}
+
+void GatedLoudness::Histogram::remove(const double& block_energy) {
+  const auto loudness = energy_to_loudness(block_energy);
+
+  if (loudness < min_loudness) {
+    return;
+  }
+
+  const auto bin = loudness_to_bin(loudness);
+
+  count[bin]--;
+  energy[bin] -= block_energy;
+
+  total_count--;
+  total_energy -= block_energy;
+
+  // avoiding the accumulation of rounding errors in the sums
+
+  if (count[bin] == 0U) {
+    energy[bin] = 0.0;
+  }
+
+  if (total_count == 0U) {
+    total_energy = 0.0;
+  }
+}
+
+void GatedLoudness::Histogram::clear() {
+  count.fill(0U);
+  energy.fill(0.0);
+
+  total_count = 0U;
+  total_energy = 0.0;
+}
+
+void GatedLoudness::History::resize(const size_t& capacity, Histogram& histogram) {
+  // the blocks measured while the history was unlimited were not stored, so they could never leave the histogram
+
+  if (blocks.empty() && capacity != 0U) {
+    histogram.clear();
+  }
+
+  // dropping the oldest blocks that do not fit in the new capacity
+
+  while (capacity != 0U && size > capacity) {
+    histogram.remove(blocks[head]);
+
+    head = (head + 1U) % blocks.size();
+
+    size--;
+  }
+
+  std::vector<double> resized(capacity, 0.0);
+
+  for (size_t n = 0U; n < std::min(size, capacity); n++) {
+    resized[n] = blocks[(head + n) % blocks.size()];
+  }
+
+  blocks = std::move(resized);
+
+  head = 0U;
+  size = std::min(size, capacity);
+}
+
+void GatedLoudness::History::push(const double& block_energy, Histogram& histogram) {
+  histogram.add(block_energy);
+
+  if (blocks.empty()) {
+    return;  // unlimited history
+  }
+
+  if (size == blocks.size()) {
+    histogram.remove(blocks[head]);
+
+    head = (head + 1U) % blocks.size();
+
+    size--;
+  }
+
+  blocks[(head + size) % blocks.size()] = block_energy;
+
+  size++;
+}
+
+void GatedLoudness::set_max_history(const uint& seconds) {
+  max_history = (seconds == 0U) ? 0U : std::max(seconds, 3U);
+
+  // one gating block every 100 ms for the integrated loudness and one short-term block per second for the range
+
+  integrated_history.resize(static_cast<size_t>(max_history) * 10U, integrated_histogram);
+  range_history.resize(static_cast<size_t>(max_history), range_histogram);
+}
+
+void GatedLoudness::set_update_interval(const uint& milliseconds) {
+  update_interval = std::max((milliseconds + 50U) / 100U, 1U);
+}
+
+void GatedLoudness::reset() {
+  subblocks.fill(0.0);
+
+  subblock_index = 0U;
+  n_subblocks = 0U;
+  subblocks_since_shortterm_block = 0U;
+  subblocks_since_update = 0U;
+
+  integrated_histogram.clear();
+  range_histogram.clear();
+
+  integrated_history.head = integrated_history.size = 0U;
+  range_history.head = range_history.size = 0U;
+
+  momentary = -std::numeric_limits<double>::infinity();
+  shortterm = -std::numeric_limits<double>::infinity();
+  integrated = -std::numeric_limits<double>::infinity();
+  relative_threshold = min_loudness;
+  range = 0.0;
+}
+
+auto GatedLoudness::energy_to_loudness(const double& energy) -> double {
+  return -0.691 + 10.0 * std::log10(energy);
+}
+
+auto GatedLoudness::loudness_to_bin(const double& loudness) -> uint {
+  const auto bin = static_cast<int>((loudness - min_loudness) / bin_width);
+
+  return static_cast<uint>(std::clamp(bin, 0, static_cast<int>(n_bins) - 1));
+}
+
+auto GatedLoudness::bin_center(const uint& bin) -> double {
+  return min_loudness + (static_cast<double>(bin) + 0.5) * bin_width;
+}
+
+auto GatedLoudness::sum_subblocks(const uint& count) const -> double {
+  double sum = 0.0;
+
+  for (uint n = 1U; n <= count; n++) {
+    sum += subblocks[(subblock_index + shortterm_subblocks - n) % shortterm_subblocks];
+  }
+
+  return sum;
+}
+
+void GatedLoudness::add_subblock(const double& energy) {
+  subblocks[subblock_index] = energy;
+
+  subblock_index = (subblock_index + 1U) % shortterm_subblocks;
+
+  n_subblocks = std::min(n_subblocks + 1U, shortterm_subblocks);
+
+  // missing sub-blocks at the start count as silence, like in the other meters
+
+  const auto momentary_energy = sum_subblocks(momentary_subblocks) / momentary_subblocks;
+  const auto shortterm_energy = sum_subblocks(shortterm_subblocks) / shortterm_subblocks;
+
+  momentary = energy_to_loudness(momentary_energy);
+  shortterm = energy_to_loudness(shortterm_energy);
+
+  // 400 ms gating blocks with 75% of overlap
+
+  if (n_subblocks >= momentary_subblocks) {
+    integrated_history.push(momentary_energy, integrated_histogram);
+  }
+
+  if (n_subblocks == shortterm_subblocks && ++subblocks_since_shortterm_block >= shortterm_step_subblocks) {
+    subblocks_since_shortterm_block = 0U;
+
+    range_history.push(shortterm_energy, range_histogram);
+  }
+
+  if (++subblocks_since_update >= update_interval) {
+    subblocks_since_update = 0U;
+
+    update_gated_statistics();
+  }
+}
+
+void GatedLoudness::update_gated_statistics() {
+  // integrated loudness
+
+  if (integrated_histogram.total_count == 0U) {
+    integrated = -std::numeric_limits<double>::infinity();
+    relative_threshold = min_loudness;
+  } else {
+    relative_threshold =
+        energy_to_loudness(integrated_histogram.total_energy / static_cast<double>(integrated_histogram.total_count)) -
+        10.0;
+
+    uint64_t count = 0U;
+    double energy = 0.0;
+
+    for (uint bin = loudness_to_bin(relative_threshold); bin < n_bins; bin++) {
+      if (bin_center(bin) < relative_threshold) {
+        continue;
+      }
+
+      count += integrated_histogram.count[bin];
+      energy += integrated_histogram.energy[bin];
+    }
+
+    integrated = (count > 0U) ? energy_to_loudness(energy / static_cast<double>(count))
+                              : -std::numeric_limits<double>::infinity();
+  }
+
+  // loudness range from the 10% and 95% percentiles of the short-term values above the -20 LU relative gate
+
+  range = 0.0;
+
+  if (range_histogram.total_count == 0U) {
+    return;
+  }
+
+  const auto gate =
+      energy_to_loudness(range_histogram.total_energy / static_cast<double>(range_histogram.total_count)) - 20.0;
+
+  const auto first_bin = loudness_to_bin(gate) + ((bin_center(loudness_to_bin(gate)) < gate) ? 1U : 0U);
+
+  uint64_t n_gated = 0U;
+
+  for (uint bin = first_bin; bin < n_bins; bin++) {
+    n_gated += range_histogram.count[bin];
+  }
+
+  if (n_gated == 0U) {
+    return;
+  }
+
+  const auto low_index = static_cast<uint64_t>(0.1 * static_cast<double>(n_gated - 1U));
+  const auto high_index = static_cast<uint64_t>(0.95 * static_cast<double>(n_gated - 1U));
+
+  double low = 0.0;
+  double high = 0.0;
+
+  uint64_t cumulative = 0U;
+
+  for (uint bin = first_bin; bin < n_bins; bin++) {
+    const auto next = cumulative + range_histogram.count[bin];
+
+    if (cumulative <= low_index && low_index < next) {
+      low = bin_center(bin);
+    }
+
+    if (cumulative <= high_index && high_index < next) {
+      high = bin_center(bin);
+
+      break;
+    }
+
+    cumulative = next;
+  }
+
+  range = high - low;
+}
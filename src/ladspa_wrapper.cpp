@@ -398,6 +398,20 @@ auto LadspaWrapper::create_instance(uint rate) -> bool {
   return true;
 }
 
+void LadspaWrapper::destroy_instance() {
+  if (active) {
+    deactivate();
+  }
+
+  LADSPA_Handle instance = std::exchange(this->instance, nullptr);
+
+  if (instance != nullptr && descriptor->cleanup != nullptr) {
+    descriptor->cleanup(instance);
+  }
+
+  rate = 0U;
+}
+
 static inline int stricmp(const char* str1, const char* str2) {
   char c1 = 0;
   char c2 = 0;
@@ -18,12 +18,13 @@
  */
 
 #include "level_meter.hpp"
-#include <ebur128.h>
 #include <algorithm>
-#include <cstddef>
+#include <memory>
 #include <mutex>
 #include <span>
 #include <string>
+#include "gated_loudness.hpp"
+#include "metering_bus.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -36,82 +37,29 @@ LevelMeter::LevelMeter(const std::string& tag,
                        PipelineType pipe_type)
     : PluginBase(tag,
                  tags::plugin_name::level_meter,
-                 tags::plugin_package::ebur128,
+                 tags::plugin_package::ee,
                  schema,
                  schema_path,
                  pipe_manager,
-                 pipe_type) {}
+                 pipe_type) {
+  subscribe_input_metering(MeteringTap::Feature::loudness);
+  subscribe_input_metering(MeteringTap::Feature::true_peak);
 
-LevelMeter::~LevelMeter() {
-  if (connected_to_pw) {
-    disconnect_from_pw();
-  }
+  // the momentary and short term loudness have to fall when the input becomes silent
 
-  for (auto& t : mythreads) {
-    t.join();
-  }
-
-  mythreads.clear();
+  skip_silence = false;
 
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  quantum_needs_setup = false;
 
-  if (ebur_state != nullptr) {
-    ebur128_destroy(&ebur_state);
-  }
-
-  util::debug(log_tag + name + " destroyed");
+  reset_history();
 }
 
-auto LevelMeter::init_ebur128() -> bool {
-  if (n_samples == 0U || rate == 0U) {
-    return false;
-  }
-
-  if (ebur_state != nullptr) {
-    ebur128_destroy(&ebur_state);
-
-    ebur_state = nullptr;
-  }
-
-  ebur_state = ebur128_init(
-      2U, rate, EBUR128_MODE_S | EBUR128_MODE_I | EBUR128_MODE_LRA | EBUR128_MODE_TRUE_PEAK | EBUR128_MODE_HISTOGRAM);
-
-  ebur128_set_channel(ebur_state, 0U, EBUR128_LEFT);
-  ebur128_set_channel(ebur_state, 1U, EBUR128_RIGHT);
-
-  return ebur_state != nullptr;
-}
-
-void LevelMeter::setup() {
-  if (2U * static_cast<size_t>(n_samples) != data.size()) {
-    data.resize(static_cast<size_t>(n_samples) * 2U);
+LevelMeter::~LevelMeter() {
+  if (connected_to_pw) {
+    disconnect_from_pw();
   }
 
-  if (rate != old_rate) {
-    data_mutex.lock();
-
-    ebur128_ready = false;
-
-    data_mutex.unlock();
-
-    mythreads.emplace_back([this]() {  // Using emplace_back here makes sense
-      if (ebur128_ready) {
-        return;
-      }
-
-      auto status = true;
-
-      old_rate = rate;
-
-      status = init_ebur128();
-
-      data_mutex.lock();
-
-      ebur128_ready = status;
-
-      data_mutex.unlock();
-    });
-  }
+  util::debug(log_tag + name + " destroyed");
 }
 
 void LevelMeter::process(std::span<float>& left_in,
@@ -123,74 +71,59 @@ void LevelMeter::process(std::span<float>& left_in,
   std::copy(left_in.begin(), left_in.end(), left_out.begin());
   std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
-  if (bypass || !ebur128_ready) {
-    return;
-  }
-
-  for (size_t n = 0U; n < n_samples; n++) {
-    data[2U * n] = left_in[n];
-    data[2U * n + 1U] = right_in[n];
-  }
-
-  ebur128_add_frames_float(ebur_state, data.data(), n_samples);
+  auto* tap = get_input_tap();
 
-  if (EBUR128_SUCCESS != ebur128_loudness_momentary(ebur_state, &momentary)) {
-    momentary = 0.0;
+  if (bypass || tap == nullptr) {
+    return;
   }
 
-  if (EBUR128_SUCCESS != ebur128_loudness_shortterm(ebur_state, &shortterm)) {
-    shortterm = 0.0;
-  }
+  if (tap != last_tap) {
+    last_tap = tap;
 
-  if (EBUR128_SUCCESS != ebur128_loudness_global(ebur_state, &global)) {
-    global = 0.0;
+    next_subblock = tap->get_subblock_count();
   }
 
-  if (EBUR128_SUCCESS != ebur128_relative_threshold(ebur_state, &relative)) {
-    relative = 0.0;
-  }
+  tap->read_subblocks(next_subblock, [&](const double& energy) { meter->add_subblock(energy); });
 
-  if (EBUR128_SUCCESS != ebur128_loudness_range(ebur_state, &range)) {
-    range = 0.0;
-  }
+  momentary = meter->get_momentary();
+  shortterm = meter->get_shortterm();
+  global = meter->get_integrated();
+  relative = meter->get_relative_threshold();
+  range = meter->get_range();
 
-  if (EBUR128_SUCCESS != ebur128_true_peak(ebur_state, 0U, &true_peak_L)) {
-    true_peak_L = 0.0;
-  }
+  // maximum since the last reset, like the integrated loudness
 
-  if (EBUR128_SUCCESS != ebur128_true_peak(ebur_state, 1U, &true_peak_R)) {
-    true_peak_R = 0.0;
-  }
+  true_peak_L = std::max(true_peak_L, static_cast<double>(tap->get_true_peak(0U)));
+  true_peak_R = std::max(true_peak_R, static_cast<double>(tap->get_true_peak(1U)));
 
   if (post_messages) {
     get_peaks(left_in, right_in, left_out, right_out);
 
     if (send_notifications) {
-      results.emit(momentary, shortterm, global, relative, range, true_peak_L, true_peak_R);
+      post_meters({momentary, shortterm, global, relative, range, true_peak_L, true_peak_R});
 
       notify();
     }
   }
 }
 
+void LevelMeter::emit_meters(const MeterValues& values) {
+  results.emit(values[0U], values[1U], values[2U], values[3U], values[4U], values[5U], values[6U]);
+}
+
 auto LevelMeter::get_latency_seconds() -> float {
   return 0.0F;
 }
 
 void LevelMeter::reset_history() {
-  mythreads.emplace_back([this]() {  // Using emplace_back here makes sense
-    data_mutex.lock();
+  // The meter allocates its histories, so it is built here and only swapped while the lock is held
 
-    ebur128_ready = false;
+  auto new_meter = std::make_unique<GatedLoudness>(0U);
 
-    data_mutex.unlock();
-
-    auto status = init_ebur128();
-
-    data_mutex.lock();
+  std::scoped_lock<std::mutex> lock(data_mutex);
 
-    ebur128_ready = status;
+  meter.swap(new_meter);
 
-    data_mutex.unlock();
-  });
+  true_peak_L = 0.0;
+  true_peak_R = 0.0;
 }
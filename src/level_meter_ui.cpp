@@ -32,6 +32,8 @@
 #include <string>
 #include <vector>
 #include "level_meter.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -92,24 +94,13 @@ void setup(LevelMeterBox* self, std::shared_ptr<LevelMeter> level_meter, const s
 
   self->data->level_meter = level_meter;
 
-  self->settings = g_settings_new_with_path(tags::schema::level_meter::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::level_meter::id, schema_path.c_str());
 
   level_meter->set_post_messages(true);
 
-  self->data->connections.push_back(level_meter->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), level_meter,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label});
 
   self->data->connections.push_back(level_meter->results.connect(
       [=](const double momentary, const double shortterm, const double integrated, const double relative,
@@ -160,6 +151,8 @@ void setup(LevelMeterBox* self, std::shared_ptr<LevelMeter> level_meter, const s
 void dispose(GObject* object) {
   auto* self = EE_LEVEL_METER_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -50,6 +50,8 @@ Limiter::Limiter(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/sc_limiter_stereo is not installed");
   }
@@ -158,15 +160,7 @@ void Limiter::process(std::span<float>& left_in,
 
     latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
   }
@@ -180,10 +174,7 @@ void Limiter::process(std::span<float>& left_in,
       sidechain_l_port_value = lv2_wrapper->get_control_port_value("sclm_l");
       sidechain_r_port_value = lv2_wrapper->get_control_port_value("sclm_r");
 
-      gain_left.emit(gain_l_port_value);
-      gain_right.emit(gain_r_port_value);
-      sidechain_left.emit(sidechain_l_port_value);
-      sidechain_right.emit(sidechain_r_port_value);
+      post_meters({gain_l_port_value, gain_r_port_value, sidechain_l_port_value, sidechain_r_port_value});
 
       notify();
     }
@@ -191,6 +182,10 @@ void Limiter::process(std::span<float>& left_in,
 }
 
 void Limiter::update_sidechain_links(const std::string& key) {
+  if (pm == nullptr) {
+    return;
+  }
+
   if (g_settings_get_boolean(settings, "external-sidechain") == 0) {
     pm->destroy_links(list_proxies);
 
@@ -224,6 +219,22 @@ void Limiter::update_probe_links() {
   update_sidechain_links("");
 }
 
+void Limiter::reset_meters() {
+  gain_l_port_value = 1.0F;
+  gain_r_port_value = 1.0F;
+  sidechain_l_port_value = 0.0F;
+  sidechain_r_port_value = 0.0F;
+
+  post_meters({gain_l_port_value, gain_r_port_value, sidechain_l_port_value, sidechain_r_port_value});
+}
+
+void Limiter::emit_meters(const MeterValues& values) {
+  gain_left.emit(static_cast<float>(values[0U]));
+  gain_right.emit(static_cast<float>(values[1U]));
+  sidechain_left.emit(static_cast<float>(values[2U]));
+  sidechain_right.emit(static_cast<float>(values[3U]));
+}
+
 auto Limiter::get_latency_seconds() -> float {
   return this->latency_value;
 }
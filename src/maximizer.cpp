@@ -45,6 +45,8 @@ Maximizer::Maximizer(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "urn:zamaudio:ZaMaximX2 is not installed");
   }
@@ -122,15 +124,7 @@ void Maximizer::process(std::span<float>& left_in,
 
     latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
   }
@@ -143,13 +137,25 @@ void Maximizer::process(std::span<float>& left_in,
 
       reduction_port_value = static_cast<double>(lv2_wrapper->get_control_port_value("gr"));
 
-      reduction.emit(reduction_port_value);
+      post_meters({reduction_port_value});
 
       notify();
     }
   }
 }
 
+void Maximizer::reset_meters() {
+  // the reduction is given in decibels
+
+  reduction_port_value = 0.0;
+
+  post_meters({reduction_port_value});
+}
+
+void Maximizer::emit_meters(const MeterValues& values) {
+  reduction.emit(values[0U]);
+}
+
 auto Maximizer::get_latency_seconds() -> float {
   return latency_value;
 }
@@ -0,0 +1,187 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "metering_bus.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include "polyphase_resampler.hpp"
+
+namespace {
+
+// BS.1770 measures the true peak on the signal oversampled 4 times. The ratio does not depend on the sampling rate.
+constexpr uint true_peak_oversampling = 4U;
+
+}  // namespace
+
+MeteringTap::MeteringTap()
+    : oversampler_left(std::make_unique<PolyphaseResampler>(1U,
+                                                            true_peak_oversampling,
+                                                            PolyphaseResampler::default_max_input_frames,
+                                                            PolyphaseResampler::Quality::fast)),
+      oversampler_right(std::make_unique<PolyphaseResampler>(1U,
+                                                             true_peak_oversampling,
+                                                             PolyphaseResampler::default_max_input_frames,
+                                                             PolyphaseResampler::Quality::fast)),
+      oversampled(oversampler_left->get_max_output_frames(PolyphaseResampler::default_max_input_frames)) {}
+
+void MeteringTap::subscribe(const Feature& feature) {
+  switch (feature) {
+    case Feature::loudness:
+      loudness_subscribers++;
+      break;
+    case Feature::true_peak:
+      true_peak_subscribers++;
+      break;
+  }
+}
+
+void MeteringTap::unsubscribe(const Feature& feature) {
+  switch (feature) {
+    case Feature::loudness:
+      loudness_subscribers--;
+      break;
+    case Feature::true_peak:
+      true_peak_subscribers--;
+      break;
+  }
+}
+
+auto MeteringTap::has_subscribers() const -> bool {
+  return loudness_subscribers.load(std::memory_order_relaxed) > 0 ||
+         true_peak_subscribers.load(std::memory_order_relaxed) > 0;
+}
+
+void MeteringTap::analyze(std::span<const float> left,
+                          std::span<const float> right,
+                          const uint& rate,
+                          const uint64_t& position) {
+  /*
+    The branches of a parallel stage read the same tap and may run at the same time on different data threads. Only
+    the one that claims the position does the analysis. The others return at once and read the results published by
+    the previous cycle, what is harmless for meters.
+
+    A claim is only made once the previous analysis has stored its position. Reading that position with acquire makes
+    the filter states it left behind visible to this thread, and a late analysis is never run concurrently with the
+    next one.
+  */
+
+  auto claimed = claimed_position.load(std::memory_order_relaxed);
+
+  if (claimed == position || analyzed_position.load(std::memory_order_acquire) != claimed ||
+      !claimed_position.compare_exchange_strong(claimed, position, std::memory_order_relaxed)) {
+    return;
+  }
+
+  const auto n_frames = std::min(left.size(), right.size());
+
+  if (n_frames == 0U) {
+    analyzed_position.store(position, std::memory_order_release);
+
+    return;
+  }
+
+  const auto& current = results[published_results.load(std::memory_order_relaxed)];
+
+  const auto next_index = 1U - published_results.load(std::memory_order_relaxed);
+
+  auto& next = results[next_index];
+
+  std::array<std::span<const float>, 2U> channels = {left.first(n_frames), right.first(n_frames)};
+
+  for (uint c = 0U; c < 2U; c++) {
+    float max_abs = 0.0F;
+    double sum = 0.0;
+
+    for (const auto& v : channels[c]) {
+      max_abs = std::max(max_abs, std::fabs(v));
+
+      sum += static_cast<double>(v) * static_cast<double>(v);
+    }
+
+    next.peak[c].store(max_abs, std::memory_order_relaxed);
+    next.rms[c].store(static_cast<float>(std::sqrt(sum / static_cast<double>(n_frames))), std::memory_order_relaxed);
+  }
+
+  if (loudness_subscribers.load(std::memory_order_relaxed) > 0) {
+    if (rate != kweighting.get_rate()) {
+      kweighting.set_rate(rate);
+    }
+
+    kweighting.process(channels[0], channels[1], [&](const double& energy) {
+      const auto count = subblock_count.load(std::memory_order_relaxed);
+
+      subblock_energies[count % n_stored_subblocks] = energy;
+
+      subblock_count.store(count + 1U, std::memory_order_release);
+    });
+  }
+
+  if (true_peak_subscribers.load(std::memory_order_relaxed) > 0) {
+    measure_true_peak(channels[0], *oversampler_left, 0U, next);
+    measure_true_peak(channels[1], *oversampler_right, 1U, next);
+  } else {
+    for (uint c = 0U; c < 2U; c++) {
+      next.true_peak[c].store(current.true_peak[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+  }
+
+  published_results.store(next_index, std::memory_order_release);
+
+  analyzed_position.store(position, std::memory_order_release);
+}
+
+void MeteringTap::measure_true_peak(std::span<const float> input,
+                                    PolyphaseResampler& oversampler,
+                                    const uint& channel,
+                                    Results& output) {
+  // the interpolation filter may stay slightly below a sample, so the sample peak is the lower bound
+
+  float max_abs = output.peak[channel].load(std::memory_order_relaxed);
+
+  while (!input.empty()) {
+    const auto chunk = input.first(std::min(input.size(), static_cast<size_t>(oversampler.get_max_input_frames())));
+
+    input = input.subspan(chunk.size());
+
+    const auto n_out = oversampler.process(chunk, oversampled);
+
+    for (size_t n = 0U; n < n_out; n++) {
+      max_abs = std::max(max_abs, std::fabs(oversampled[n]));
+    }
+  }
+
+  output.true_peak[channel].store(max_abs, std::memory_order_relaxed);
+}
+
+auto MeteringBus::get_tap(const std::string& name) -> std::shared_ptr<MeteringTap> {
+  auto& tap = taps[name];
+
+  if (tap == nullptr) {
+    tap = std::make_shared<MeteringTap>();
+  }
+
+  return tap;
+}
@@ -0,0 +1,88 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "meters_aggregator.hpp"
+#include <gtk/gtk.h>
+#include <sys/types.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "plugin_base.hpp"
+#include "ui_helpers.hpp"
+
+namespace ui::meters_aggregator {
+
+namespace {
+
+struct Entry {
+  std::weak_ptr<PluginBase> plugin;
+
+  Meters input, output;
+
+  uint64_t serial = 0U;
+};
+
+std::unordered_map<GtkWidget*, Entry> entries;
+
+void update_meters(const Meters& meters, const float& left, const float& right) {
+  if (meters.left == nullptr) {
+    return;
+  }
+
+  update_level(meters.left, meters.left_label, meters.right, meters.right_label, left, right);
+}
+
+}  // namespace
+
+void add(GtkWidget* box, const std::shared_ptr<PluginBase>& plugin, const Meters& input, const Meters& output) {
+  entries.insert_or_assign(box, Entry{.plugin = plugin, .input = input, .output = output, .serial = 0U});
+}
+
+void remove(GtkWidget* box) {
+  entries.erase(box);
+}
+
+void update(GtkWidget* box) {
+  if (box == nullptr || !gtk_widget_get_mapped(box)) {
+    return;
+  }
+
+  auto it = entries.find(box);
+
+  if (it == entries.end()) {
+    return;
+  }
+
+  auto& entry = it->second;
+
+  const auto plugin = entry.plugin.lock();
+
+  if (plugin == nullptr || plugin->get_levels_serial() == entry.serial) {
+    return;
+  }
+
+  entry.serial = plugin->get_levels_serial();
+
+  const auto levels = plugin->get_levels();
+
+  update_meters(entry.input, levels[0], levels[1]);
+  update_meters(entry.output, levels[2], levels[3]);
+}
+
+}  // namespace ui::meters_aggregator
@@ -51,6 +51,8 @@ MultibandCompressor::MultibandCompressor(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/sc_mb_compressor_stereo is not installed");
   }
@@ -134,15 +136,7 @@ void MultibandCompressor::process(std::span<float>& left_in,
 
     latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
   }
@@ -166,10 +160,7 @@ void MultibandCompressor::process(std::span<float>& left_in,
                                              lv2_wrapper->get_control_port_value("rlm_" + nstr + "r"));
       }
 
-      frequency_range.emit(frequency_range_end_port_array);
-      envelope.emit(envelope_port_array);
-      curve.emit(curve_port_array);
-      reduction.emit(reduction_port_array);
+      post_port_arrays();
 
       notify();
     }
@@ -177,6 +168,10 @@ void MultibandCompressor::process(std::span<float>& left_in,
 }
 
 void MultibandCompressor::update_sidechain_links(const std::string& key) {
+  if (pm == nullptr) {
+    return;
+  }
+
   auto external_sidechain_enabled = false;
 
   for (uint n = 0U; !external_sidechain_enabled && n < n_bands; n++) {
@@ -218,6 +213,50 @@ void MultibandCompressor::update_probe_links() {
   update_sidechain_links("");
 }
 
+void MultibandCompressor::reset_meters() {
+  envelope_port_array.fill(0.0F);
+  curve_port_array.fill(0.0F);
+  reduction_port_array.fill(1.0F);
+
+  post_port_arrays();
+}
+
+void MultibandCompressor::post_port_arrays() {
+  // the four meter arrays are sent one after the other
+
+  static_assert(4U * n_bands <= max_meter_values);
+
+  MeterValues values{};
+
+  for (uint n = 0U; n < n_bands; n++) {
+    values.at(n) = frequency_range_end_port_array.at(n);
+    values.at(n + n_bands) = envelope_port_array.at(n);
+    values.at(n + 2U * n_bands) = curve_port_array.at(n);
+    values.at(n + 3U * n_bands) = reduction_port_array.at(n);
+  }
+
+  post_meters(values);
+}
+
+void MultibandCompressor::emit_meters(const MeterValues& values) {
+  std::array<float, n_bands> frequency_range_values{};
+  std::array<float, n_bands> envelope_values{};
+  std::array<float, n_bands> curve_values{};
+  std::array<float, n_bands> reduction_values{};
+
+  for (uint n = 0U; n < n_bands; n++) {
+    frequency_range_values.at(n) = static_cast<float>(values.at(n));
+    envelope_values.at(n) = static_cast<float>(values.at(n + n_bands));
+    curve_values.at(n) = static_cast<float>(values.at(n + 2U * n_bands));
+    reduction_values.at(n) = static_cast<float>(values.at(n + 3U * n_bands));
+  }
+
+  frequency_range.emit(frequency_range_values);
+  envelope.emit(envelope_values);
+  curve.emit(curve_values);
+  reduction.emit(reduction_values);
+}
+
 auto MultibandCompressor::get_latency_seconds() -> float {
   return latency_value;
 }
@@ -34,11 +34,13 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "meters_aggregator.hpp"
 #include "multiband_compressor.hpp"
 #include "multiband_compressor_band_box.hpp"
 #include "node_info_holder.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "settings_store.hpp"
 #include "tags_multiband_compressor.hpp"
 #include "tags_pipewire.hpp"
 #include "tags_resources.hpp"
@@ -181,7 +183,7 @@ void setup(MultibandCompressorBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::multiband_compressor::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::multiband_compressor::id, schema_path.c_str());
 
   multiband_compressor->set_post_messages(true);
 
@@ -207,36 +209,11 @@ void setup(MultibandCompressorBox* self,
     }
   }
 
-  self->data->connections.push_back(multiband_compressor->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(
-      multiband_compressor->output_level.connect([=](const float left, const float right) {
-        g_object_ref(self);
-
-        util::idle_add(
-            [=]() {
-              if (get_ignore_filter_idle_add(serial)) {
-                return;
-              }
-
-              update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                           self->output_level_right_label, left, right);
-            },
-            [=]() { g_object_unref(self); });
-      }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), multiband_compressor,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   self->data->connections.push_back(multiband_compressor->frequency_range.connect(
       [=](const std::array<float, tags::multiband_compressor::n_bands> values) {
@@ -376,6 +353,8 @@ void dispose(GObject* object) {
 
   self->data->multiband_compressor->close_native_ui();
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
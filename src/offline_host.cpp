@@ -0,0 +1,108 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "offline_host.hpp"
+#include <glib.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include "plugin_base.hpp"
+#include "util.hpp"
+
+OfflineHost::OfflineHost(std::shared_ptr<PluginBase> plugin) : plugin(std::move(plugin)) {
+  // the PipeWire node would call process_quantum() at the same time as we do
+
+  if (this->plugin->filter != nullptr) {
+    util::warning(this->plugin->log_tag + this->plugin->name + " is connected to PipeWire. It can not run offline.");
+  }
+}
+
+void OfflineHost::drain_main_context() {
+  while (g_main_context_pending(nullptr) != 0) {
+    g_main_context_iteration(nullptr, 0);
+  }
+}
+
+void OfflineHost::configure(const uint& rate, const uint& quantum) {
+  this->quantum = quantum;
+
+  left_in_buffer.assign(quantum, 0.0F);
+  right_in_buffer.assign(quantum, 0.0F);
+  left_out_buffer.assign(quantum, 0.0F);
+  right_out_buffer.assign(quantum, 0.0F);
+  probe_left.assign(quantum, 0.0F);
+  probe_right.assign(quantum, 0.0F);
+
+  // the same steps the reconfiguration worker does for a filter connected to PipeWire
+
+  plugin->pending_rate = rate;
+  plugin->pending_n_samples = quantum;
+
+  plugin->rate = rate;
+  plugin->n_samples = quantum;
+
+  if (plugin->dummy_left.size() < quantum) {
+    plugin->dummy_left.resize(quantum, 0.0F);
+    plugin->dummy_right.resize(quantum, 0.0F);
+    plugin->mono_buffer.resize(quantum, 0.0F);
+  }
+
+  plugin->setup();
+
+  plugin->applied_n_samples = quantum;
+  plugin->applied_serial = plugin->pending_serial.load();
+
+  drain_main_context();
+}
+
+void OfflineHost::process(std::span<const float> left_in,
+                          std::span<const float> right_in,
+                          std::span<float> left_out,
+                          std::span<float> right_out) {
+  if (quantum == 0U) {
+    return;
+  }
+
+  const auto n_frames = std::min({left_in.size(), right_in.size(), left_out.size(), right_out.size()});
+
+  for (size_t offset = 0U; offset < n_frames; offset += quantum) {
+    const auto count = std::min(static_cast<size_t>(quantum), n_frames - offset);
+
+    // the plugins may write to their input, so PipeWire's separate input buffers are emulated here
+
+    std::ranges::fill(left_in_buffer, 0.0F);
+    std::ranges::fill(right_in_buffer, 0.0F);
+
+    std::ranges::copy(left_in.subspan(offset, count), left_in_buffer.begin());
+    std::ranges::copy(right_in.subspan(offset, count), right_in_buffer.begin());
+
+    plugin->process_quantum(left_in_buffer, right_in_buffer, left_out_buffer, right_out_buffer, probe_left,
+                            probe_right);
+
+    std::copy_n(left_out_buffer.begin(), count, left_out.begin() + static_cast<std::ptrdiff_t>(offset));
+    std::copy_n(right_out_buffer.begin(), count, right_out.begin() + static_cast<std::ptrdiff_t>(offset));
+  }
+}
+
+auto OfflineHost::get_latency_seconds() const -> float {
+  return plugin->get_latency_seconds();
+}
@@ -0,0 +1,518 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "parametric_eq.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <thread>
+
+namespace {
+
+constexpr double min_frequency = 10.0;
+
+constexpr double max_frequency_ratio = 0.48;  // relative to the sampling rate
+
+constexpr double min_q = 0.01;
+
+constexpr double smoothing_time = 0.01;  // seconds
+
+}  // namespace
+
+ParametricEq::ParametricEq() = default;
+
+ParametricEq::~ParametricEq() {
+  design_ptr.store(nullptr);
+
+  while (busy.load()) {
+    std::this_thread::yield();
+  }
+}
+
+void ParametricEq::set_rate(const uint& rate) {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  if (rate == this->rate) {
+    return;
+  }
+
+  this->rate = rate;
+
+  reset_serial++;
+
+  for (auto& channel : dirty) {
+    std::ranges::fill(channel, true);
+  }
+}
+
+void ParametricEq::set_band(const uint& channel, const uint& index, const Band& band) {
+  if (channel > 1U || index >= max_bands) {
+    return;
+  }
+
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  if (bands[channel][index] != band) {
+    bands[channel][index] = band;
+
+    dirty[channel][index] = true;
+  }
+}
+
+void ParametricEq::set_balance(const double& value) {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  balance = std::clamp(value, -100.0, 100.0);
+}
+
+void ParametricEq::set_pitch(const uint& channel, const double& semitones) {
+  if (channel > 1U) {
+    return;
+  }
+
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  if (pitch[channel] != semitones) {
+    pitch[channel] = semitones;
+
+    std::ranges::fill(dirty[channel], true);
+  }
+}
+
+void ParametricEq::compute_band(const uint& channel, const uint& index) {
+  const auto& band = bands[channel][index];
+
+  auto& n = n_sections[channel][index];
+
+  n = 0U;
+
+  if (rate == 0U || band.type == Type::off) {
+    return;
+  }
+
+  const auto fs = static_cast<double>(rate);
+
+  const double f =
+      std::clamp(band.frequency * std::exp2(pitch[channel] / 12.0), min_frequency, max_frequency_ratio * fs);
+
+  const double w = std::tan(std::numbers::pi * f / fs);
+
+  const double q = std::max(band.q, min_q);
+
+  const uint order = std::min(band.slope, 3U) + 1U;
+
+  auto* out = sections[channel].data() + static_cast<size_t>(index) * sections_per_band;
+
+  auto add = [&](const double& g, const double& k, const double& m0, const double& m1, const double& m2) {
+    const double a1 = 1.0 / (1.0 + g * (g + k));
+
+    out[n] = {.a1 = static_cast<float>(a1),
+              .a2 = static_cast<float>(g * a1),
+              .a3 = static_cast<float>(g * g * a1),
+              .m0 = static_cast<float>(m0),
+              .m1 = static_cast<float>(m1),
+              .m2 = static_cast<float>(m2)};
+
+    n++;
+  };
+
+  switch (band.type) {
+    case Type::lo_pass:
+    case Type::hi_pass: {
+      // The Butterworth modes ignore the quality factor. Linkwitz-Riley is a Butterworth cascade run twice.
+
+      const bool butterworth = band.mode == Mode::bwc_bt || band.mode == Mode::bwc_mt || band.mode == Mode::lrx_bt ||
+                               band.mode == Mode::lrx_mt;
+
+      const uint passes = (band.mode == Mode::lrx_bt || band.mode == Mode::lrx_mt) ? 2U : 1U;
+
+      for (uint p = 0U; p < passes; p++) {
+        for (uint i = 0U; i < order; i++) {
+          const double qi =
+              butterworth ? 1.0 / (2.0 * std::sin(std::numbers::pi * (2.0 * i + 1.0) / (4.0 * order))) : q;
+
+          const double k = 1.0 / qi;
+
+          if (band.type == Type::lo_pass) {
+            add(w, k, 0.0, 0.0, 1.0);
+          } else {
+            add(w, k, 1.0, -k, -1.0);
+          }
+        }
+      }
+
+      break;
+    }
+    case Type::bell:
+    case Type::resonance:
+    case Type::ladder_rej:
+    case Type::ladder_pass: {
+      if (band.gain == 0.0) {
+        break;
+      }
+
+      // A ladder pass band is a cut of the band followed by a boost of everything
+
+      const double gain = (band.type == Type::ladder_pass) ? -band.gain : band.gain;
+
+      const double a = std::pow(10.0, gain / (40.0 * order));
+
+      const double k = 1.0 / (q * a);
+
+      for (uint i = 0U; i < order; i++) {
+        add(w, k, 1.0, k * (a * a - 1.0), 0.0);
+      }
+
+      if (band.type == Type::ladder_pass) {
+        const auto g = static_cast<float>(std::pow(10.0, band.gain / 20.0));
+
+        out[0].m0 *= g;
+        out[0].m1 *= g;
+        out[0].m2 *= g;
+      }
+
+      break;
+    }
+    case Type::lo_shelf:
+    case Type::hi_shelf: {
+      if (band.gain == 0.0) {
+        break;
+      }
+
+      const double a = std::pow(10.0, band.gain / (40.0 * order));
+
+      const double k = 1.0 / q;
+
+      for (uint i = 0U; i < order; i++) {
+        if (band.type == Type::lo_shelf) {
+          add(w / std::sqrt(a), k, 1.0, k * (a - 1.0), a * a - 1.0);
+        } else {
+          add(w * std::sqrt(a), k, a * a, k * (1.0 - a) * a, 1.0 - a * a);
+        }
+      }
+
+      break;
+    }
+    case Type::notch:
+    case Type::allpass:
+    case Type::bandpass: {
+      const double k = 1.0 / q;
+
+      for (uint i = 0U; i < order; i++) {
+        if (band.type == Type::notch) {
+          add(w, k, 1.0, -k, 0.0);
+        } else if (band.type == Type::allpass) {
+          add(w, k, 1.0, -2.0 * k, 0.0);
+        } else {
+          add(w, k, 0.0, k, 0.0);
+        }
+      }
+
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void ParametricEq::commit() {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  for (uint c = 0U; c < 2U; c++) {
+    for (uint b = 0U; b < max_bands; b++) {
+      if (dirty[c][b]) {
+        compute_band(c, b);
+
+        dirty[c][b] = false;
+      }
+    }
+  }
+
+  auto d = std::make_unique<Design>();
+
+  std::array<bool, 2U> any_solo{};
+
+  for (uint c = 0U; c < 2U; c++) {
+    any_solo[c] = std::ranges::any_of(bands[c], [](const auto& band) {
+      return band.solo && !band.mute && band.type != Type::off;
+    });
+  }
+
+  const Section identity;
+
+  for (uint b = 0U; b < max_bands; b++) {
+    std::array<uint, 2U> n{};
+
+    for (uint c = 0U; c < 2U; c++) {
+      const auto& band = bands[c][b];
+
+      n[c] = (!band.mute && (!any_solo[c] || band.solo)) ? n_sections[c][b] : 0U;
+    }
+
+    for (uint s = 0U; s < std::max(n[0], n[1]); s++) {
+      const auto slot = b * sections_per_band + s;
+
+      // A lane without this section passes its channel through. It borrows the state coefficients of the other lane.
+
+      auto left = (s < n[0]) ? sections[0][slot] : sections[1][slot];
+      auto right = (s < n[1]) ? sections[1][slot] : sections[0][slot];
+
+      if (s >= n[0]) {
+        left.m0 = identity.m0;
+        left.m1 = identity.m1;
+        left.m2 = identity.m2;
+      }
+
+      if (s >= n[1]) {
+        right.m0 = identity.m0;
+        right.m1 = identity.m1;
+        right.m2 = identity.m2;
+      }
+
+      d->target[slot] = {.a1 = v2sf{left.a1, right.a1},
+                         .a2 = v2sf{left.a2, right.a2},
+                         .a3 = v2sf{left.a3, right.a3},
+                         .m0 = v2sf{left.m0, right.m0},
+                         .m1 = v2sf{left.m1, right.m1},
+                         .m2 = v2sf{left.m2, right.m2}};
+
+      d->active[slot] = true;
+    }
+  }
+
+  d->gain = v2sf{static_cast<float>(balance > 0.0 ? 1.0 - 0.01 * balance : 1.0),
+                 static_cast<float>(balance < 0.0 ? 1.0 + 0.01 * balance : 1.0)};
+
+  d->alpha = (rate != 0U) ? static_cast<float>(1.0 - std::exp(-1.0 / (smoothing_time * rate))) : 1.0F;
+
+  d->serial = ++serial;
+
+  d->reset_serial = reset_serial;
+
+  design_ptr.store(d.get());
+
+  while (busy.load()) {
+    std::this_thread::yield();
+  }
+
+  design = std::move(d);
+}
+
+void ParametricEq::take_design(const Design& d) {
+  target = d.target;
+
+  target_active = d.active;
+
+  target_gain = d.gain;
+
+  alpha = d.alpha;
+
+  if (!has_design || d.reset_serial != applied_reset_serial) {
+    current = d.target;
+
+    running = d.active;
+
+    std::ranges::fill(ic1, v2sf{0.0F, 0.0F});
+    std::ranges::fill(ic2, v2sf{0.0F, 0.0F});
+
+    gain = d.gain;
+
+    smoothing = false;
+  } else {
+    const v2sf one = {1.0F, 1.0F};
+    const v2sf zero = {0.0F, 0.0F};
+
+    for (uint s = 0U; s < max_sections; s++) {
+      if (target_active[s] && !running[s]) {
+        // fading in from a section that passes the signal through
+
+        current[s] = {.a1 = target[s].a1, .a2 = target[s].a2, .a3 = target[s].a3, .m0 = one, .m1 = zero, .m2 = zero};
+
+        ic1[s] = zero;
+        ic2[s] = zero;
+
+        running[s] = true;
+      } else if (!target_active[s] && running[s]) {
+        // fading out. The section keeps running until it passes the signal through.
+
+        target[s] = {.a1 = current[s].a1, .a2 = current[s].a2, .a3 = current[s].a3, .m0 = one, .m1 = zero, .m2 = zero};
+      }
+    }
+
+    smoothing = true;
+  }
+
+  has_design = true;
+
+  applied_serial = d.serial;
+  applied_reset_serial = d.reset_serial;
+
+  update_running_list();
+}
+
+void ParametricEq::update_running_list() {
+  n_running = 0U;
+
+  for (uint s = 0U; s < max_sections; s++) {
+    if (running[s]) {
+      running_list[n_running++] = s;
+    }
+  }
+}
+
+void ParametricEq::finish_smoothing() {
+  auto converged = [](const v2sf& c, const v2sf& t) {
+    const v2sf d = t - c;
+
+    return std::fabs(d[0]) <= 1e-5F * (1.0F + std::fabs(t[0])) && std::fabs(d[1]) <= 1e-5F * (1.0F + std::fabs(t[1]));
+  };
+
+  bool done = converged(gain, target_gain);
+
+  if (done) {
+    gain = target_gain;
+  }
+
+  bool list_changed = false;
+
+  for (uint i = 0U; i < n_running; i++) {
+    const auto s = running_list[i];
+
+    const auto& c = current[s];
+    const auto& t = target[s];
+
+    if (converged(c.a1, t.a1) && converged(c.a2, t.a2) && converged(c.a3, t.a3) && converged(c.m0, t.m0) &&
+        converged(c.m1, t.m1) && converged(c.m2, t.m2)) {
+      current[s] = t;
+
+      if (!target_active[s]) {
+        running[s] = false;
+
+        list_changed = true;
+      }
+    } else {
+      done = false;
+    }
+  }
+
+  if (list_changed) {
+    update_running_list();
+  }
+
+  smoothing = !done;
+}
+
+template <bool smooth>
+void ParametricEq::run_section(const uint& s, const uint& count) {
+  auto c = current[s];
+
+  const auto& t = target[s];
+
+  auto s1 = ic1[s];
+  auto s2 = ic2[s];
+
+  const v2sf two = {2.0F, 2.0F};
+  const v2sf k = {alpha, alpha};
+
+  for (uint n = 0U; n < count; n++) {
+    if constexpr (smooth) {
+      c.a1 += k * (t.a1 - c.a1);
+      c.a2 += k * (t.a2 - c.a2);
+      c.a3 += k * (t.a3 - c.a3);
+      c.m0 += k * (t.m0 - c.m0);
+      c.m1 += k * (t.m1 - c.m1);
+      c.m2 += k * (t.m2 - c.m2);
+    }
+
+    const v2sf v0 = frames[n];
+    const v2sf v3 = v0 - s2;
+    const v2sf v1 = c.a1 * s1 + c.a2 * v3;
+    const v2sf v2 = s2 + c.a2 * s1 + c.a3 * v3;
+
+    s1 = two * v1 - s1;
+    s2 = two * v2 - s2;
+
+    frames[n] = c.m0 * v0 + c.m1 * v1 + c.m2 * v2;
+  }
+
+  current[s] = c;
+
+  ic1[s] = s1;
+  ic2[s] = s2;
+}
+
+void ParametricEq::process(std::span<const float> left_in,
+                           std::span<const float> right_in,
+                           std::span<float> left_out,
+                           std::span<float> right_out) {
+  busy.store(true);
+
+  if (const auto* d = design_ptr.load(); d != nullptr && (!has_design || d->serial != applied_serial)) {
+    take_design(*d);
+  }
+
+  busy.store(false);
+
+  const auto n_frames = std::min({left_in.size(), right_in.size(), left_out.size(), right_out.size()});
+
+  if (!has_design) {
+    std::copy_n(left_in.begin(), n_frames, left_out.begin());
+    std::copy_n(right_in.begin(), n_frames, right_out.begin());
+
+    return;
+  }
+
+  const v2sf k = {alpha, alpha};
+
+  for (size_t offset = 0U; offset < n_frames; offset += block_size) {
+    const auto count = static_cast<uint>(std::min(static_cast<size_t>(block_size), n_frames - offset));
+
+    for (uint n = 0U; n < count; n++) {
+      frames[n] = v2sf{left_in[offset + n], right_in[offset + n]};
+    }
+
+    for (uint i = 0U; i < n_running; i++) {
+      if (smoothing) {
+        run_section<true>(running_list[i], count);
+      } else {
+        run_section<false>(running_list[i], count);
+      }
+    }
+
+    for (uint n = 0U; n < count; n++) {
+      if (smoothing) {
+        gain += k * (target_gain - gain);
+      }
+
+      const v2sf v = frames[n] * gain;
+
+      left_out[offset + n] = v[0];
+      right_out[offset + n] = v[1];
+    }
+  }
+
+  if (smoothing) {
+    finish_smoothing();
+  }
+}
@@ -1586,6 +1586,15 @@ PipeManager::PipeManager() : header_version(pw_get_headers_version()), library_v
   pw_properties_set(props_context, PW_KEY_MEDIA_CATEGORY, "Manager");
   pw_properties_set(props_context, PW_KEY_MEDIA_ROLE, "Music");
 
+  /*
+    Since PipeWire 1.2 the nodes of a client can be spread over several data loops. The branches of a parallel stage
+    of our pipelines are then processed at the same time on different cores. Older versions ignore this property.
+  */
+
+  const auto n_data_loops = std::clamp(std::thread::hardware_concurrency(), 1U, max_data_loops);
+
+  pw_properties_set(props_context, "context.num-data-loops", util::to_string(n_data_loops).c_str());
+
   context = pw_context_new(pw_thread_loop_get_loop(thread_loop), props_context, 0);
 
   if (context == nullptr) {
@@ -18,6 +18,7 @@
  */
 
 #include "pipe_manager_box.hpp"
+#include <adwaita.h>
 #include <fmt/format.h>
 #include <gio/gio.h>
 #include <glib-object.h>
@@ -78,7 +79,15 @@ struct _PipeManagerBox {
 
   GtkLabel *header_version, *library_version, *core_version, *quantum, *max_quantum, *min_quantum, *server_rate;
 
-  GtkSpinButton* spinbutton_test_signal_frequency;
+  GtkSpinButton *spinbutton_test_signal_frequency, *spinbutton_measurement_duration;
+
+  GtkEntry* measurement_ir_name;
+
+  GtkButton* measurement_button;
+
+  GtkSpinner* measurement_spinner;
+
+  AdwActionRow* measurement_status;
 
   GListStore *input_devices_model, *output_devices_model, *modules_model, *clients_model, *autoloading_input_model,
       *autoloading_output_model, *autoloading_input_devices_model, *autoloading_output_devices_model;
@@ -131,6 +140,57 @@ void on_checkbutton_signal_gaussian(PipeManagerBox* self, GtkCheckButton* btn) {
   }
 }
 
+void on_measure_impulse_response(PipeManagerBox* self, GtkButton* btn) {
+  if (self->data->ts->measuring()) {
+    self->data->ts->cancel_measurement();
+
+    gtk_spinner_stop(self->measurement_spinner);
+    gtk_button_set_label(self->measurement_button, _("Measure"));
+    gtk_widget_set_sensitive(GTK_WIDGET(self->enable_test_signal), 1);
+
+    adw_action_row_set_subtitle(self->measurement_status, _("Cancelled"));
+
+    return;
+  }
+
+  std::string ir_name = g_utf8_make_valid(gtk_editable_get_text(GTK_EDITABLE(self->measurement_ir_name)), -1);
+
+  util::str_trim(ir_name);
+
+  if (ir_name.empty() || ir_name.find_first_of("\\/") != std::string::npos) {
+    util::debug("impulse response filename is empty or has illegal characters.");
+
+    gtk_widget_add_css_class(GTK_WIDGET(self->measurement_ir_name), "error");
+
+    gtk_widget_grab_focus(GTK_WIDGET(self->measurement_ir_name));
+
+    return;
+  }
+
+  // Truncate filename if longer than 100 characters
+
+  if (ir_name.size() > 100U) {
+    ir_name.resize(100U);
+  }
+
+  gtk_widget_remove_css_class(GTK_WIDGET(self->measurement_ir_name), "error");
+
+  if (!self->data->ts->start_measurement(ir_name, gtk_spin_button_get_value(self->spinbutton_measurement_duration))) {
+    adw_action_row_set_subtitle(self->measurement_status, _("The measurement could not be started"));
+
+    return;
+  }
+
+  // the output links of the test signal must not be changed while the sweep is playing
+
+  gtk_widget_set_sensitive(GTK_WIDGET(self->enable_test_signal), 0);
+
+  gtk_spinner_start(self->measurement_spinner);
+  gtk_button_set_label(self->measurement_button, _("Cancel"));
+
+  adw_action_row_set_subtitle(self->measurement_status, _("Measuring"));
+}
+
 void on_autoloading_add_input_profile(PipeManagerBox* self, GtkButton* btn) {
   auto* holder = static_cast<ui::holders::NodeInfoHolder*>(
       gtk_drop_down_get_selected_item(self->dropdown_autoloading_input_devices));
@@ -433,6 +493,21 @@ void setup(PipeManagerBox* self, app::Application* application) {
 
   self->data->ts = std::make_unique<TestSignals>(pm);
 
+  self->data->connections.push_back(
+      self->data->ts->measurement_finished.connect([=](const bool success, const std::string message) {
+        gtk_spinner_stop(self->measurement_spinner);
+        gtk_button_set_label(self->measurement_button, _("Measure"));
+        gtk_widget_set_sensitive(GTK_WIDGET(self->enable_test_signal), 1);
+
+        if (success) {
+          gtk_editable_set_text(GTK_EDITABLE(self->measurement_ir_name), "");
+
+          adw_action_row_set_subtitle(self->measurement_status, fmt::format(_("Saved: {}"), message).c_str());
+        } else {
+          adw_action_row_set_subtitle(self->measurement_status, message.c_str());
+        }
+      }));
+
   for (const auto& [serial, node] : pm->node_map) {
     if (node.name == tags::pipewire::ee_sink_name || node.name == tags::pipewire::ee_source_name) {
       continue;
@@ -886,6 +961,11 @@ void pipe_manager_box_class_init(PipeManagerBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, server_rate);
 
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, spinbutton_test_signal_frequency);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, spinbutton_measurement_duration);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, measurement_ir_name);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, measurement_button);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, measurement_spinner);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, measurement_status);
 
   gtk_widget_class_bind_template_callback(widget_class, on_enable_test_signal);
   gtk_widget_class_bind_template_callback(widget_class, on_checkbutton_channel_left);
@@ -893,6 +973,7 @@ void pipe_manager_box_class_init(PipeManagerBoxClass* klass) {
   gtk_widget_class_bind_template_callback(widget_class, on_checkbutton_channel_both);
   gtk_widget_class_bind_template_callback(widget_class, on_checkbutton_signal_sine);
   gtk_widget_class_bind_template_callback(widget_class, on_checkbutton_signal_gaussian);
+  gtk_widget_class_bind_template_callback(widget_class, on_measure_impulse_response);
   gtk_widget_class_bind_template_callback(widget_class, on_stack_visible_child_changed);
   gtk_widget_class_bind_template_callback(widget_class, on_autoloading_add_input_profile);
   gtk_widget_class_bind_template_callback(widget_class, on_autoloading_add_output_profile);
@@ -919,6 +1000,7 @@ void pipe_manager_box_init(PipeManagerBox* self) {
   self->soe_settings = g_settings_new(tags::schema::id_output);
 
   prepare_spinbuttons<"Hz">(self->spinbutton_test_signal_frequency);
+  prepare_spinbuttons<"s">(self->spinbutton_measurement_duration);
 
   g_settings_bind(self->sie_settings, "use-default-input-device", self->use_default_input, "active",
                   G_SETTINGS_BIND_DEFAULT);
@@ -40,21 +40,232 @@
 #include <sys/types.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
 #include <span>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
+#include "delay_line.hpp"
+#include "metering_bus.hpp"
 #include "pipe_manager.hpp"
+#include "rt_checks.hpp"
+#include "settings_store.hpp"
 #include "tags_app.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
 
 namespace {
 
+auto absolute_peak(std::span<const float> data) -> float {
+  float peak = 0.0F;
+
+  for (const auto& v : data) {
+    peak = std::max(peak, std::fabs(v));
+  }
+
+  return peak;
+}
+
+/*
+  Calls setup() outside of the realtime thread when the quantum or the rate of a filter changes. The realtime thread
+  wakes the dispatcher through an atomic counter, so it never locks or allocates. Every filter is set up in a thread of
+  its own, so a slow setup() does not hold back the other filters.
+*/
+
+class Reconfigurator {
+ public:
+  Reconfigurator(const Reconfigurator&) = delete;
+  auto operator=(const Reconfigurator&) -> Reconfigurator& = delete;
+  Reconfigurator(const Reconfigurator&&) = delete;
+  auto operator=(const Reconfigurator&&) -> Reconfigurator& = delete;
+
+  static auto get() -> Reconfigurator& {
+    static Reconfigurator instance;
+
+    return instance;
+  }
+
+  void add(PluginBase* plugin) {
+    {
+      std::scoped_lock<std::mutex> lock(plugins_mutex);
+
+      plugins.try_emplace(plugin, std::make_unique<Task>());
+    }
+
+    // a change requested while the plugin was not registered has to be handled now
+
+    request();
+  }
+
+  // Waits for a setup() that may be running for this plugin
+  void remove(PluginBase* plugin) {
+    std::unique_ptr<Task> task;
+
+    {
+      std::scoped_lock<std::mutex> lock(plugins_mutex);
+
+      if (auto it = plugins.find(plugin); it != plugins.end()) {
+        task = std::move(it->second);
+
+        plugins.erase(it);
+      }
+    }
+
+    if (task != nullptr && task->thread.joinable()) {
+      task->thread.join();
+    }
+  }
+
+  // Realtime safe
+  void request() {
+    requests.fetch_add(1U, std::memory_order_release);
+
+    requests.notify_one();
+  }
+
+ private:
+  struct Task {
+    std::thread thread;
+
+    std::atomic<bool> running = false;
+  };
+
+  std::atomic<uint> requests = 0U;
+
+  std::atomic<bool> exit = false;
+
+  std::mutex plugins_mutex;
+
+  std::map<PluginBase*, std::unique_ptr<Task>> plugins;
+
+  std::thread worker;
+
+  Reconfigurator() : worker([this]() { loop(); }) {}
+
+  ~Reconfigurator() {
+    exit = true;
+
+    request();
+
+    worker.join();
+
+    for (auto& task : plugins | std::views::values) {
+      if (task->thread.joinable()) {
+        task->thread.join();
+      }
+    }
+  }
+
+  static auto has_pending_change(PluginBase* pb) -> bool {
+    return pb->pending_serial.load(std::memory_order_acquire) != pb->applied_serial.load(std::memory_order_relaxed);
+  }
+
+  void loop() {
+    while (!exit) {
+      requests.wait(0U, std::memory_order_acquire);
+
+      requests.exchange(0U, std::memory_order_acq_rel);
+
+      std::scoped_lock<std::mutex> lock(plugins_mutex);
+
+      for (auto& [plugin, task] : plugins) {
+        // a task that is still running handles the changes requested before it returns
+
+        if (task->running.load(std::memory_order_acquire) || !has_pending_change(plugin)) {
+          continue;
+        }
+
+        if (task->thread.joinable()) {
+          task->thread.join();
+        }
+
+        task->running = true;
+
+        task->thread = std::thread([this, plugin, task = task.get()]() {
+          reconfigure(plugin);
+
+          task->running.store(false, std::memory_order_release);
+
+          // a change requested after the last check in reconfigure() would wait for the next request otherwise
+
+          if (has_pending_change(plugin)) {
+            request();
+          }
+        });
+      }
+    }
+  }
+
+  static void reconfigure(PluginBase* pb) {
+    for (auto serial = pb->pending_serial.load(std::memory_order_acquire);
+         serial != pb->applied_serial.load(std::memory_order_relaxed);
+         serial = pb->pending_serial.load(std::memory_order_acquire)) {
+      // The realtime thread does not call process() while configuring is set. The quantum it may be processing is
+      // waited for.
+
+      pb->configuring.store(true, std::memory_order_seq_cst);
+
+      while (pb->processing.load(std::memory_order_seq_cst)) {
+        std::this_thread::yield();
+      }
+
+      // Settings callbacks in the main thread read rate and n_samples while holding data_mutex. setup() may lock it
+      // too, so it is released before setup() is called.
+
+      {
+        std::scoped_lock<std::mutex> lock(pb->data_mutex);
+
+        pb->rate = pb->pending_rate;
+        pb->n_samples = pb->pending_n_samples;
+      }
+
+      // Only larger than max_quantum if PipeWire's configuration changed after the filter was created
+
+      if (pb->dummy_left.size() < pb->n_samples) {
+        pb->dummy_left.resize(pb->n_samples, 0.0F);
+        pb->dummy_right.resize(pb->n_samples, 0.0F);
+        pb->mono_buffer.resize(pb->n_samples, 0.0F);
+      }
+
+      pb->setup();
+
+      pb->applied_n_samples.store(pb->n_samples, std::memory_order_relaxed);
+
+      // The realtime thread may have requested another change while setup() was running. In that case the serials
+      // still differ and the loop runs again.
+
+      pb->applied_serial.store(serial, std::memory_order_release);
+
+      pb->configuring.store(false, std::memory_order_release);
+    }
+  }
+};
+
+/*
+  Used while setup() runs in the worker, or while the plugin state does not match the new quantum yet. Silence is
+  written instead of the input because copying the dry signal would bypass limiters and gain stages.
+*/
+void write_silence(PluginBase::data* d, const uint& n_samples) {
+  for (auto* port : {d->out_left, d->out_right}) {
+    if (auto* out = static_cast<float*>(pw_filter_get_dsp_buffer(port, n_samples)); out != nullptr) {
+      std::fill_n(out, n_samples, 0.0F);
+    }
+  }
+}
+
 void on_process(void* userdata, spa_io_position* position) {
+  [[maybe_unused]] rt_checks::ScopedRealtime rt_scope;
+
   auto* d = static_cast<PluginBase::data*>(userdata);
 
   const auto n_samples = position->clock.duration;
@@ -64,19 +275,42 @@ void on_process(void* userdata, spa_io_position* position) {
     return;
   }
 
-  if (rate != d->pb->rate || n_samples != d->pb->n_samples) {
-    d->pb->rate = rate;
-    d->pb->n_samples = n_samples;
+  if (rate != d->pb->pending_rate || n_samples != d->pb->pending_n_samples) {
+    // The buffers are allocated for max_quantum. When nothing else is pending a smaller quantum at the same rate does
+    // not need setup() in the plugins that say so.
+
+    const bool in_place = !d->pb->quantum_needs_setup && rate == d->pb->pending_rate &&
+                          n_samples <= d->pb->max_quantum &&
+                          d->pb->applied_serial.load(std::memory_order_acquire) == d->pb->pending_serial;
 
-    d->pb->dummy_left.resize(n_samples);
-    d->pb->dummy_right.resize(n_samples);
+    d->pb->pending_rate = rate;
+    d->pb->pending_n_samples = n_samples;
+
+    if (in_place) {
+      d->pb->set_quantum_in_place(n_samples);
+    } else {
+      d->pb->pending_serial++;
 
-    std::ranges::fill(d->pb->dummy_left, 0.0F);
-    std::ranges::fill(d->pb->dummy_right, 0.0F);
+      Reconfigurator::get().request();
+    }
 
     d->pb->clock_start = std::chrono::system_clock::now();
+  }
+
+  /*
+    Until the worker has applied a change the plugin keeps processing with its current state. That is only possible
+    if the state was set up for this quantum. Silence is written while setup() runs or while the quantum differs.
+  */
 
-    d->pb->setup();
+  d->pb->processing.store(true, std::memory_order_seq_cst);
+
+  if (d->pb->configuring.load(std::memory_order_seq_cst) ||
+      d->pb->applied_n_samples.load(std::memory_order_acquire) != n_samples) {
+    d->pb->processing.store(false, std::memory_order_release);
+
+    write_silence(d, n_samples);
+
+    return;
   }
 
   d->pb->delta_t = 0.001F * static_cast<float>(std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -101,46 +335,49 @@ void on_process(void* userdata, spa_io_position* position) {
   if (in_left != nullptr) {
     left_in = std::span(in_left, n_samples);
   } else {
-    left_in = d->pb->dummy_left;
+    left_in = std::span(d->pb->dummy_left).first(n_samples);
   }
 
   if (in_right != nullptr) {
     right_in = std::span(in_right, n_samples);
   } else {
-    right_in = d->pb->dummy_right;
+    right_in = std::span(d->pb->dummy_right).first(n_samples);
   }
 
   if (out_left != nullptr) {
     left_out = std::span(out_left, n_samples);
   } else {
-    left_out = d->pb->dummy_left;
+    left_out = std::span(d->pb->dummy_left).first(n_samples);
   }
 
   if (out_right != nullptr) {
     right_out = std::span(out_right, n_samples);
   } else {
-    right_out = d->pb->dummy_right;
+    right_out = std::span(d->pb->dummy_right).first(n_samples);
   }
 
-  if (!d->pb->enable_probe) {
-    d->pb->process(left_in, right_in, left_out, right_out);
-  } else {
-    auto* probe_left = static_cast<float*>(pw_filter_get_dsp_buffer(d->probe_left, n_samples));
-    auto* probe_right = static_cast<float*>(pw_filter_get_dsp_buffer(d->probe_right, n_samples));
+  std::span<float> probe_left;
+  std::span<float> probe_right;
 
-    if (probe_left == nullptr || probe_right == nullptr) {
-      std::span l(d->pb->dummy_left.data(), n_samples);
-      std::span r(d->pb->dummy_right.data(), n_samples);
+  if (d->pb->enable_probe) {
+    auto* p_left = static_cast<float*>(pw_filter_get_dsp_buffer(d->probe_left, n_samples));
+    auto* p_right = static_cast<float*>(pw_filter_get_dsp_buffer(d->probe_right, n_samples));
 
-      d->pb->process(left_in, right_in, left_out, right_out, l, r);
+    if (p_left == nullptr || p_right == nullptr) {
+      probe_left = std::span(d->pb->dummy_left).first(n_samples);
+      probe_right = std::span(d->pb->dummy_right).first(n_samples);
     } else {
-      std::span l(probe_left, n_samples);
-      std::span r(probe_right, n_samples);
-
-      d->pb->process(left_in, right_in, left_out, right_out, l, r);
+      probe_left = std::span(p_left, n_samples);
+      probe_right = std::span(p_right, n_samples);
     }
   }
 
+  d->pb->clock_position = position->clock.position;
+
+  d->pb->process_quantum(left_in, right_in, left_out, right_out, probe_left, probe_right);
+
+  d->pb->processing.store(false, std::memory_order_release);
+
   if (d->pb->send_notifications) {
     d->pb->clock_start = std::chrono::system_clock::now();
 
@@ -152,6 +389,10 @@ auto update_filter(struct spa_loop* loop, bool async, uint32_t seq, const void*
     -> int {
   auto* self = static_cast<PluginBase*>(user_data);
 
+  if (self->filter == nullptr) {
+    return 0;
+  }
+
   spa_process_latency_info latency_info{};
 
   latency_info.ns = static_cast<uint64_t>(self->latency_value * 1000000000.0F);
@@ -212,14 +453,10 @@ PluginBase::PluginBase(std::string tag,
       package(std::move(package)),
       pipeline_type(pipe_type),
       enable_probe(enable_probe),
-      settings(g_settings_new_with_path(schema.c_str(), schema_path.c_str())),
+      settings(settings_store::get(schema.c_str(), schema_path.c_str())),
       global_settings(g_settings_new(tags::app::id)),
       pm(pipe_manager) {
-  std::string description;
-
   if (name != "output_level" && name != "spectrum") {
-    description = tags::plugin_name::get_translated()[name];
-
     bypass = g_settings_get_boolean(settings, "bypass") != 0;
 
     gconnections.push_back(g_signal_connect(settings, "changed::bypass",
@@ -229,14 +466,38 @@ PluginBase::PluginBase(std::string tag,
                                               self->bypass = g_settings_get_boolean(settings, "bypass") != 0;
                                             }),
                                             this));
+  } else {
+    skip_silence = false;
+  }
+
+  if (uint pw_max_quantum = 0U; pm != nullptr && util::str_to_num(pm->default_max_quantum, pw_max_quantum)) {
+    max_quantum = std::max(max_quantum, pw_max_quantum);
+  }
+
+  // Allocated once so that quantum changes do not allocate in the realtime thread
+
+  dummy_left.resize(max_quantum, 0.0F);
+  dummy_right.resize(max_quantum, 0.0F);
+  mono_buffer.resize(max_quantum, 0.0F);
+
+  pf_data.pb = this;
+}
+
+void PluginBase::create_pw_filter() {
+  if (filter != nullptr) {
+    return;
+  }
+
+  std::string description;
+
+  if (name != "output_level" && name != "spectrum") {
+    description = tags::plugin_name::get_translated()[name];
   } else if (name == "output_level") {
     description = _("Output Level Meter");
   } else if (name == "spectrum") {
     description = _("Spectrum");
   }
 
-  pf_data.pb = this;
-
   const auto filter_name = "ee_" + log_tag.substr(0U, log_tag.size() - 2U) + "_" + name;
 
   pm->lock();
@@ -330,15 +591,19 @@ PluginBase::PluginBase(std::string tag,
 PluginBase::~PluginBase() {
   post_messages = false;
 
-  pm->lock();
+  Reconfigurator::get().remove(this);
 
-  if (listener.link.next != nullptr || listener.link.prev != nullptr) {
-    spa_hook_remove(&listener);
-  }
+  if (filter != nullptr) {
+    pm->lock();
 
-  pw_filter_destroy(filter);
+    if (listener.link.next != nullptr || listener.link.prev != nullptr) {
+      spa_hook_remove(&listener);
+    }
 
-  pm->sync_wait_unlock();
+    pw_filter_destroy(filter);
+
+    pm->sync_wait_unlock();
+  }
 
   for (auto& handler_id : gconnections) {
     g_signal_handler_disconnect(settings, handler_id);
@@ -346,9 +611,161 @@ PluginBase::~PluginBase() {
 
   gconnections.clear();
 
+  set_metering_taps(nullptr, nullptr);
+
   g_object_unref(settings);
 }
 
+void PluginBase::set_metering_taps(std::shared_ptr<MeteringTap> input, std::shared_ptr<MeteringTap> output) {
+  if (input != input_tap) {
+    for (const auto& feature : input_metering_features) {
+      if (input != nullptr) {
+        input->subscribe(feature);
+      }
+
+      if (input_tap != nullptr) {
+        input_tap->unsubscribe(feature);
+      }
+    }
+  }
+
+  /*
+    The taps are owned by the pipeline metering bus and are never destroyed while it exists, so the realtime thread
+    can still use the old pointers during the current cycle.
+  */
+
+  input_tap_ptr.store(input.get(), std::memory_order_release);
+  output_tap_ptr.store(output.get(), std::memory_order_release);
+
+  input_tap = std::move(input);
+  output_tap = std::move(output);
+}
+
+void PluginBase::subscribe_input_metering(const MeteringTap::Feature& feature) {
+  input_metering_features.push_back(feature);
+
+  if (input_tap != nullptr) {
+    input_tap->subscribe(feature);
+  }
+}
+
+void PluginBase::process_quantum(std::span<float> left_in,
+                                 std::span<float> right_in,
+                                 std::span<float> left_out,
+                                 std::span<float> right_out,
+                                 std::span<float> probe_left,
+                                 std::span<float> probe_right) {
+  analyze_input(left_in, right_in);
+
+  if (tail_has_decayed(left_in, right_in)) {
+    std::ranges::fill(left_out, 0.0F);
+    std::ranges::fill(right_out, 0.0F);
+
+    // the meters would stay frozen at their last values otherwise
+
+    if (post_messages) {
+      get_peaks(left_in, right_in, left_out, right_out);
+
+      if (send_notifications) {
+        reset_meters();
+
+        notify();
+      }
+    }
+  } else if (!enable_probe) {
+    process(left_in, right_in, left_out, right_out);
+  } else {
+    process(left_in, right_in, left_out, right_out, probe_left, probe_right);
+  }
+
+  apply_compensation_delay(left_out, right_out);
+
+  if (const auto gain = branch_gain.load(std::memory_order_relaxed); gain != 1.0F) {
+    apply_gain(left_out, right_out, gain);
+  }
+}
+
+void PluginBase::analyze_input(std::span<const float> left, std::span<const float> right) {
+  auto* tap = input_tap_ptr.load(std::memory_order_acquire);
+
+  if (tap == nullptr || (!post_messages && !tap->has_subscribers())) {
+    return;
+  }
+
+  tap->analyze(left, right, rate, clock_position);
+}
+
+void PluginBase::set_compensation_delay(const float& seconds) {
+  if (seconds == compensation_seconds) {
+    return;
+  }
+
+  std::unique_ptr<DelayLine> line;
+
+  if (seconds > 0.0F) {
+    line = std::make_unique<DelayLine>(
+        static_cast<uint>(std::ceil(seconds * static_cast<float>(max_compensation_rate))));
+  }
+
+  compensation_seconds = seconds;
+
+  compensation_line_ptr.store(line.get());
+
+  // The realtime thread may still be using the previous line. It is only destroyed after the current cycle is done.
+
+  while (compensation_busy.load()) {
+    std::this_thread::yield();
+  }
+
+  compensation_line = std::move(line);
+
+  util::debug(log_tag + name + " compensation delay: " + util::to_string(1000.0F * seconds, "") + " ms");
+}
+
+void PluginBase::set_branch_gain(const float& value) {
+  if (value == branch_gain) {
+    return;
+  }
+
+  branch_gain.store(value, std::memory_order_relaxed);
+
+  util::debug(log_tag + name + " branch gain: " + util::to_string(util::linear_to_db(value), "") + " dB");
+}
+
+void PluginBase::apply_compensation_delay(std::span<float>& left, std::span<float>& right) {
+  compensation_busy.store(true);
+
+  if (auto* line = compensation_line_ptr.load(); line != nullptr) {
+    line->process(left, right, static_cast<uint>(std::lround(compensation_seconds.load() * static_cast<float>(rate))));
+  }
+
+  compensation_busy.store(false);
+}
+
+auto PluginBase::tail_has_decayed(std::span<const float> left, std::span<const float> right) -> bool {
+  // the probe of the echo canceller may carry a signal while the microphone is silent
+
+  if (!skip_silence || enable_probe) {
+    return false;
+  }
+
+  if (absolute_peak(left) >= silence_threshold || absolute_peak(right) >= silence_threshold) {
+    silent_frames = 0U;
+
+    return false;
+  }
+
+  const auto tail = tail_value.load() + latency_value + compensation_seconds.load() + silence_margin;
+
+  if (silent_frames >= static_cast<uint64_t>(tail * static_cast<float>(rate))) {
+    return true;
+  }
+
+  silent_frames += left.size();
+
+  return false;
+}
+
 void PluginBase::set_post_messages(const bool& state) {
   post_messages = state;
 }
@@ -358,10 +775,14 @@ void PluginBase::reset_settings() {
 }
 
 auto PluginBase::connect_to_pw() -> bool {
+  create_pw_filter();
+
   connected_to_pw = false;
   can_get_node_id = false;
   state = PW_FILTER_STATE_UNCONNECTED;
 
+  Reconfigurator::get().add(this);
+
   pm->lock();
 
   if (pw_filter_connect(filter, PW_FILTER_FLAG_RT_PROCESS, nullptr, 0) != 0) {
@@ -436,11 +857,27 @@ void PluginBase::disconnect_from_pw() {
 
   pm->sync_wait_unlock();
 
+  Reconfigurator::get().remove(this);
+
   node_id = SPA_ID_INVALID;
 }
 
 void PluginBase::setup() {}
 
+void PluginBase::set_quantum_in_place(const uint& value) {
+  n_samples = value;
+
+  if (lv2_wrapper != nullptr) {
+    lv2_wrapper->set_n_samples(value);
+  }
+
+  applied_n_samples.store(value, std::memory_order_release);
+}
+
+void PluginBase::suspend() {}
+
+void PluginBase::resume() {}
+
 void PluginBase::process(std::span<float>& left_in,
                          std::span<float>& right_in,
                          std::span<float>& left_out,
@@ -457,6 +894,8 @@ auto PluginBase::get_latency_seconds() -> float {
   return 0.0F;
 }
 
+void PluginBase::reset_meters() {}
+
 void PluginBase::show_native_ui() {
   if (lv2_wrapper == nullptr) {
     return;
@@ -494,16 +933,35 @@ void PluginBase::get_peaks(const std::span<float>& left_in,
 
   // input level
 
-  float peak_l = std::ranges::max(left_in);
-  float peak_r = std::ranges::max(right_in);
+  float peak_l = 0.0F;
+  float peak_r = 0.0F;
+
+  if (auto* tap = input_tap_ptr.load(std::memory_order_acquire); tap != nullptr) {
+    // The tap measured the input before process() applied the input gain to it
+
+    peak_l = tap->get_peak(0U) * input_gain;
+    peak_r = tap->get_peak(1U) * input_gain;
+  } else {
+    peak_l = absolute_peak(left_in);
+    peak_r = absolute_peak(right_in);
+  }
 
   input_peak_left = (peak_l > input_peak_left) ? peak_l : input_peak_left;
   input_peak_right = (peak_r > input_peak_right) ? peak_r : input_peak_right;
 
   // output level
 
-  peak_l = std::ranges::max(left_out);
-  peak_r = std::ranges::max(right_out);
+  if (auto* tap = output_tap_ptr.load(std::memory_order_acquire); tap != nullptr) {
+    // The next node will find this analysis already done when it looks at its input
+
+    tap->analyze(left_out, right_out, rate, clock_position);
+
+    peak_l = tap->get_peak(0U);
+    peak_r = tap->get_peak(1U);
+  } else {
+    peak_l = absolute_peak(left_out);
+    peak_r = absolute_peak(right_out);
+  }
 
   output_peak_left = (peak_l > output_peak_left) ? peak_l : output_peak_left;
   output_peak_right = (peak_r > output_peak_right) ? peak_r : output_peak_right;
@@ -529,6 +987,81 @@ void PluginBase::setup_input_output_gain() {
                    this);
 }
 
+auto PluginBase::parse_channel_mode(const int& value) -> ChannelMode {
+  switch (value) {
+    case 1:
+      return ChannelMode::stereo;
+    case 2:
+      return ChannelMode::mono;
+    default:
+      return ChannelMode::automatic;
+  }
+}
+
+void PluginBase::setup_channel_mode() {
+  channel_mode = parse_channel_mode(g_settings_get_enum(settings, "channel-mode"));
+
+  gconnections.push_back(g_signal_connect(settings, "changed::channel-mode",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<PluginBase*>(user_data);
+
+                                            std::scoped_lock<std::mutex> lock(self->data_mutex);
+
+                                            self->channel_mode = parse_channel_mode(g_settings_get_enum(settings, key));
+
+                                            self->mono_frames = 0U;
+                                          }),
+                                          this));
+}
+
+auto PluginBase::use_mono_path(std::span<float>& left, std::span<float>& right) -> bool {
+  switch (channel_mode) {
+    case ChannelMode::stereo:
+      return false;
+    case ChannelMode::mono: {
+      // the downmix goes to our own buffer because the input may be read by other nodes
+
+      auto mixed = std::span(mono_buffer).first(left.size());
+
+      for (size_t n = 0U; n < left.size(); n++) {
+        mixed[n] = 0.5F * (left[n] + right[n]);
+      }
+
+      left = mixed;
+
+      return true;
+    }
+    default:
+      break;
+  }
+
+  // -60 dB of difference between the channels is inaudible after the noise suppression
+
+  float energy = 0.0F;
+  float difference = 0.0F;
+
+  for (size_t n = 0U; n < left.size(); n++) {
+    const auto d = left[n] - right[n];
+
+    energy += left[n] * left[n] + right[n] * right[n];
+    difference += d * d;
+  }
+
+  if (difference > 1e-6F * energy) {
+    mono_frames = 0U;
+
+    return false;
+  }
+
+  const auto hold_frames = rate / 2U;
+
+  if (mono_frames < hold_frames) {
+    mono_frames += static_cast<uint>(left.size());
+  }
+
+  return mono_frames >= hold_frames;
+}
+
 void PluginBase::apply_gain(std::span<float>& left, std::span<float>& right, const float& gain) {
   if (left.empty() || right.empty()) {
     return;
@@ -539,14 +1072,13 @@ void PluginBase::apply_gain(std::span<float>& left, std::span<float>& right, con
 }
 
 void PluginBase::notify() {
-  const auto input_peak_db_l = util::linear_to_db(input_peak_left);
-  const auto input_peak_db_r = util::linear_to_db(input_peak_right);
+  Event event{.type = Event::Type::levels,
+              .values = {util::linear_to_db(input_peak_left), util::linear_to_db(input_peak_right),
+                         util::linear_to_db(output_peak_left), util::linear_to_db(output_peak_right)}};
 
-  const auto output_peak_db_l = util::linear_to_db(output_peak_left);
-  const auto output_peak_db_r = util::linear_to_db(output_peak_right);
+  // if the main thread fell behind this update is lost, but the next one will arrive in a few milliseconds
 
-  input_level.emit(input_peak_db_l, input_peak_db_r);
-  output_level.emit(output_peak_db_l, output_peak_db_r);
+  events.push(event);
 
   input_peak_left = util::minimum_linear_level;
   input_peak_right = util::minimum_linear_level;
@@ -554,8 +1086,63 @@ void PluginBase::notify() {
   output_peak_right = util::minimum_linear_level;
 }
 
+void PluginBase::post_meters(const MeterValues& values) {
+  // like the levels, a lost update is replaced by the next one
+
+  events.push(Event{.type = Event::Type::meters, .values = values});
+}
+
+void PluginBase::emit_meters(const MeterValues& values) {}
+
+void PluginBase::notify_latency_change() {
+  latency_dirty.store(true, std::memory_order_release);
+}
+
+void PluginBase::dispatch_events() {
+  Event event;
+
+  std::optional<Event> new_levels;
+  std::optional<Event> new_meters;
+
+  while (events.pop(event)) {
+    switch (event.type) {
+      case Event::Type::levels:
+        new_levels = event;
+        break;
+      case Event::Type::meters:
+        new_meters = event;
+        break;
+    }
+  }
+
+  if (latency_dirty.exchange(false, std::memory_order_acq_rel)) {
+    util::debug(log_tag + name + " latency: " + util::to_string(latency_value.load(), "") + " s");
+
+    latency.emit();
+  }
+
+  if (new_meters.has_value()) {
+    emit_meters(new_meters->values);
+  }
+
+  if (new_levels.has_value()) {
+    for (size_t n = 0U; n < levels.size(); n++) {
+      levels[n] = static_cast<float>(new_levels->values[n]);
+    }
+
+    levels_serial++;
+
+    input_level.emit(levels[0], levels[1]);
+    output_level.emit(levels[2], levels[3]);
+  }
+}
+
 void PluginBase::update_probe_links() {}
 
 void PluginBase::update_filter_params() {
+  if (pm == nullptr || filter == nullptr) {
+    return;
+  }
+
   pw_loop_invoke(pw_thread_loop_get_loop(pm->thread_loop), update_filter, 1, nullptr, 0, false, this);
 }
@@ -21,6 +21,7 @@
 #include <gio/gio.h>
 #include <glib-object.h>
 #include "preset_type.hpp"
+#include "settings_store.hpp"
 #include "util.hpp"
 
 PluginPresetBase::PluginPresetBase(const char* schema_id,
@@ -33,12 +34,12 @@ PluginPresetBase::PluginPresetBase(const char* schema_id,
     case PresetType::input:
       section = "input";
 
-      settings = g_settings_new_with_path(schema_id, (schema_path_input + util::to_string(index) + "/").c_str());
+      settings = settings_store::get(schema_id, (schema_path_input + util::to_string(index) + "/").c_str());
       break;
     case PresetType::output:
       section = "output";
 
-      settings = g_settings_new_with_path(schema_id, (schema_path_output + util::to_string(index) + "/").c_str());
+      settings = settings_store::get(schema_id, (schema_path_output + util::to_string(index) + "/").c_str());
       break;
   }
 }
@@ -79,6 +79,7 @@
 #include "loudness_ui.hpp"
 #include "maximizer.hpp"
 #include "maximizer_ui.hpp"
+#include "meters_aggregator.hpp"
 #include "multiband_compressor.hpp"
 #include "multiband_compressor_ui.hpp"
 #include "multiband_gate.hpp"
@@ -91,6 +92,7 @@
 #include "reverb_ui.hpp"
 #include "rnnoise.hpp"
 #include "rnnoise_ui.hpp"
+#include "settings_store.hpp"
 #include "speex.hpp"
 #include "speex_ui.hpp"
 #include "stereo_tools.hpp"
@@ -114,6 +116,8 @@ struct Data {
 
   bool schedule_signal_idle = false;
 
+  guint tick_id = 0U;
+
   app::Application* application = nullptr;
 
   PipelineType pipeline_type{};
@@ -594,6 +598,12 @@ void on_next_plugin(PluginsBox* self, GtkButton* button) {
   show_adjacent_plugin(self, 1);
 }
 
+auto is_parallel(GSettings* settings, const char* name) -> bool {
+  const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "parallel-plugins"));
+
+  return std::ranges::find(list, name) != list.end();
+}
+
 void setup_listview(PluginsBox* self) {
   auto* factory = gtk_signal_list_item_factory_new();
 
@@ -607,6 +617,7 @@ void setup_listview(PluginsBox* self) {
         auto* plugin_enabled_icon = gtk_builder_get_object(builder, "plugin_enabled_icon");
         auto* plugin_bypassed_icon = gtk_builder_get_object(builder, "plugin_bypassed_icon");
         auto* remove = gtk_builder_get_object(builder, "remove");
+        auto* parallel = gtk_builder_get_object(builder, "parallel");
         auto* enable = gtk_builder_get_object(builder, "enable");
         auto* drag_handle = gtk_builder_get_object(builder, "drag_handle");
 
@@ -615,6 +626,7 @@ void setup_listview(PluginsBox* self) {
         g_object_set_data(G_OBJECT(item), "plugin_bypassed_icon", plugin_bypassed_icon);
         g_object_set_data(G_OBJECT(item), "name", gtk_builder_get_object(builder, "name"));
         g_object_set_data(G_OBJECT(item), "remove", remove);
+        g_object_set_data(G_OBJECT(item), "parallel", parallel);
         g_object_set_data(G_OBJECT(item), "enable", enable);
         g_object_set_data(G_OBJECT(item), "drag_handle", drag_handle);
 
@@ -627,12 +639,14 @@ void setup_listview(PluginsBox* self) {
         auto* controller = gtk_event_controller_motion_new();
 
         g_object_set_data(G_OBJECT(controller), "remove", remove);
+        g_object_set_data(G_OBJECT(controller), "parallel", parallel);
         g_object_set_data(G_OBJECT(controller), "enable", enable);
         g_object_set_data(G_OBJECT(controller), "drag_handle", drag_handle);
 
         g_signal_connect(controller, "enter",
                          G_CALLBACK(+[](GtkEventControllerMotion* controller, gdouble x, gdouble y, PluginsBox* self) {
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "remove")), 1.0);
+                           gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "parallel")), 1.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "enable")), 1.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "drag_handle")),
                                                   1.0);
@@ -640,7 +654,13 @@ void setup_listview(PluginsBox* self) {
                          self);
 
         g_signal_connect(controller, "leave", G_CALLBACK(+[](GtkEventControllerMotion* controller, PluginsBox* self) {
+                           auto* parallel = GTK_TOGGLE_BUTTON(g_object_get_data(G_OBJECT(controller), "parallel"));
+
+                           // a parallel effect keeps its button visible so that the branches can be seen in the list
+
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "remove")), 0.0);
+                           gtk_widget_set_opacity(GTK_WIDGET(parallel),
+                                                  gtk_toggle_button_get_active(parallel) != 0 ? 1.0 : 0.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "enable")), 0.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "drag_handle")),
                                                   0.0);
@@ -729,11 +749,66 @@ void setup_listview(PluginsBox* self) {
                                                        [=](const auto& plugin_name) { return plugin_name == name; }),
                                         list.end());
 
+                             // the page that owns the name is destroyed when the plugins key changes
+
+                             if (is_parallel(self->settings, name)) {
+                               auto parallel_list =
+                                   util::gchar_array_to_vector(g_settings_get_strv(self->settings, "parallel-plugins"));
+
+                               std::erase(parallel_list, name);
+
+                               g_settings_set_strv(self->settings, "parallel-plugins",
+                                                   util::make_gchar_pointer_vector(parallel_list).data());
+                             }
+
                              g_settings_set_strv(self->settings, "plugins",
                                                  util::make_gchar_pointer_vector(list).data());
                            }
                          }),
                          self);
+
+        g_signal_connect(parallel, "toggled", G_CALLBACK(+[](GtkToggleButton* btn, PluginsBox* self) {
+                           auto* name = static_cast<const char*>(g_object_get_data(G_OBJECT(btn), "page-name"));
+
+                           const auto active = gtk_toggle_button_get_active(btn) != 0;
+
+                           if (name == nullptr || active == is_parallel(self->settings, name)) {
+                             return;
+                           }
+
+                           auto list =
+                               util::gchar_array_to_vector(g_settings_get_strv(self->settings, "parallel-plugins"));
+
+                           if (active) {
+                             list.emplace_back(name);
+                           } else {
+                             std::erase(list, name);
+                           }
+
+                           g_settings_set_strv(self->settings, "parallel-plugins",
+                                               util::make_gchar_pointer_vector(list).data());
+                         }),
+                         self);
+
+        // presets can change the key without changing the plugins list, in which case the rows are not bound again
+
+        g_signal_connect_object(self->settings, "changed::parallel-plugins",
+                                G_CALLBACK(+[](GSettings* settings, char* key, GtkToggleButton* btn) {
+                                  auto* name = static_cast<const char*>(g_object_get_data(G_OBJECT(btn), "page-name"));
+
+                                  if (name == nullptr) {
+                                    return;
+                                  }
+
+                                  const auto active = is_parallel(settings, name);
+
+                                  gtk_toggle_button_set_active(btn, static_cast<gboolean>(active));
+
+                                  if (active) {
+                                    gtk_widget_set_opacity(GTK_WIDGET(btn), 1.0);
+                                  }
+                                }),
+                                parallel, static_cast<GConnectFlags>(0));
       }),
       self);
 
@@ -742,6 +817,7 @@ void setup_listview(PluginsBox* self) {
         auto* top_box = static_cast<GtkBox*>(g_object_get_data(G_OBJECT(item), "top_box"));
         auto* label = static_cast<GtkLabel*>(g_object_get_data(G_OBJECT(item), "name"));
         auto* remove = static_cast<GtkButton*>(g_object_get_data(G_OBJECT(item), "remove"));
+        auto* parallel = static_cast<GtkToggleButton*>(g_object_get_data(G_OBJECT(item), "parallel"));
         auto* enable = static_cast<GtkToggleButton*>(g_object_get_data(G_OBJECT(item), "enable"));
 
         auto* child_item = gtk_list_item_get_item(item);
@@ -752,6 +828,15 @@ void setup_listview(PluginsBox* self) {
 
         g_object_set_data(G_OBJECT(top_box), "page-name", const_cast<char*>(page_name));
         g_object_set_data(G_OBJECT(remove), "page-name", const_cast<char*>(page_name));
+        g_object_set_data(G_OBJECT(parallel), "page-name", const_cast<char*>(page_name));
+
+        gtk_toggle_button_set_active(parallel, static_cast<gboolean>(is_parallel(self->settings, page_name)));
+
+        // the first effect has nothing to run in parallel with
+
+        gtk_widget_set_sensitive(GTK_WIDGET(parallel), static_cast<gboolean>(gtk_list_item_get_position(item) > 0U));
+
+        gtk_widget_set_opacity(GTK_WIDGET(parallel), gtk_toggle_button_get_active(parallel) != 0 ? 1.0 : 0.0);
 
         gtk_label_set_text(label, self->data->translated[base_name].c_str());
 
@@ -769,7 +854,7 @@ void setup_listview(PluginsBox* self) {
 
         auto schema_id = tags::app::id + "."s + gname;
 
-        auto* settings = g_settings_new_with_path(schema_id.c_str(), schema_path.c_str());
+        auto* settings = settings_store::get(schema_id.c_str(), schema_path.c_str());
 
         gsettings_bind_widget(settings, "bypass", enable, G_SETTINGS_BIND_INVERT_BOOLEAN);
 
@@ -782,6 +867,14 @@ void setup_listview(PluginsBox* self) {
   g_object_unref(factory);
 }
 
+auto on_tick(GtkWidget* widget, GdkFrameClock* frame_clock, PluginsBox* self) -> gboolean {
+  // Only the visible page of the stack is mapped. The other plugin boxes are skipped.
+
+  ui::meters_aggregator::update(gtk_stack_get_visible_child(self->stack));
+
+  return G_SOURCE_CONTINUE;
+}
+
 void setup(PluginsBox* self, app::Application* application, PipelineType pipeline_type) {
   self->data->application = application;
   self->data->pipeline_type = pipeline_type;
@@ -836,6 +929,8 @@ void setup(PluginsBox* self, app::Application* application, PipelineType pipelin
   ui::plugins_menu::setup(self->plugins_menu, application, pipeline_type);
 
   setup_listview(self);
+
+  self->data->tick_id = gtk_widget_add_tick_callback(GTK_WIDGET(self), (GtkTickCallback)on_tick, self, nullptr);
 }
 
 void realize(GtkWidget* widget) {
@@ -871,6 +966,12 @@ void dispose(GObject* object) {
     plugin->set_post_messages(false);
   }
 
+  if (self->data->tick_id != 0U) {
+    gtk_widget_remove_tick_callback(GTK_WIDGET(self), self->data->tick_id);
+
+    self->data->tick_id = 0U;
+  }
+
   // Removing gsettings connections
 
   for (auto& c : self->data->connections) {
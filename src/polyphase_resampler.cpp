@@ -0,0 +1,348 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "polyphase_resampler.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numbers>
+#include <numeric>
+#include <span>
+
+namespace {
+
+// GCC and Clang vector extension. It is compiled to SSE on x86 and to NEON on ARM.
+using v4sf = float __attribute__((vector_size(16)));
+
+auto bessel_i0(const double& x) -> double {
+  double sum = 1.0;
+  double term = 1.0;
+
+  for (int k = 1; k < 50; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+
+    sum += term;
+
+    if (term < sum * 1e-12) {
+      break;
+    }
+  }
+
+  return sum;
+}
+
+struct QualityParameters {
+  uint taps;
+  double cutoff;
+  double beta;
+};
+
+auto get_quality_parameters(const PolyphaseResampler::Quality& quality) -> QualityParameters {
+  switch (quality) {
+    case PolyphaseResampler::Quality::fast:
+      return {.taps = 16U, .cutoff = 0.85, .beta = 6.0};
+    case PolyphaseResampler::Quality::best:
+      return {.taps = 64U, .cutoff = 0.95, .beta = 10.0};
+    default:
+      return {.taps = 32U, .cutoff = 0.91, .beta = 8.0};
+  }
+}
+
+}  // namespace
+
+PolyphaseResampler::PolyphaseResampler(const uint& input_rate,
+                                       const uint& output_rate,
+                                       const uint& max_input_frames,
+                                       const Quality& quality)
+    : max_input_frames(std::max(max_input_frames, 1U)) {
+  const auto divisor = std::gcd(std::max(input_rate, 1U), std::max(output_rate, 1U));
+
+  up = std::max(output_rate, 1U) / divisor;
+  down = std::max(input_rate, 1U) / divisor;
+
+  exact = up <= max_exact_phases;
+
+  n_phases = exact ? up : interpolated_phases;
+
+  design_filter(quality);
+
+  history.resize(n_taps - 1U + this->max_input_frames, 0.0F);
+
+  fixed_scratch.resize(get_max_output_frames(this->max_input_frames), 0.0F);
+
+  set_input_block_size(0U);
+}
+
+auto PolyphaseResampler::quality_from_int(const int& value) -> Quality {
+  switch (value) {
+    case 0:
+      return Quality::fast;
+    case 2:
+      return Quality::best;
+    default:
+      return Quality::balanced;
+  }
+}
+
+void PolyphaseResampler::design_filter(const Quality& quality) {
+  const auto params = get_quality_parameters(quality);
+
+  const double ratio = get_ratio();
+
+  // When downsampling the cutoff moves down, so the filter has to be longer to keep the same transition band
+
+  const double fc = params.cutoff * std::min(1.0, ratio);
+
+  n_taps = static_cast<uint>(std::ceil(static_cast<double>(params.taps) / std::min(1.0, ratio)));
+
+  n_taps = simd_width * ((n_taps + simd_width - 1U) / simd_width);
+
+  const auto length = static_cast<double>(n_taps) * static_cast<double>(n_phases);
+  const double center = 0.5 * length;
+  const double i0_beta = bessel_i0(params.beta);
+
+  auto prototype = [&](const double& j) {
+    if (j < 0.0 || j > length) {
+      return 0.0;
+    }
+
+    const double x = (j - center) / static_cast<double>(n_phases);
+
+    const double sinc = (x == 0.0) ? 1.0 : std::sin(std::numbers::pi * fc * x) / (std::numbers::pi * fc * x);
+
+    const double r = (j - center) / center;
+
+    const double window = bessel_i0(params.beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0_beta;
+
+    return fc * sinc * window;
+  };
+
+  // One extra row is used by the interpolated mode as the right neighbour of the last phase
+
+  coefficients.assign(static_cast<size_t>(n_phases + 1U) * n_taps, 0.0F);
+
+  for (uint p = 0U; p <= n_phases; p++) {
+    auto row = std::span(coefficients).subspan(static_cast<size_t>(p) * n_taps, n_taps);
+
+    double sum = 0.0;
+
+    for (uint k = 0U; k < n_taps; k++) {
+      sum += prototype(static_cast<double>(k) * n_phases + p);
+    }
+
+    // normalizing each phase removes the small gain ripple between phases
+
+    const double gain = (sum != 0.0) ? 1.0 / sum : 1.0;
+
+    for (uint k = 0U; k < n_taps; k++) {
+      // reversed so that the dot product walks the history forward
+
+      row[n_taps - 1U - k] = static_cast<float>(prototype(static_cast<double>(k) * n_phases + p) * gain);
+    }
+  }
+}
+
+void PolyphaseResampler::set_input_block_size(const uint& frames) {
+  input_block_size = frames;
+
+  const double ratio = get_ratio();
+
+  prime_frames = static_cast<uint>(std::ceil(static_cast<double>(input_block_size) * ratio) + std::ceil(ratio)) + 2U;
+
+  fixed_buffer.resize(2U * get_max_output_frames(max_input_frames) + prime_frames);
+
+  reset();
+}
+
+void PolyphaseResampler::reset() {
+  phase = 0U;
+
+  std::ranges::fill(history, 0.0F);
+  std::ranges::fill(fixed_buffer, 0.0F);
+
+  fixed_read = 0U;
+  fixed_count = prime_frames;
+}
+
+void PolyphaseResampler::copy_state(const PolyphaseResampler& other) {
+  // the buffers have the same sizes, so nothing is allocated
+
+  phase = other.phase;
+
+  std::ranges::copy(other.history, history.begin());
+  std::ranges::copy(other.fixed_buffer, fixed_buffer.begin());
+
+  fixed_read = other.fixed_read;
+  fixed_count = other.fixed_count;
+}
+
+auto PolyphaseResampler::get_output_frames(const size_t& n_input) const -> size_t {
+  const auto end = static_cast<uint64_t>(n_input) * up;
+
+  if (phase >= end) {
+    return 0U;
+  }
+
+  return static_cast<size_t>((end - phase + down - 1U) / down);
+}
+
+auto PolyphaseResampler::get_max_output_frames(const size_t& n_input) const -> size_t {
+  return static_cast<size_t>((static_cast<uint64_t>(n_input) * up + down - 1U) / down) + 1U;
+}
+
+auto PolyphaseResampler::get_latency_frames() const -> uint {
+  return static_cast<uint>(std::lround(0.5 * static_cast<double>(n_taps) * get_ratio()));
+}
+
+auto PolyphaseResampler::get_fixed_latency_frames() const -> uint {
+  return get_latency_frames() + prime_frames;
+}
+
+auto PolyphaseResampler::dot(const float* x, const float* h) const -> float {
+  v4sf acc0 = {0.0F, 0.0F, 0.0F, 0.0F};
+  v4sf acc1 = {0.0F, 0.0F, 0.0F, 0.0F};
+
+  uint k = 0U;
+
+  for (; k + 2U * simd_width <= n_taps; k += 2U * simd_width) {
+    v4sf x0;
+    v4sf x1;
+    v4sf h0;
+    v4sf h1;
+
+    std::memcpy(&x0, x + k, sizeof(v4sf));
+    std::memcpy(&x1, x + k + simd_width, sizeof(v4sf));
+    std::memcpy(&h0, h + k, sizeof(v4sf));
+    std::memcpy(&h1, h + k + simd_width, sizeof(v4sf));
+
+    acc0 += x0 * h0;
+    acc1 += x1 * h1;
+  }
+
+  for (; k < n_taps; k += simd_width) {
+    v4sf x0;
+    v4sf h0;
+
+    std::memcpy(&x0, x + k, sizeof(v4sf));
+    std::memcpy(&h0, h + k, sizeof(v4sf));
+
+    acc0 += x0 * h0;
+  }
+
+  acc0 += acc1;
+
+  return acc0[0] + acc0[1] + acc0[2] + acc0[3];
+}
+
+auto PolyphaseResampler::process(std::span<const float> input, std::span<float> output) -> size_t {
+  size_t n_out = 0U;
+
+  const auto n_history = static_cast<size_t>(n_taps) - 1U;
+
+  while (!input.empty()) {
+    const auto chunk = input.first(std::min(input.size(), static_cast<size_t>(max_input_frames)));
+
+    input = input.subspan(chunk.size());
+
+    std::ranges::copy(chunk, history.begin() + static_cast<std::ptrdiff_t>(n_history));
+
+    const auto end = static_cast<uint64_t>(chunk.size()) * up;
+
+    for (; phase < end; phase += down) {
+      const auto i = static_cast<size_t>(phase / up);
+      const auto frac = static_cast<uint>(phase % up);
+
+      float v = 0.0F;
+
+      if (exact) {
+        v = dot(history.data() + i, coefficients.data() + static_cast<size_t>(frac) * n_taps);
+      } else {
+        const auto pos = static_cast<uint64_t>(frac) * n_phases;
+
+        const auto p = static_cast<size_t>(pos / up);
+
+        const auto mu = static_cast<float>(pos % up) / static_cast<float>(up);
+
+        const auto v0 = dot(history.data() + i, coefficients.data() + p * n_taps);
+        const auto v1 = dot(history.data() + i, coefficients.data() + (p + 1U) * n_taps);
+
+        v = v0 + mu * (v1 - v0);
+      }
+
+      if (n_out < output.size()) {
+        output[n_out] = v;
+      }
+
+      n_out++;
+    }
+
+    phase -= end;
+
+    // keeping the last n_taps - 1 frames for the next call
+
+    std::copy(history.begin() + static_cast<std::ptrdiff_t>(chunk.size()),
+              history.begin() + static_cast<std::ptrdiff_t>(chunk.size() + n_history), history.begin());
+  }
+
+  return std::min(n_out, output.size());
+}
+
+void PolyphaseResampler::process_fixed(std::span<const float> input, std::span<float> output) {
+  const auto capacity = fixed_buffer.size();
+
+  while (!input.empty()) {
+    const auto chunk = input.first(std::min(input.size(), static_cast<size_t>(max_input_frames)));
+
+    input = input.subspan(chunk.size());
+
+    const auto n_new = process(chunk, fixed_scratch);
+
+    // dropping the oldest frames if the caller is feeding more than it consumes
+
+    if (fixed_count + n_new > capacity) {
+      const auto excess = fixed_count + n_new - capacity;
+
+      fixed_read = (fixed_read + excess) % capacity;
+      fixed_count -= std::min(excess, fixed_count);
+    }
+
+    for (size_t n = 0U; n < n_new; n++) {
+      fixed_buffer[(fixed_read + fixed_count + n) % capacity] = fixed_scratch[n];
+    }
+
+    fixed_count += n_new;
+  }
+
+  for (auto& v : output) {
+    if (fixed_count == 0U) {
+      v = 0.0F;
+
+      continue;
+    }
+
+    v = fixed_buffer[fixed_read];
+
+    fixed_read = (fixed_read + 1U) % capacity;
+
+    fixed_count--;
+  }
+}
@@ -39,10 +39,15 @@ struct _PreferencesGeneral {
   AdwPreferencesPage parent_instance;
 
   GtkSwitch *enable_autostart, *process_all_inputs, *process_all_outputs, *theme_switch, *shutdown_on_window_close,
-      *use_cubic_volumes, *inactivity_timer_enable, *autohide_popovers, *exclude_monitor_streams,
-      *show_native_plugin_ui;
+      *use_cubic_volumes, *inactivity_timer_enable, *idle_suspend_enable, *autohide_popovers, *exclude_monitor_streams,
+      *show_native_plugin_ui, *dsp_threads_realtime;
 
-  GtkSpinButton *inactivity_timeout, *meters_update_interval, *lv2ui_update_frequency;
+  GtkSpinButton *inactivity_timeout, *idle_suspend_timeout, *meters_update_interval, *lv2ui_update_frequency,
+      *dsp_threads, *dsp_threads_priority;
+
+  GtkEntry* dsp_threads_cpus;
+
+  AdwComboRow* resampler_quality;
 
   GSettings* settings;
 };
@@ -124,9 +129,16 @@ void preferences_general_class_init(PreferencesGeneralClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, exclude_monitor_streams);
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, inactivity_timer_enable);
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, inactivity_timeout);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, idle_suspend_enable);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, idle_suspend_timeout);
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, meters_update_interval);
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, lv2ui_update_frequency);
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, show_native_plugin_ui);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, resampler_quality);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, dsp_threads);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, dsp_threads_realtime);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, dsp_threads_priority);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, dsp_threads_cpus);
 }
 
 void preferences_general_init(PreferencesGeneral* self) {
@@ -135,6 +147,7 @@ void preferences_general_init(PreferencesGeneral* self) {
   self->settings = g_settings_new(tags::app::id);
 
   prepare_spinbuttons<"s">(self->inactivity_timeout);
+  prepare_spinbuttons<"s">(self->idle_suspend_timeout);
   prepare_spinbuttons<"ms">(self->meters_update_interval);
   prepare_spinbuttons<"Hz">(self->lv2ui_update_frequency);
 
@@ -149,6 +162,16 @@ void preferences_general_init(PreferencesGeneral* self) {
       self->inactivity_timer_enable, self->inactivity_timeout, self->meters_update_interval,
       self->lv2ui_update_frequency, self->show_native_plugin_ui);
 
+  gsettings_bind_widgets<"idle-suspend-enable", "idle-suspend-timeout">(self->settings, self->idle_suspend_enable,
+                                                                        self->idle_suspend_timeout);
+
+  ui::gsettings_bind_enum_to_combo_widget(self->settings, "resampler-quality", self->resampler_quality);
+
+  gsettings_bind_widgets<"dsp-threads", "dsp-threads-realtime", "dsp-threads-priority">(
+      self->settings, self->dsp_threads, self->dsp_threads_realtime, self->dsp_threads_priority);
+
+  g_settings_bind(self->settings, "dsp-threads-cpus", self->dsp_threads_cpus, "text", G_SETTINGS_BIND_DEFAULT);
+
 #ifdef ENABLE_LIBPORTAL
   libportal::init(self->enable_autostart, self->shutdown_on_window_close);
 #else
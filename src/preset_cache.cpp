@@ -0,0 +1,200 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "preset_cache.hpp"
+#include <glib.h>
+#include <sys/types.h>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "config.h"
+#include "util.hpp"
+
+namespace preset_cache {
+
+namespace {
+
+// version, json modification time, json size, plugins, parallel plugins, blocklist and the recorded plugin values
+
+constexpr auto image_format = "(sxtasasasa(sssv))";
+
+// Incremented when the content of the images changes, so that the ones written by older builds are compiled again
+
+constexpr auto image_revision = "2";
+
+auto get_image_version() -> std::string {
+  return std::string(VERSION) + "." + image_revision;
+}
+
+auto get_image_path(const std::filesystem::path& preset_file) -> std::filesystem::path {
+  std::stringstream name;
+
+  name << std::hex << std::hash<std::string>{}(std::filesystem::absolute(preset_file).string()) << ".gvariant";
+
+  return std::filesystem::path{g_get_user_cache_dir()} / "easyeffects" / "presets" / name.str();
+}
+
+auto get_stamp(const std::filesystem::path& preset_file, int64_t& mtime, uint64_t& size) -> bool {
+  std::error_code ec;
+
+  const auto time = std::filesystem::last_write_time(preset_file, ec);
+
+  if (ec) {
+    return false;
+  }
+
+  size = std::filesystem::file_size(preset_file, ec);
+
+  if (ec) {
+    return false;
+  }
+
+  mtime = time.time_since_epoch().count();
+
+  return true;
+}
+
+auto to_strv(const std::vector<std::string>& list) -> GVariant* {
+  return g_variant_new_strv(util::make_gchar_pointer_vector(list).data(), -1);
+}
+
+auto from_strv(GVariant* strv) -> std::vector<std::string> {
+  std::vector<std::string> list;
+
+  gsize length = 0U;
+
+  const auto** array = g_variant_get_strv(strv, &length);
+
+  for (gsize n = 0U; n < length; n++) {
+    list.emplace_back(array[n]);
+  }
+
+  g_free(static_cast<gpointer>(array));
+
+  g_variant_unref(strv);
+
+  return list;
+}
+
+}  // namespace
+
+auto load(const std::filesystem::path& preset_file) -> std::optional<Image> {
+  int64_t mtime = 0;
+  uint64_t size = 0U;
+
+  if (!get_stamp(preset_file, mtime, size)) {
+    return std::nullopt;
+  }
+
+  const auto image_path = get_image_path(preset_file);
+
+  gchar* contents = nullptr;
+  gsize length = 0U;
+
+  if (g_file_get_contents(image_path.c_str(), &contents, &length, nullptr) == 0) {
+    return std::nullopt;
+  }
+
+  auto* bytes = g_bytes_new_take(contents, length);
+
+  auto* root = g_variant_ref_sink(g_variant_new_from_bytes(G_VARIANT_TYPE(image_format), bytes, 0));
+
+  g_bytes_unref(bytes);
+
+  // the data comes from the disk, so it is validated before anything is read from it
+
+  if (g_variant_is_normal_form(root) == 0) {
+    g_variant_unref(root);
+
+    return std::nullopt;
+  }
+
+  const gchar* version = nullptr;
+  gint64 image_mtime = 0;
+  guint64 image_size = 0U;
+
+  g_variant_get_child(root, 0, "&s", &version);
+  g_variant_get_child(root, 1, "x", &image_mtime);
+  g_variant_get_child(root, 2, "t", &image_size);
+
+  if (version != get_image_version() || image_mtime != mtime || image_size != size) {
+    g_variant_unref(root);
+
+    return std::nullopt;
+  }
+
+  Image image;
+
+  image.plugins = from_strv(g_variant_get_child_value(root, 3));
+  image.parallel_plugins = from_strv(g_variant_get_child_value(root, 4));
+  image.blocklist = from_strv(g_variant_get_child_value(root, 5));
+  image.values = std::shared_ptr<GVariant>(g_variant_get_child_value(root, 6), g_variant_unref);
+
+  g_variant_unref(root);
+
+  return image;
+}
+
+void save(const std::filesystem::path& preset_file, const Image& image) {
+  int64_t mtime = 0;
+  uint64_t size = 0U;
+
+  if (!get_stamp(preset_file, mtime, size) || image.values == nullptr) {
+    return;
+  }
+
+  const auto image_path = get_image_path(preset_file);
+
+  try {
+    std::filesystem::create_directories(image_path.parent_path());
+  } catch (const std::exception& e) {
+    util::warning(e.what());
+
+    return;
+  }
+
+  const auto version = get_image_version();
+
+  auto* root = g_variant_ref_sink(g_variant_new("(sxt@as@as@as@a(sssv))", version.c_str(), static_cast<gint64>(mtime),
+                                                static_cast<guint64>(size), to_strv(image.plugins),
+                                                to_strv(image.parallel_plugins), to_strv(image.blocklist),
+                                                image.values.get()));
+
+  GError* error = nullptr;
+
+  if (g_file_set_contents(image_path.c_str(), static_cast<const gchar*>(g_variant_get_data(root)),
+                          static_cast<gssize>(g_variant_get_size(root)), &error) == 0) {
+    util::warning("could not write the preset cache " + image_path.string() + ": " + error->message);
+
+    g_error_free(error);
+  } else {
+    util::debug("compiled " + preset_file.string() + " to " + image_path.string());
+  }
+
+  g_variant_unref(root);
+}
+
+}  // namespace preset_cache
@@ -23,14 +23,17 @@
 #include <glib.h>
 #include <glib/gi18n.h>
 #include <sys/types.h>
+#include <algorithm>
 #include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <map>
 #include <memory>
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
 #include <ostream>
+#include <ranges>
 #include <regex>
 #include <stdexcept>
 #include <string>
@@ -51,6 +54,7 @@
 #include "equalizer_preset.hpp"
 #include "exciter_preset.hpp"
 #include "expander_preset.hpp"
+#include "file_catalogue.hpp"
 #include "filter_preset.hpp"
 #include "gate_preset.hpp"
 #include "level_meter_preset.hpp"
@@ -61,9 +65,11 @@
 #include "multiband_gate_preset.hpp"
 #include "pitch_preset.hpp"
 #include "plugin_preset_base.hpp"
+#include "preset_cache.hpp"
 #include "preset_type.hpp"
 #include "reverb_preset.hpp"
 #include "rnnoise_preset.hpp"
+#include "settings_store.hpp"
 #include "speex_preset.hpp"
 #include "stereo_tools_preset.hpp"
 #include "tags_app.hpp"
@@ -113,6 +119,9 @@ PresetsManager::PresetsManager()
   create_user_directory(autoload_input_dir);
   create_user_directory(autoload_output_dir);
 
+  load_autoload_profiles(PresetType::input);
+  load_autoload_profiles(PresetType::output);
+
   auto* gfile = g_file_new_for_path(user_output_dir.c_str());
 
   user_output_monitor = g_file_monitor_directory(gfile, G_FILE_MONITOR_NONE, nullptr, nullptr);
@@ -186,10 +195,22 @@ PresetsManager::PresetsManager()
                                   gpointer user_data) {
                      auto* self = static_cast<PresetsManager*>(user_data);
 
-                     if (event_type == G_FILE_MONITOR_EVENT_CREATED || event_type == G_FILE_MONITOR_EVENT_DELETED) {
-                       const auto profiles = self->get_autoload_profiles(PresetType::input);
+                     if (event_type == G_FILE_MONITOR_EVENT_CREATED || event_type == G_FILE_MONITOR_EVENT_DELETED ||
+                         event_type == G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT) {
+                       auto* path = g_file_get_path(file);
+
+                       // a new file is usually only readable when its changes are done
+
+                       const auto changed = self->update_autoload_profile(PresetType::input, path,
+                                                                          event_type == G_FILE_MONITOR_EVENT_DELETED);
+
+                       g_free(path);
+
+                       if (changed) {
+                         const auto profiles = self->get_autoload_profiles(PresetType::input);
 
-                       self->autoload_input_profiles_changed.emit(profiles);
+                         self->autoload_input_profiles_changed.emit(profiles);
+                       }
                      }
                    }),
                    this);
@@ -205,10 +226,22 @@ PresetsManager::PresetsManager()
                                   gpointer user_data) {
                      auto* self = static_cast<PresetsManager*>(user_data);
 
-                     if (event_type == G_FILE_MONITOR_EVENT_CREATED || event_type == G_FILE_MONITOR_EVENT_DELETED) {
-                       const auto profiles = self->get_autoload_profiles(PresetType::output);
+                     if (event_type == G_FILE_MONITOR_EVENT_CREATED || event_type == G_FILE_MONITOR_EVENT_DELETED ||
+                         event_type == G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT) {
+                       auto* path = g_file_get_path(file);
+
+                       // a new file is usually only readable when its changes are done
+
+                       const auto changed = self->update_autoload_profile(PresetType::output, path,
+                                                                          event_type == G_FILE_MONITOR_EVENT_DELETED);
+
+                       g_free(path);
 
-                       self->autoload_output_profiles_changed.emit(profiles);
+                       if (changed) {
+                         const auto profiles = self->get_autoload_profiles(PresetType::output);
+
+                         self->autoload_output_profiles_changed.emit(profiles);
+                       }
                      }
                    }),
                    this);
@@ -300,80 +333,20 @@ void PresetsManager::add(const PresetType& preset_type, const std::string& name)
 auto PresetsManager::get_all_community_presets_paths(const PresetType& preset_type) -> std::vector<std::string> {
   std::vector<std::string> cp_paths;
 
-  const auto scan_level = 2U;
+  // The package folders and their subfolders are scanned. Files placed directly in the data directory are ignored.
+
+  const auto scan_level = 3U;
 
   const auto cp_dir_vect = (preset_type == PresetType::output) ? system_data_dir_output : system_data_dir_input;
 
   for (const auto& cp_dir : cp_dir_vect) {
-    auto cp_fs_path = std::filesystem::path{cp_dir};
-
-    if (!std::filesystem::exists(cp_fs_path)) {
-      continue;
-    }
-
-    // Scan community package directories for 2 levels (the folder itself and only its subfolders).
-    auto it = std::filesystem::directory_iterator{cp_fs_path};
-
-    try {
-      while (it != std::filesystem::directory_iterator{}) {
-        if (auto package_path = it->path(); std::filesystem::is_directory(it->status())) {
-          const auto package_path_name = package_path.string();
-
-          util::debug("scan directory for community presets: " + package_path_name);
-
-          auto package_it = std::filesystem::directory_iterator{package_path};
-
-          /* When C++23 is available, the following line is enough:
-          cp_paths.append_range(
-              scan_community_package_recursive(package_it, scan_level, package_path_name));
-          */
-
-          const auto sub_cp_vect = scan_community_package_recursive(package_it, scan_level, package_path_name);
-
-          cp_paths.insert(cp_paths.end(), sub_cp_vect.cbegin(), sub_cp_vect.cend());
-        }
-
-        ++it;
-      }
-    } catch (const std::exception& e) {
-      util::warning(e.what());
-    }
-  }
-
-  return cp_paths;
-}
-
-auto PresetsManager::scan_community_package_recursive(std::filesystem::directory_iterator& it,
-                                                      const uint& top_scan_level,
-                                                      const std::string& origin) -> std::vector<std::string> {
-  const auto scan_level = top_scan_level - 1U;
-
-  std::vector<std::string> cp_paths;
-
-  try {
-    while (it != std::filesystem::directory_iterator{}) {
-      if (std::filesystem::is_regular_file(it->status()) && it->path().extension().c_str() == json_ext) {
-        cp_paths.emplace_back(origin + "/" + it->path().stem().c_str());
-      } else if (scan_level > 0U && std::filesystem::is_directory(it->status())) {
-        if (auto path = it->path(); !path.empty()) {
-          auto subdir_it = std::filesystem::directory_iterator{path};
-
-          /* When C++23 is available, the following line is enough:
-          cp_paths.append_range(
-              scan_community_package_recursive(subdir_it, scan_level, origin + "/" + path.filename().c_str()));
-          */
-
-          const auto sub_cp_vect =
-              scan_community_package_recursive(subdir_it, scan_level, origin + "/" + path.filename().c_str());
-
-          cp_paths.insert(cp_paths.end(), sub_cp_vect.cbegin(), sub_cp_vect.cend());
-        }
+    for (const auto& file : file_catalogue::list(std::filesystem::path{cp_dir}, json_ext, scan_level)) {
+      if (file.parent_path().empty()) {
+        continue;
       }
 
-      ++it;
+      cp_paths.emplace_back(cp_dir + "/" + (file.parent_path() / file.stem()).string());
     }
-  } catch (const std::exception& e) {
-    util::warning(e.what());
   }
 
   return cp_paths;
@@ -523,6 +496,19 @@ auto PresetsManager::load_blocklist(const PresetType& preset_type, const nlohman
   return true;
 }
 
+auto PresetsManager::get_parallel_plugins(GSettings* settings, const std::vector<std::string>& plugins)
+    -> std::vector<std::string> {
+  std::vector<std::string> list;
+
+  for (const auto& name : util::gchar_array_to_vector(g_settings_get_strv(settings, "parallel-plugins"))) {
+    if (std::ranges::find(plugins, name) != plugins.end()) {
+      list.push_back(name);
+    }
+  }
+
+  return list;
+}
+
 void PresetsManager::save_preset_file(const PresetType& preset_type, const std::string& name) {
   nlohmann::json json;
 
@@ -544,6 +530,8 @@ void PresetsManager::save_preset_file(const PresetType& preset_type, const std::
 
       json["output"]["plugins_order"] = list;
 
+      json["output"]["plugins_parallel"] = get_parallel_plugins(soe_settings, plugins);
+
       write_plugins_preset(preset_type, plugins, json);
 
       output_file = user_output_dir / std::filesystem::path{name + json_ext};
@@ -563,6 +551,8 @@ void PresetsManager::save_preset_file(const PresetType& preset_type, const std::
 
       json["input"]["plugins_order"] = list;
 
+      json["input"]["plugins_parallel"] = get_parallel_plugins(sie_settings, plugins);
+
       write_plugins_preset(preset_type, plugins, json);
 
       output_file = user_input_dir / std::filesystem::path{name + json_ext};
@@ -661,6 +651,12 @@ auto PresetsManager::load_community_preset_file(const PresetType& preset_type,
 }
 
 auto PresetsManager::load_preset_file(const PresetType& preset_type, const std::filesystem::path& input_file) -> bool {
+  if (load_compiled_preset(preset_type, input_file)) {
+    util::debug("successfully loaded the compiled preset: " + input_file.string());
+
+    return true;
+  }
+
   nlohmann::json json;
 
   std::vector<std::string> plugins;
@@ -670,17 +666,58 @@ auto PresetsManager::load_preset_file(const PresetType& preset_type, const std::
     return false;
   }
 
+  // The plugin keys written from now on are the ones that go to the compiled preset
+
+  settings_store::start_recording();
+
   // After the plugin order list, load the blocklist and then
   // apply the parameters of the loaded plugins.
   if (load_blocklist(preset_type, json) && read_plugins_preset(preset_type, plugins, json)) {
+    compile_preset(preset_type, input_file);
+
     util::debug("successfully loaded the preset: " + input_file.string());
 
     return true;
   }
 
+  g_variant_unref(settings_store::stop_recording());
+
   return false;
 }
 
+auto PresetsManager::load_compiled_preset(const PresetType& preset_type, const std::filesystem::path& input_file)
+    -> bool {
+  const auto image = preset_cache::load(input_file);
+
+  if (!image.has_value() || !settings_store::is_valid(image->values.get())) {
+    return false;
+  }
+
+  GSettings* settings = (preset_type == PresetType::input) ? sie_settings : soe_settings;
+
+  g_settings_set_strv(settings, "parallel-plugins", util::make_gchar_pointer_vector(image->parallel_plugins).data());
+  g_settings_set_strv(settings, "plugins", util::make_gchar_pointer_vector(image->plugins).data());
+  g_settings_set_strv(settings, "blocklist", util::make_gchar_pointer_vector(image->blocklist).data());
+
+  settings_store::apply(image->values.get());
+
+  return true;
+}
+
+void PresetsManager::compile_preset(const PresetType& preset_type, const std::filesystem::path& input_file) {
+  GSettings* settings = (preset_type == PresetType::input) ? sie_settings : soe_settings;
+
+  preset_cache::Image image;
+
+  image.values = std::shared_ptr<GVariant>(settings_store::stop_recording(), g_variant_unref);
+
+  image.plugins = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+  image.parallel_plugins = util::gchar_array_to_vector(g_settings_get_strv(settings, "parallel-plugins"));
+  image.blocklist = util::gchar_array_to_vector(g_settings_get_strv(settings, "blocklist"));
+
+  preset_cache::save(input_file, image);
+}
+
 auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_type,
                                                        const std::filesystem::path& input_file,
                                                        nlohmann::json& json,
@@ -689,11 +726,17 @@ auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_
 
   GSettings* settings = (preset_type == PresetType::input) ? sie_settings : soe_settings;
 
+  std::vector<std::string> parallel_plugins;
+
   try {
     std::ifstream is(input_file);
 
     is >> json;
 
+    // Presets saved before parallel plugins were supported do not have this key
+
+    parallel_plugins = json.at(preset_type_str).value("plugins_parallel", std::vector<std::string>());
+
     for (const auto& p : json.at(preset_type_str).at("plugins_order").get<std::vector<std::string>>()) {
       for (const auto& v : tags::plugin_name::list) {
         if (p.starts_with(v)) {
@@ -724,6 +767,7 @@ auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_
     return false;
   }
 
+  g_settings_set_strv(settings, "parallel-plugins", util::make_gchar_pointer_vector(parallel_plugins).data());
   g_settings_set_strv(settings, "plugins", util::make_gchar_pointer_vector(plugins).data());
 
   return true;
@@ -827,7 +871,9 @@ auto PresetsManager::import_addons_from_community_package(const PresetType& pres
       bool found = false;
 
       for (const auto& xdg_dir : system_data_dir_irs) {
-        if (util::search_filename(std::filesystem::path{xdg_dir + "/" + package}, irs_name, path, 3U)) {
+        path = file_catalogue::find(std::filesystem::path{xdg_dir + "/" + package}, irs_name, 3U);
+
+        if (!path.empty()) {
           const auto out_path = std::filesystem::path{user_irs_dir} / irs_name;
 
           std::filesystem::copy_file(path, out_path, std::filesystem::copy_options::overwrite_existing);
@@ -853,7 +899,9 @@ auto PresetsManager::import_addons_from_community_package(const PresetType& pres
       bool found = false;
 
       for (const auto& xdg_dir : system_data_dir_rnnoise) {
-        if (util::search_filename(std::filesystem::path{xdg_dir + "/" + package}, model_name, path, 3U)) {
+        path = file_catalogue::find(std::filesystem::path{xdg_dir + "/" + package}, model_name, 3U);
+
+        if (!path.empty()) {
           const auto out_path = std::filesystem::path{user_rnnoise_dir} / model_name;
 
           std::filesystem::copy_file(path, out_path, std::filesystem::copy_options::overwrite_existing);
@@ -989,6 +1037,13 @@ void PresetsManager::add_autoload(const PresetType& preset_type,
 
   o << std::setw(4) << json << '\n';
 
+  // The index is updated right away. The file monitor will only confirm it.
+
+  get_autoload_map(preset_type)[device_name + ":" + device_profile] = {.device = device_name,
+                                                                      .device_description = device_description,
+                                                                      .device_profile = device_profile,
+                                                                      .preset_name = preset_name};
+
   util::debug("added autoload preset file: " + output_file.string());
 }
 
@@ -1007,17 +1062,17 @@ void PresetsManager::remove_autoload(const PresetType& preset_type,
       break;
   }
 
-  if (!std::filesystem::is_regular_file(input_file)) {
-    return;
-  }
+  auto& profiles = get_autoload_map(preset_type);
 
-  nlohmann::json json;
+  auto it = profiles.find(device_name + ":" + device_profile);
 
-  std::ifstream is(input_file);
+  if (it == profiles.end()) {
+    return;
+  }
 
-  is >> json;
+  if (preset_name == it->second.preset_name && device_profile == it->second.device_profile) {
+    profiles.erase(it);
 
-  if (preset_name == json.value("preset-name", "") && device_profile == json.value("device-profile", "")) {
     std::filesystem::remove(input_file);
 
     util::debug("removed autoload: " + input_file.string());
@@ -1027,28 +1082,13 @@ void PresetsManager::remove_autoload(const PresetType& preset_type,
 auto PresetsManager::find_autoload(const PresetType& preset_type,
                                    const std::string& device_name,
                                    const std::string& device_profile) -> std::string {
-  std::filesystem::path input_file;
-
-  switch (preset_type) {
-    case PresetType::output:
-      input_file = autoload_output_dir / std::filesystem::path{device_name + ":" + device_profile + json_ext};
-      break;
-    case PresetType::input:
-      input_file = autoload_input_dir / std::filesystem::path{device_name + ":" + device_profile + json_ext};
-      break;
-  }
+  const auto& profiles = get_autoload_map(preset_type);
 
-  if (!std::filesystem::is_regular_file(input_file)) {
-    return "";
+  if (auto it = profiles.find(device_name + ":" + device_profile); it != profiles.end()) {
+    return it->second.preset_name;
   }
 
-  nlohmann::json json;
-
-  std::ifstream is(input_file);
-
-  is >> json;
-
-  return json.value("preset-name", "");
+  return "";
 }
 
 void PresetsManager::autoload(const PresetType& preset_type,
@@ -1066,44 +1106,84 @@ void PresetsManager::autoload(const PresetType& preset_type,
 }
 
 auto PresetsManager::get_autoload_profiles(const PresetType& preset_type) -> std::vector<nlohmann::json> {
-  std::filesystem::path autoload_dir;
   std::vector<nlohmann::json> list;
 
-  switch (preset_type) {
-    case PresetType::output:
-      autoload_dir = autoload_output_dir;
+  for (const auto& profile : get_autoload_map(preset_type) | std::views::values) {
+    nlohmann::json json;
 
-      break;
-    case PresetType::input:
-      autoload_dir = autoload_input_dir;
-      break;
+    json["device"] = profile.device;
+    json["device-description"] = profile.device_description;
+    json["device-profile"] = profile.device_profile;
+    json["preset-name"] = profile.preset_name;
+
+    list.push_back(json);
   }
 
-  auto it = std::filesystem::directory_iterator{autoload_dir};
+  return list;
+}
+
+auto PresetsManager::get_autoload_map(const PresetType& preset_type) -> std::map<std::string, AutoloadProfile>& {
+  return (preset_type == PresetType::output) ? autoload_output_profiles : autoload_input_profiles;
+}
+
+void PresetsManager::load_autoload_profiles(const PresetType& preset_type) {
+  const auto autoload_dir = (preset_type == PresetType::output) ? autoload_output_dir : autoload_input_dir;
+
+  get_autoload_map(preset_type).clear();
 
   try {
-    while (it != std::filesystem::directory_iterator{}) {
-      if (std::filesystem::is_regular_file(it->status())) {
-        if (it->path().extension().c_str() == json_ext) {
-          nlohmann::json json;
+    for (const auto& entry : std::filesystem::directory_iterator{autoload_dir}) {
+      update_autoload_profile(preset_type, entry.path(), false);
+    }
+  } catch (const std::exception& e) {
+    util::warning(e.what());
+  }
 
-          std::ifstream is(autoload_dir / it->path());
+  util::debug("indexed " + util::to_string(get_autoload_map(preset_type).size()) + " autoload profiles in " +
+              autoload_dir.string());
+}
 
-          is >> json;
+auto PresetsManager::update_autoload_profile(const PresetType& preset_type,
+                                             const std::filesystem::path& path,
+                                             const bool& removed) -> bool {
+  if (path.extension().c_str() != json_ext) {
+    return false;
+  }
 
-          list.push_back(json);
-        }
-      }
+  auto& profiles = get_autoload_map(preset_type);
 
-      ++it;
+  const auto key = path.stem().string();
+
+  if (removed || !std::filesystem::is_regular_file(path)) {
+    return profiles.erase(key) > 0U;
+  }
+
+  // A file that was just created may still be empty. It is read again when the changes are done.
+
+  try {
+    nlohmann::json json;
+
+    std::ifstream is(path);
+
+    is >> json;
+
+    const AutoloadProfile profile{.device = json.value("device", ""),
+                                  .device_description = json.value("device-description", ""),
+                                  .device_profile = json.value("device-profile", ""),
+                                  .preset_name = json.value("preset-name", "")};
+
+    if (auto it = profiles.find(key); it != profiles.end() && it->second == profile) {
+      return false;
     }
 
-    return list;
-  } catch (const std::exception& e) {
-    util::warning(e.what());
+    profiles[key] = profile;
 
-    return list;
+    return true;
+  } catch (const std::exception& e) {
+    util::debug("could not read the autoload file " + path.string() + ": " + e.what());
   }
+
+  return false;
 }
 
 void PresetsManager::set_last_preset_keys(const PresetType& preset_type,
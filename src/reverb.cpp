@@ -18,6 +18,9 @@
  */
 
 #include "reverb.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
 #include <algorithm>
 #include <memory>
 #include <span>
@@ -44,6 +47,8 @@ Reverb::Reverb(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://calf.sourceforge.net/plugins/Reverb is not installed");
   }
@@ -67,9 +72,28 @@ Reverb::Reverb(const std::string& tag,
 
   lv2_wrapper->bind_key_double_db<"dry", "dry", false>(settings);
 
+  update_tail();
+
+  for (const auto* key : {"changed::decay-time", "changed::predelay"}) {
+    gconnections.push_back(g_signal_connect(settings, key,
+                                            G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                              auto* self = static_cast<Reverb*>(user_data);
+
+                                              self->update_tail();
+                                            }),
+                                            this));
+  }
+
   setup_input_output_gain();
 }
 
+void Reverb::update_tail() {
+  // The decay time is the time the reverb takes to fall by 60 dB. Twice that is below the silence threshold.
+
+  tail_value = static_cast<float>(2.0 * g_settings_get_double(settings, "decay-time") +
+                                  0.001 * g_settings_get_double(settings, "predelay"));
+}
+
 Reverb::~Reverb() {
   if (connected_to_pw) {
     disconnect_from_pw();
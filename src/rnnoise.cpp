@@ -32,9 +32,10 @@
 #include <mutex>
 #include <span>
 #include <string>
+#include "file_catalogue.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
-#include "resampler.hpp"
+#include "polyphase_resampler.hpp"
 #include "tags_plugin_name.hpp"
 #include "tags_resources.hpp"
 #include "util.hpp"
@@ -192,13 +193,58 @@ void RNNoise::setup() {
   deque_out_L.resize(0U);
   deque_out_R.resize(0U);
 
-  resampler_inL = std::make_unique<Resampler>(rate, rnnoise_rate);
-  resampler_inR = std::make_unique<Resampler>(rate, rnnoise_rate);
+  if (!resample) {
+    return;
+  }
+
+  /*
+    The resamplers preallocate all their buffers. This is done in the main thread so that the realtime thread does not
+    have to wait for it.
+  */
+
+  util::idle_add([&, this] {
+    if (resampler_ready) {
+      return;
+    }
+
+    const auto quality =
+        PolyphaseResampler::quality_from_int(g_settings_get_enum(global_settings, "resampler-quality"));
+
+    const auto max_frames = std::max(n_samples, PolyphaseResampler::default_max_input_frames);
+
+    auto inL = std::make_unique<PolyphaseResampler>(rate, rnnoise_rate, max_frames, quality);
+    auto inR = std::make_unique<PolyphaseResampler>(rate, rnnoise_rate, max_frames, quality);
+
+    // rnnoise output arrives in blocks of blocksize frames
+
+    const auto max_resampled_frames = static_cast<uint>(inL->get_max_output_frames(max_frames));
+
+    auto outL = std::make_unique<PolyphaseResampler>(rnnoise_rate, rate, max_resampled_frames + blocksize, quality);
+    auto outR = std::make_unique<PolyphaseResampler>(rnnoise_rate, rate, max_resampled_frames + blocksize, quality);
 
-  resampler_outL = std::make_unique<Resampler>(rnnoise_rate, rate);
-  resampler_outR = std::make_unique<Resampler>(rnnoise_rate, rate);
+    outL->set_input_block_size(blocksize);
+    outR->set_input_block_size(blocksize);
 
-  resampler_ready = true;
+    std::scoped_lock<std::mutex> lock(data_mutex);
+
+    resampled_in_L.resize(max_resampled_frames);
+    resampled_in_R.resize(max_resampled_frames);
+
+    resampled_data_L.reserve(max_resampled_frames + blocksize);
+    resampled_data_R.reserve(max_resampled_frames + blocksize);
+
+    latency_value = static_cast<float>(inL->get_latency_frames()) / static_cast<float>(rnnoise_rate) +
+                    static_cast<float>(outL->get_fixed_latency_frames()) / static_cast<float>(rate);
+
+    resampler_inL = std::move(inL);
+    resampler_inR = std::move(inR);
+    resampler_outL = std::move(outL);
+    resampler_outR = std::move(outR);
+
+    notify_latency = true;
+
+    resampler_ready = true;
+  });
 }
 
 void RNNoise::process(std::span<float>& left_in,
@@ -218,74 +264,83 @@ void RNNoise::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
+  const bool mono = use_mono_path(left_in, right_in);
+
   if (resample) {
     if (resampler_ready) {
-      const auto resampled_inL = resampler_inL->process(left_in, false);
-      const auto resampled_inR = resampler_inR->process(right_in, false);
+      // In mono mode the right resamplers are skipped. They continue from the state of the left ones, that carried
+      // the same signal, when the stereo path is used again.
+
+      if (!mono && mono_resampling) {
+        resampler_inR->copy_state(*resampler_inL);
+        resampler_outR->copy_state(*resampler_outL);
+      }
+
+      mono_resampling = mono;
+
+      const auto n_resampled_L = resampler_inL->process(left_in, resampled_in_L);
+      const auto n_resampled_R = mono ? 0U : resampler_inR->process(right_in, resampled_in_R);
 
       resampled_data_L.resize(0U);
       resampled_data_R.resize(0U);
 
 #ifdef ENABLE_RNNOISE
-      remove_noise(resampled_inL, resampled_inR, resampled_data_L, resampled_data_R);
+      remove_noise(std::span(resampled_in_L).first(n_resampled_L), std::span(resampled_in_R).first(n_resampled_R),
+                   resampled_data_L, resampled_data_R, mono);
 #endif
 
-      auto resampled_outL = resampler_outL->process(resampled_data_L, false);
-      auto resampled_outR = resampler_outR->process(resampled_data_R, false);
+      // the output resamplers always produce one full quantum with a constant latency
 
-      for (const auto& v : resampled_outL) {
-        deque_out_L.push_back(v);
-      }
+      resampler_outL->process_fixed(resampled_data_L, left_out);
 
-      for (const auto& v : resampled_outR) {
-        deque_out_R.push_back(v);
+      if (mono) {
+        std::ranges::copy(left_out, right_out.begin());
+      } else {
+        resampler_outR->process_fixed(resampled_data_R, right_out);
       }
     } else {
-      for (const auto& v : left_in) {
-        deque_out_L.push_back(v);
-      }
-
-      for (const auto& v : right_in) {
-        deque_out_R.push_back(v);
-      }
+      std::copy(left_in.begin(), left_in.end(), left_out.begin());
+      std::copy(right_in.begin(), right_in.end(), right_out.begin());
     }
   } else {
 #ifdef ENABLE_RNNOISE
-    remove_noise(left_in, right_in, deque_out_L, deque_out_R);
+    remove_noise(left_in, right_in, deque_out_L, deque_out_R, mono);
 #endif
-  }
 
-  if (deque_out_L.size() >= left_out.size()) {
-    for (float& v : left_out) {
-      v = deque_out_L.front();
+    if (deque_out_L.size() >= left_out.size()) {
+      for (float& v : left_out) {
+        v = deque_out_L.front();
 
-      deque_out_L.pop_front();
-    }
+        deque_out_L.pop_front();
+      }
 
-    for (float& v : right_out) {
-      v = deque_out_R.front();
+      for (float& v : right_out) {
+        v = deque_out_R.front();
 
-      deque_out_R.pop_front();
-    }
-  } else {
-    const uint offset = 2U * (left_out.size() - deque_out_L.size());
+        deque_out_R.pop_front();
+      }
+    } else {
+      const uint offset = 2U * (left_out.size() - deque_out_L.size());
 
-    if (offset != latency_n_frames) {
-      latency_n_frames = offset;
+      if (offset != latency_n_frames) {
+        latency_n_frames = offset;
 
-      notify_latency = true;
-    }
+        latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-    for (uint n = 0U; !deque_out_L.empty() && n < left_out.size(); n++) {
-      if (n < offset) {
-        left_out[n] = 0.0F;
-        right_out[n] = 0.0F;
-      } else {
-        left_out[n] = deque_out_L.front();
-        right_out[n] = deque_out_R.front();
+        notify_latency = true;
+      }
 
-        deque_out_R.pop_front();
-        deque_out_L.pop_front();
+      for (uint n = 0U; !deque_out_L.empty() && n < left_out.size(); n++) {
+        if (n < offset) {
+          left_out[n] = 0.0F;
+          right_out[n] = 0.0F;
+        } else {
+          left_out[n] = deque_out_L.front();
+          right_out[n] = deque_out_R.front();
+
+          deque_out_R.pop_front();
+          deque_out_L.pop_front();
+        }
       }
     }
   }
@@ -295,17 +350,7 @@ void RNNoise::process(std::span<float>& left_in,
   }
 
   if (notify_latency) {
-    latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
-
-    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
-
-    util::idle_add([this]() {
-      if (!post_messages || latency.empty()) {
-        return;
-      }
-
-      latency.emit();
-    });
+    notify_latency_change();
 
     update_filter_params();
 
@@ -342,8 +387,10 @@ auto RNNoise::search_model_path(const std::string& name) -> std::string {
   } else {
     // Search model in community package paths
     for (const auto& xdg_model_dir : system_data_dir_rnnoise) {
-      if (util::search_filename(std::filesystem::path{xdg_model_dir + "/" + community_package}, model_filename,
-                                model_full_path, 3U)) {
+      model_full_path =
+          file_catalogue::find(std::filesystem::path{xdg_model_dir + "/" + community_package}, model_filename, 3U);
+
+      if (!model_full_path.empty()) {
         break;
       }
     }
@@ -52,6 +52,8 @@ void RNNoisePreset::save(nlohmann::json& json) {
   json[section][instance_name]["wet"] = g_settings_get_double(settings, "wet");
 
   json[section][instance_name]["release"] = g_settings_get_double(settings, "release");
+
+  json[section][instance_name]["channel-mode"] = util::gsettings_get_string(settings, "channel-mode");
 }
 
 void RNNoisePreset::load(const nlohmann::json& json) {
@@ -91,4 +93,6 @@ void RNNoisePreset::load(const nlohmann::json& json) {
   if (new_model_name != current_model_name) {
     g_settings_set_string(settings, model_name_key, new_model_name.c_str());
   }
+
+  update_key<gchar*>(json.at(section).at(instance_name), settings, "channel-mode", "channel-mode");
 }
@@ -35,7 +35,9 @@
 #include <vector>
 #include "application.hpp"
 #include "config.h"
+#include "meters_aggregator.hpp"
 #include "rnnoise.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -79,6 +81,8 @@ struct _RNNoiseBox {
 
   GtkSpinButton *vad_thres, *wet, *release;
 
+  AdwComboRow* channel_mode;
+
   GtkLevelBar *input_level_left, *input_level_right, *output_level_left, *output_level_right;
 
   GtkLabel *active_model_name, *model_active_state, *model_error_state, *input_level_left_label,
@@ -230,7 +234,7 @@ void setup(RNNoiseBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::rnnoise::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::rnnoise::id, schema_path.c_str());
 
   rnnoise->set_post_messages(true);
 
@@ -255,41 +259,19 @@ void setup(RNNoiseBox* self,
         [=]() { g_object_unref(self); });
   }));
 
-  self->data->connections.push_back(rnnoise->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(rnnoise->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), rnnoise,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   gtk_label_set_text(self->plugin_credit, ui::get_plugin_credit_translated(self->data->rnnoise->package).c_str());
 
   gsettings_bind_widgets<"input-gain", "output-gain", "enable-vad", "vad-thres", "wet", "release">(
       self->settings, self->input_gain, self->output_gain, self->enable_vad, self->vad_thres, self->wet, self->release);
 
+  ui::gsettings_bind_enum_to_combo_widget(self->settings, "channel-mode", self->channel_mode);
+
   g_settings_bind_with_mapping(
       self->settings, "model-name", self->selection_model, "selected", G_SETTINGS_BIND_DEFAULT,
       +[](GValue* value, GVariant* variant, gpointer user_data) {
@@ -384,6 +366,8 @@ void setup(RNNoiseBox* self,
 void dispose(GObject* object) {
   auto* self = EE_RNNOISE_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   g_file_monitor_cancel(self->folder_monitor);
@@ -444,6 +428,7 @@ void rnnoise_box_class_init(RNNoiseBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, RNNoiseBox, vad_thres);
   gtk_widget_class_bind_template_child(widget_class, RNNoiseBox, wet);
   gtk_widget_class_bind_template_child(widget_class, RNNoiseBox, release);
+  gtk_widget_class_bind_template_child(widget_class, RNNoiseBox, channel_mode);
 
   gtk_widget_class_bind_template_child(widget_class, RNNoiseBox, string_list);
   gtk_widget_class_bind_template_child(widget_class, RNNoiseBox, selection_model);
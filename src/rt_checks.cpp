@@ -0,0 +1,370 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "rt_checks.hpp"
+
+#ifdef ENABLE_RT_CHECKS
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+  Nothing in this file may allocate or lock while a violation is being recorded. The reports live in a static table,
+  the backtraces are symbolized only when the report is written and the original allocator is looked up with dlsym.
+  Calls made while dlsym is resolving the symbols are served from a small static arena.
+*/
+
+namespace {
+
+constexpr int max_frames = 32;
+constexpr int skipped_frames = 2;  // record() and the interposed function
+constexpr size_t max_reports = 512U;
+
+enum class SlotState : int { empty, writing, ready };
+
+struct Report {
+  std::atomic<SlotState> state = SlotState::empty;
+
+  std::atomic<uint64_t> count = 0U;
+
+  uint64_t hash = 0U;
+
+  const char* what = nullptr;
+
+  int n_frames = 0;
+
+  std::array<void*, max_frames> frames{};
+};
+
+std::array<Report, max_reports> reports;
+
+std::atomic<uint64_t> n_dropped = 0U;
+
+std::atomic<uint64_t> n_allocations = 0U;
+
+thread_local int realtime_depth = 0;
+
+thread_local bool recording = false;
+
+using malloc_fn = void* (*)(size_t);
+using calloc_fn = void* (*)(size_t, size_t);
+using realloc_fn = void* (*)(void*, size_t);
+using free_fn = void (*)(void*);
+using posix_memalign_fn = int (*)(void**, size_t, size_t);
+using aligned_alloc_fn = void* (*)(size_t, size_t);
+using mutex_lock_fn = int (*)(pthread_mutex_t*);
+
+malloc_fn real_malloc = nullptr;
+calloc_fn real_calloc = nullptr;
+realloc_fn real_realloc = nullptr;
+free_fn real_free = nullptr;
+posix_memalign_fn real_posix_memalign = nullptr;
+aligned_alloc_fn real_aligned_alloc = nullptr;
+mutex_lock_fn real_mutex_lock = nullptr;
+
+alignas(std::max_align_t) std::array<char, 8192U> arena;
+
+size_t arena_used = 0U;
+
+bool resolving = false;
+
+auto arena_alloc(const size_t& size) -> void* {
+  const auto aligned = (size + alignof(std::max_align_t) - 1U) & ~(alignof(std::max_align_t) - 1U);
+
+  if (arena_used + aligned > arena.size()) {
+    return nullptr;
+  }
+
+  auto* p = arena.data() + arena_used;
+
+  arena_used += aligned;
+
+  return p;
+}
+
+auto in_arena(const void* p) -> bool {
+  return p >= arena.data() && p < arena.data() + arena.size();
+}
+
+void resolve() {
+  if (real_malloc != nullptr || resolving) {
+    return;
+  }
+
+  resolving = true;
+
+  real_calloc = reinterpret_cast<calloc_fn>(dlsym(RTLD_NEXT, "calloc"));
+  real_realloc = reinterpret_cast<realloc_fn>(dlsym(RTLD_NEXT, "realloc"));
+  real_free = reinterpret_cast<free_fn>(dlsym(RTLD_NEXT, "free"));
+  real_posix_memalign = reinterpret_cast<posix_memalign_fn>(dlsym(RTLD_NEXT, "posix_memalign"));
+  real_aligned_alloc = reinterpret_cast<aligned_alloc_fn>(dlsym(RTLD_NEXT, "aligned_alloc"));
+  real_mutex_lock = reinterpret_cast<mutex_lock_fn>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+  real_malloc = reinterpret_cast<malloc_fn>(dlsym(RTLD_NEXT, "malloc"));
+
+  resolving = false;
+}
+
+void record(const char* what) {
+  if (realtime_depth == 0 || recording) {
+    return;
+  }
+
+  recording = true;
+
+  std::array<void*, max_frames> frames{};
+
+  const int n = backtrace(frames.data(), max_frames);
+
+  // FNV-1a over the return addresses. The call site is what matters, not the function that was interposed.
+
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (int i = skipped_frames; i < n; i++) {
+    hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ULL;
+  }
+
+  bool stored = false;
+
+  for (size_t probe = 0U; probe < max_reports && !stored; probe++) {
+    auto& slot = reports[(hash + probe) % max_reports];
+
+    auto state = slot.state.load(std::memory_order_acquire);
+
+    if (state == SlotState::empty) {
+      if (slot.state.compare_exchange_strong(state, SlotState::writing, std::memory_order_acq_rel)) {
+        slot.hash = hash;
+        slot.what = what;
+        slot.n_frames = n;
+        slot.frames = frames;
+        slot.count.store(1U, std::memory_order_relaxed);
+
+        slot.state.store(SlotState::ready, std::memory_order_release);
+
+        stored = true;
+
+        continue;
+      }
+    }
+
+    if (state == SlotState::ready && slot.hash == hash) {
+      slot.count.fetch_add(1U, std::memory_order_relaxed);
+
+      stored = true;
+    }
+  }
+
+  if (!stored) {
+    n_dropped.fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  recording = false;
+}
+
+void record_allocation(const char* what) {
+  if (realtime_depth > 0 && !recording) {
+    n_allocations.fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  record(what);
+}
+
+__attribute__((constructor)) void init() {
+  resolve();
+
+  // The first call to backtrace() loads libgcc_s. Doing it here keeps that allocation out of the realtime threads.
+
+  std::array<void*, 4U> frames{};
+
+  backtrace(frames.data(), static_cast<int>(frames.size()));
+
+  std::atexit(rt_checks::write_report);
+}
+
+}  // namespace
+
+namespace rt_checks {
+
+ScopedRealtime::ScopedRealtime() {
+  realtime_depth++;
+}
+
+ScopedRealtime::~ScopedRealtime() {
+  realtime_depth--;
+}
+
+void report_blocking_call(const char* what) {
+  record(what);
+}
+
+auto get_allocation_count() -> uint64_t {
+  return n_allocations.load(std::memory_order_relaxed);
+}
+
+void write_report() {
+  recording = true;
+
+  std::array<char, 256U> path{};
+
+  if (const auto* env = std::getenv("EE_RT_CHECKS_REPORT"); env != nullptr) {
+    std::snprintf(path.data(), path.size(), "%s", env);
+  } else {
+    std::snprintf(path.data(), path.size(), "/tmp/easyeffects-rt-checks-%d.txt", static_cast<int>(getpid()));
+  }
+
+  const int fd = open(path.data(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+  if (fd < 0) {
+    recording = false;
+
+    return;
+  }
+
+  size_t n_sites = 0U;
+
+  for (auto& slot : reports) {
+    if (slot.state.load(std::memory_order_acquire) != SlotState::ready) {
+      continue;
+    }
+
+    n_sites++;
+
+    dprintf(fd, "%s called %llu times in a realtime thread from:\n", slot.what,
+            static_cast<unsigned long long>(slot.count.load(std::memory_order_relaxed)));
+
+    backtrace_symbols_fd(slot.frames.data() + skipped_frames, slot.n_frames - skipped_frames, fd);
+
+    dprintf(fd, "\n");
+  }
+
+  if (const auto dropped = n_dropped.load(std::memory_order_relaxed); dropped != 0U) {
+    dprintf(fd, "%llu calls were not recorded because the report table is full\n",
+            static_cast<unsigned long long>(dropped));
+  }
+
+  close(fd);
+
+  dprintf(STDERR_FILENO, "rt checks: %zu call sites violating the realtime constraints. Report: %s\n", n_sites,
+          path.data());
+
+  recording = false;
+}
+
+}  // namespace rt_checks
+
+// Interposed functions. The executable is linked with --export-dynamic so these replace the ones from libc in every
+// library loaded by the process.
+
+extern "C" {
+
+auto malloc(size_t size) noexcept -> void* {
+  if (real_malloc == nullptr) {
+    resolve();
+
+    if (real_malloc == nullptr) {
+      return arena_alloc(size);
+    }
+  }
+
+  record_allocation("malloc");
+
+  return real_malloc(size);
+}
+
+auto calloc(size_t n, size_t size) noexcept -> void* {
+  if (real_calloc == nullptr) {
+    // dlsym itself may call calloc. The arena memory is static, so it is already zeroed.
+
+    return arena_alloc(n * size);
+  }
+
+  record_allocation("calloc");
+
+  return real_calloc(n, size);
+}
+
+auto realloc(void* ptr, size_t size) noexcept -> void* {
+  resolve();
+
+  record_allocation("realloc");
+
+  if (in_arena(ptr)) {
+    auto* new_ptr = real_malloc(size);
+
+    if (new_ptr != nullptr) {
+      const auto available = static_cast<size_t>(arena.data() + arena.size() - static_cast<char*>(ptr));
+
+      std::memcpy(new_ptr, ptr, std::min(size, available));
+    }
+
+    return new_ptr;
+  }
+
+  return real_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept {
+  if (ptr == nullptr || in_arena(ptr)) {
+    return;
+  }
+
+  resolve();
+
+  record("free");
+
+  real_free(ptr);
+}
+
+auto posix_memalign(void** ptr, size_t alignment, size_t size) noexcept -> int {
+  resolve();
+
+  record_allocation("posix_memalign");
+
+  return real_posix_memalign(ptr, alignment, size);
+}
+
+auto aligned_alloc(size_t alignment, size_t size) noexcept -> void* {
+  resolve();
+
+  record_allocation("aligned_alloc");
+
+  return real_aligned_alloc(alignment, size);
+}
+
+auto pthread_mutex_lock(pthread_mutex_t* mutex) noexcept -> int {
+  resolve();
+
+  record("pthread_mutex_lock");
+
+  return real_mutex_lock(mutex);
+}
+
+}  // extern "C"
+
+#endif
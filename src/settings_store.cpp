@@ -0,0 +1,297 @@
+/*
+ *  Copyright © 2017-2025 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "settings_store.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <map>
+#include <mutex>
+#include <ranges>
+#include <set>
+#include <string>
+#include <vector>
+#include "util.hpp"
+
+namespace settings_store {
+
+namespace {
+
+std::mutex store_mutex;
+
+struct Shared {
+  std::string schema_id;
+
+  GSettings* settings = nullptr;
+};
+
+std::map<std::string, Shared> store;  // indexed by path
+
+bool recording = false;
+
+std::set<std::string> recorded_paths;
+
+guint flush_source_id = 0U;
+
+gint64 first_change_time = 0;  // monotonic time of the oldest change that was not flushed yet
+
+auto on_flush_timeout(gpointer user_data) -> gboolean {
+  flush_source_id = 0U;
+
+  flush();
+
+  return G_SOURCE_REMOVE;
+}
+
+void schedule_flush() {
+  const auto now = g_get_monotonic_time();
+
+  if (flush_source_id == 0U) {
+    first_change_time = now;
+  } else {
+    // the timer is not restarted anymore when the oldest change has waited too long
+
+    if ((now - first_change_time) / 1000 >= max_flush_delay_ms - flush_delay_ms) {
+      return;
+    }
+
+    g_source_remove(flush_source_id);
+  }
+
+  flush_source_id = g_timeout_add(flush_delay_ms, GSourceFunc(on_flush_timeout), nullptr);
+}
+
+void on_has_unapplied(GSettings* settings, GParamSpec* pspec, gpointer user_data) {
+  if (g_settings_get_has_unapplied(settings) != 0) {
+    schedule_flush();
+  }
+}
+
+// user_data points to the path used as key in the store map. Its nodes are never moved.
+
+void on_changed(GSettings* settings, char* key, const std::string* path) {
+  std::scoped_lock<std::mutex> lock(store_mutex);
+
+  if (recording) {
+    recorded_paths.insert(*path);
+  }
+}
+
+auto lookup_schema_key(const char* schema_id, const char* key) -> GSettingsSchemaKey* {
+  auto* schema = g_settings_schema_source_lookup(g_settings_schema_source_get_default(), schema_id, 1);
+
+  if (schema == nullptr) {
+    return nullptr;
+  }
+
+  GSettingsSchemaKey* schema_key = nullptr;
+
+  if (g_settings_schema_has_key(schema, key) != 0) {
+    schema_key = g_settings_schema_get_key(schema, key);
+  }
+
+  g_settings_schema_unref(schema);
+
+  return schema_key;
+}
+
+}  // namespace
+
+auto get(const char* schema_id, const char* path) -> GSettings* {
+  std::scoped_lock<std::mutex> lock(store_mutex);
+
+  if (recording) {
+    recorded_paths.insert(path);
+  }
+
+  if (auto it = store.find(path); it != store.end()) {
+    return G_SETTINGS(g_object_ref(it->second.settings));
+  }
+
+  auto* settings = g_settings_new_with_path(schema_id, path);
+
+  g_settings_delay(settings);
+
+  auto [it, inserted] = store.emplace(path, Shared{.schema_id = schema_id, .settings = settings});
+
+  g_signal_connect(settings, "notify::has-unapplied", G_CALLBACK(on_has_unapplied), nullptr);
+
+  g_signal_connect(settings, "changed", G_CALLBACK(on_changed), const_cast<std::string*>(&it->first));
+
+  return G_SETTINGS(g_object_ref(settings));
+}
+
+void flush() {
+  std::vector<GSettings*> pending;
+
+  {
+    std::scoped_lock<std::mutex> lock(store_mutex);
+
+    for (const auto& shared : store | std::views::values) {
+      if (g_settings_get_has_unapplied(shared.settings) != 0) {
+        pending.push_back(G_SETTINGS(g_object_ref(shared.settings)));
+      }
+    }
+  }
+
+  // applying emits the changed signals of the other GSettings instances and their handlers may call get()
+
+  for (auto* settings : pending) {
+    g_settings_apply(settings);
+
+    g_object_unref(settings);
+  }
+
+  if (!pending.empty()) {
+    util::debug("flushed the changes of " + util::to_string(pending.size()) + " settings paths");
+  }
+}
+
+void start_recording() {
+  std::scoped_lock<std::mutex> lock(store_mutex);
+
+  recording = true;
+
+  recorded_paths.clear();
+}
+
+auto stop_recording() -> GVariant* {
+  std::scoped_lock<std::mutex> lock(store_mutex);
+
+  recording = false;
+
+  GVariantBuilder builder;
+
+  g_variant_builder_init(&builder, G_VARIANT_TYPE("a(sssv)"));
+
+  /*
+    update_key() only writes the values that differ from the current ones, so the changed signals alone would leave
+    out the keys that already had the value of the preset. Every key of the recorded paths is saved instead.
+  */
+
+  for (const auto& path : recorded_paths) {
+    const auto it = store.find(path);
+
+    if (it == store.end()) {
+      continue;
+    }
+
+    GSettingsSchema* schema = nullptr;
+
+    g_object_get(it->second.settings, "settings-schema", &schema, nullptr);
+
+    auto* keys = g_settings_schema_list_keys(schema);
+
+    for (auto* const* key = keys; *key != nullptr; key++) {
+      auto* value = g_settings_get_value(it->second.settings, *key);
+
+      g_variant_builder_add(&builder, "(sssv)", it->second.schema_id.c_str(), path.c_str(), *key, value);
+
+      g_variant_unref(value);
+    }
+
+    g_strfreev(keys);
+
+    g_settings_schema_unref(schema);
+  }
+
+  recorded_paths.clear();
+
+  return g_variant_ref_sink(g_variant_builder_end(&builder));
+}
+
+auto is_valid(GVariant* values) -> bool {
+  GVariantIter iter;
+
+  const gchar* schema_id = nullptr;
+  const gchar* path = nullptr;
+  const gchar* key = nullptr;
+  GVariant* value = nullptr;
+
+  g_variant_iter_init(&iter, values);
+
+  while (g_variant_iter_next(&iter, "(&s&s&sv)", &schema_id, &path, &key, &value)) {
+    auto* schema_key = lookup_schema_key(schema_id, key);
+
+    const bool valid =
+        schema_key != nullptr && g_variant_is_of_type(value, g_settings_schema_key_get_value_type(schema_key)) != 0 &&
+        g_settings_schema_key_range_check(schema_key, value) != 0;
+
+    if (schema_key != nullptr) {
+      g_settings_schema_key_unref(schema_key);
+    }
+
+    g_variant_unref(value);
+
+    if (!valid) {
+      util::debug("the recorded value of " + std::string(path) + key + " does not fit the installed schema");
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void apply(GVariant* values) {
+  GVariantIter iter;
+
+  const gchar* schema_id = nullptr;
+  const gchar* path = nullptr;
+  const gchar* key = nullptr;
+  GVariant* value = nullptr;
+
+  g_variant_iter_init(&iter, values);
+
+  while (g_variant_iter_next(&iter, "(&s&s&sv)", &schema_id, &path, &key, &value)) {
+    auto* settings = get(schema_id, path);
+
+    g_settings_set_value(settings, key, value);
+
+    g_object_unref(settings);
+
+    g_variant_unref(value);
+  }
+}
+
+void clear() {
+  if (flush_source_id != 0U) {
+    g_source_remove(flush_source_id);
+
+    flush_source_id = 0U;
+  }
+
+  flush();
+
+  std::scoped_lock<std::mutex> lock(store_mutex);
+
+  for (const auto& [path, shared] : store) {
+    g_signal_handlers_disconnect_by_func(shared.settings, reinterpret_cast<gpointer>(on_has_unapplied), nullptr);
+    g_signal_handlers_disconnect_by_func(shared.settings, reinterpret_cast<gpointer>(on_changed),
+                                         const_cast<std::string*>(&path));
+
+    g_object_unref(shared.settings);
+  }
+
+  store.clear();
+
+  g_settings_sync();
+}
+
+}  // namespace settings_store
@@ -28,10 +28,12 @@
 #include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <memory>
 #include <mutex>
 #include <numbers>
 #include <span>
 #include <string>
+#include "delay_line.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -56,27 +58,15 @@ Spectrum::Spectrum(const std::string& tag,
 
   plan = fftwf_plan_dft_r2c_1d(static_cast<int>(n_bands), real_input.data(), complex_output, FFTW_ESTIMATE);
 
-  lv2_wrapper = std::make_unique<lv2::Lv2Wrapper>("http://lsp-plug.in/plugins/lv2/comp_delay_x2_stereo");
+  avsync_delay = g_settings_get_int(settings, "avsync-delay");
 
-  package_installed = lv2_wrapper->found_plugin;
+  gconnections.push_back(g_signal_connect(settings, "changed::avsync-delay",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<Spectrum*>(user_data);
 
-  if (!package_installed) {
-    util::debug(log_tag +
-                "http://lsp-plug.in/plugins/lv2/comp_delay_x2_stereo is not installed, spectrum will not have A/V sync "
-                "compensation");
-  }
-
-  lv2_wrapper->set_control_port_value("mode_l", 2);
-  lv2_wrapper->set_control_port_value("mode_r", 2);
-
-  lv2_wrapper->set_control_port_value("dry_l", 0.0F);
-  lv2_wrapper->set_control_port_value("dry_r", 0.0F);
-
-  lv2_wrapper->set_control_port_value("wet_l", static_cast<float>(util::db_to_linear(0.0F)));
-  lv2_wrapper->set_control_port_value("wet_r", static_cast<float>(util::db_to_linear(0.0F)));
-
-  lv2_wrapper->bind_key_int<"time_l", "avsync-delay">(settings);
-  lv2_wrapper->bind_key_int<"time_r", "avsync-delay">(settings);
+                                            self->avsync_delay = g_settings_get_int(settings, key);
+                                          }),
+                                          this));
 
   g_signal_connect(settings, "changed::show", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                      auto* self = static_cast<Spectrum*>(user_data);
@@ -112,15 +102,14 @@ void Spectrum::setup() {
   left_delayed = std::span<float>(left_delayed_vector);
   right_delayed = std::span<float>(right_delayed_vector);
 
-  lv2_wrapper->set_n_samples(n_samples);
+  // the delay line is only allocated again when the rate changes
 
-  if (!lv2_wrapper->found_plugin) {
-    return;
-  }
+  if (avsync_line == nullptr || avsync_line_rate != rate) {
+    util::debug(log_tag + " creating the spectrum A/V sync delay line");
+
+    avsync_line = std::make_unique<DelayLine>(rate * max_avsync_delay / 1000U);
 
-  if (lv2_wrapper->get_rate() != rate) {
-    util::debug(log_tag + " creating instance of comp delay x2 stereo for spectrum A/V sync");
-    lv2_wrapper->create_instance(rate);
+    avsync_line_rate = rate;
   }
 }
 
@@ -138,40 +127,32 @@ void Spectrum::process(std::span<float>& left_in,
   // delay the visualization of the spectrum by the reported latency
   // of the output device, so that the spectrum is visually in sync
   // with the audio as experienced by the user. (A/V sync)
-  if (lv2_wrapper->found_plugin && lv2_wrapper->has_instance()) {
-    lv2_wrapper->connect_data_ports(left_in, right_in, left_delayed, right_delayed);
-    lv2_wrapper->run();
-
-    // Downmix the latest n_bands samples from the delayed signal.
-    if (n_samples < n_bands) {
-      // Drop the oldest quantum.
-      std::memmove(&latest_samples_mono[0], &latest_samples_mono[n_samples], (n_bands - n_samples) * sizeof(float));
-
-      // Copy the new quantum.
-      for (size_t n = 0; n < n_samples; n++) {
-        latest_samples_mono[n_bands - n_samples + n] = 0.5F * (left_delayed[n] + right_delayed[n]);
-      }
-    } else {
-      // Copy the latest n_bands samples.
-      for (size_t n = 0; n < n_bands; n++)
-        latest_samples_mono[n] =
-            0.5F * (left_delayed[n_samples - n_bands + n] + right_delayed[n_samples - n_bands + n]);
+  std::span<const float> left = left_in;
+  std::span<const float> right = right_in;
+
+  if (avsync_line != nullptr) {
+    const auto delay_frames = static_cast<double>(avsync_delay.load(std::memory_order_relaxed)) *
+                              static_cast<double>(rate) / 1000.0;
+
+    avsync_line->process(left_in, right_in, left_delayed, right_delayed, delay_frames, delay_frames);
+
+    left = left_delayed;
+    right = right_delayed;
+  }
+
+  // Downmix the latest n_bands samples.
+  if (n_samples < n_bands) {
+    // Drop the oldest quantum.
+    std::memmove(&latest_samples_mono[0], &latest_samples_mono[n_samples], (n_bands - n_samples) * sizeof(float));
+
+    // Copy the new quantum.
+    for (size_t n = 0; n < n_samples; n++) {
+      latest_samples_mono[n_bands - n_samples + n] = 0.5F * (left[n] + right[n]);
     }
   } else {
-    // Downmix the latest n_bands samples from the non-delayed signal.
-    if (n_samples < n_bands) {
-      // Drop the oldest quantum.
-      std::memmove(&latest_samples_mono[0], &latest_samples_mono[n_samples], (n_bands - n_samples) * sizeof(float));
-
-      // Copy the new quantum.
-      for (size_t n = 0; n < n_samples; n++) {
-        latest_samples_mono[n_bands - n_samples + n] = 0.5F * (left_in[n] + right_in[n]);
-      }
-    } else {
-      // Copy the latest n_bands samples.
-      for (size_t n = 0; n < n_bands; n++)
-        latest_samples_mono[n] = 0.5F * (left_in[n_samples - n_bands + n] + right_in[n_samples - n_bands + n]);
-    }
+    // Copy the latest n_bands samples.
+    for (size_t n = 0; n < n_bands; n++)
+      latest_samples_mono[n] = 0.5F * (left[n_samples - n_bands + n] + right[n_samples - n_bands + n]);
   }
 
   /*
@@ -165,6 +165,8 @@ Speex::Speex(const std::string& tag,
       this));
 
   setup_input_output_gain();
+
+  setup_channel_mode();
 }
 
 Speex::~Speex() {
@@ -246,10 +248,10 @@ void Speex::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
+  const bool mono = use_mono_path(left_in, right_in);
+
   for (size_t i = 0; i < n_samples; i++) {
     data_L[i] = static_cast<spx_int16_t>(left_in[i] * (SHRT_MAX + 1));
-
-    data_R[i] = static_cast<spx_int16_t>(right_in[i] * (SHRT_MAX + 1));
   }
 
   if (speex_preprocess_run(state_left, data_L.data()) == 1) {
@@ -260,12 +262,20 @@ void Speex::process(std::span<float>& left_in,
     std::ranges::fill(left_out, 0.0F);
   }
 
-  if (speex_preprocess_run(state_right, data_R.data()) == 1) {
+  if (mono) {
+    std::ranges::copy(left_out, right_out.begin());
+  } else {
     for (size_t i = 0; i < n_samples; i++) {
-      right_out[i] = static_cast<float>(data_R[i]) * inv_short_max;
+      data_R[i] = static_cast<spx_int16_t>(right_in[i] * (SHRT_MAX + 1));
+    }
+
+    if (speex_preprocess_run(state_right, data_R.data()) == 1) {
+      for (size_t i = 0; i < n_samples; i++) {
+        right_out[i] = static_cast<float>(data_R[i]) * inv_short_max;
+      }
+    } else {
+      std::ranges::fill(right_out, 0.0F);
     }
-  } else {
-    std::ranges::fill(right_out, 0.0F);
   }
 
   if (output_gain != 1.0F) {
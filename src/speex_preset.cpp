@@ -56,6 +56,8 @@ void SpeexPreset::save(nlohmann::json& json) {
       g_settings_get_int(settings, "vad-probability-continue");
 
   json[section][instance_name]["enable-dereverb"] = g_settings_get_boolean(settings, "enable-dereverb") != 0;
+
+  json[section][instance_name]["channel-mode"] = util::gsettings_get_string(settings, "channel-mode");
 }
 
 void SpeexPreset::load(const nlohmann::json& json) {
@@ -79,4 +81,6 @@ void SpeexPreset::load(const nlohmann::json& json) {
                   "probability-continue");
 
   update_key<bool>(json.at(section).at(instance_name), settings, "enable-dereverb", "enable-dereverb");
+
+  update_key<gchar*>(json.at(section).at(instance_name), settings, "channel-mode", "channel-mode");
 }
@@ -30,6 +30,8 @@
 #include <string>
 #include <vector>
 #include "application.hpp"
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "speex.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -69,6 +71,8 @@ struct _SpeexBox {
 
   GtkSpinButton *noise_suppression, *vad_probability_start, *vad_probability_continue;
 
+  AdwComboRow* channel_mode;
+
   GSettings* settings;
 
   Data* data;
@@ -96,39 +100,15 @@ void setup(SpeexBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::speex::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::speex::id, schema_path.c_str());
 
   speex->set_post_messages(true);
 
-  self->data->connections.push_back(speex->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(speex->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), speex,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   gtk_label_set_text(self->plugin_credit, ui::get_plugin_credit_translated(self->data->speex->package).c_str());
 
@@ -137,11 +117,15 @@ void setup(SpeexBox* self,
       self->settings, self->input_gain, self->output_gain, self->enable_denoise, self->noise_suppression,
       self->enable_agc, self->enable_vad, self->vad_probability_start, self->vad_probability_continue,
       self->enable_dereverb);
+
+  ui::gsettings_bind_enum_to_combo_widget(self->settings, "channel-mode", self->channel_mode);
 }
 
 void dispose(GObject* object) {
   auto* self = EE_SPEEX_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
@@ -201,6 +185,7 @@ void speex_box_class_init(SpeexBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, SpeexBox, noise_suppression);
   gtk_widget_class_bind_template_child(widget_class, SpeexBox, vad_probability_start);
   gtk_widget_class_bind_template_child(widget_class, SpeexBox, vad_probability_continue);
+  gtk_widget_class_bind_template_child(widget_class, SpeexBox, channel_mode);
 
   gtk_widget_class_bind_template_callback(widget_class, on_reset);
 }
@@ -48,6 +48,8 @@ StereoTools::StereoTools(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_needs_setup = false;
+
   if (!package_installed) {
     util::debug(log_tag + "http://calf.sourceforge.net/plugins/StereoTools is not installed");
   }
@@ -29,6 +29,8 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "meters_aggregator.hpp"
+#include "settings_store.hpp"
 #include "stereo_tools.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -90,39 +92,15 @@ void setup(StereoToolsBox* self, std::shared_ptr<StereoTools> stereo_tools, cons
 
   self->data->stereo_tools = stereo_tools;
 
-  self->settings = g_settings_new_with_path(tags::schema::stereo_tools::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::stereo_tools::id, schema_path.c_str());
 
   stereo_tools->set_post_messages(true);
 
-  self->data->connections.push_back(stereo_tools->input_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->input_level_left, self->input_level_left_label, self->input_level_right,
-                       self->input_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
-
-  self->data->connections.push_back(stereo_tools->output_level.connect([=](const float left, const float right) {
-    g_object_ref(self);
-
-    util::idle_add(
-        [=]() {
-          if (get_ignore_filter_idle_add(serial)) {
-            return;
-          }
-
-          update_level(self->output_level_left, self->output_level_left_label, self->output_level_right,
-                       self->output_level_right_label, left, right);
-        },
-        [=]() { g_object_unref(self); });
-  }));
+  ui::meters_aggregator::add(GTK_WIDGET(self), stereo_tools,
+                             {self->input_level_left, self->input_level_left_label, self->input_level_right,
+                              self->input_level_right_label},
+                             {self->output_level_left, self->output_level_left_label, self->output_level_right,
+                              self->output_level_right_label});
 
   gtk_label_set_text(self->plugin_credit, ui::get_plugin_credit_translated(self->data->stereo_tools->package).c_str());
 
@@ -174,6 +152,8 @@ void setup(StereoToolsBox* self, std::shared_ptr<StereoTools> stereo_tools, cons
 void dispose(GObject* object) {
   auto* self = EE_STEREO_TOOLS_BOX(object);
 
+  ui::meters_aggregator::remove(GTK_WIDGET(self));
+
   set_ignore_filter_idle_add(self->data->serial, true);
 
   for (auto& c : self->data->connections) {
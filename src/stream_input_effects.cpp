@@ -83,8 +83,12 @@ StreamInputEffects::StreamInputEffects(PipeManager* pipe_manager)
   connections.push_back(pm->stream_input_added.connect(sigc::mem_fun(*this, &StreamInputEffects::on_app_added)));
   connections.push_back(pm->link_changed.connect(sigc::mem_fun(*this, &StreamInputEffects::on_link_changed)));
 
+  connections.push_back(pm->stream_input_removed.connect([this](const uint64_t serial) { update_idle_state(); }));
+
   connect_filters();
 
+  update_idle_state();
+
   gconnections.push_back(g_signal_connect(settings, "changed::input-device",
                                           G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                             auto* self = static_cast<StreamInputEffects*>(user_data);
@@ -126,6 +130,18 @@ StreamInputEffects::StreamInputEffects(PipeManager* pipe_manager)
                                             self->set_bypass(false);
                                           }),
                                           this));
+
+  gconnections.push_back(g_signal_connect(settings, "changed::parallel-plugins",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<StreamInputEffects*>(user_data);
+
+                                            // only the links change
+
+                                            self->set_bypass(self->bypass);
+
+                                            self->broadcast_pipeline_latency();
+                                          }),
+                                          this));
 }
 
 StreamInputEffects::~StreamInputEffects() {
@@ -155,6 +171,8 @@ auto StreamInputEffects::apps_want_to_play() -> bool {
 }
 
 void StreamInputEffects::on_link_changed(const LinkInfo link_info) {
+  update_idle_state();
+
   // We are not interested in the other link states
 
   if (link_info.state != PW_LINK_STATE_ACTIVE && link_info.state != PW_LINK_STATE_PAUSED) {
@@ -206,6 +224,8 @@ void StreamInputEffects::on_link_changed(const LinkInfo link_info) {
 }
 
 void StreamInputEffects::connect_filters(const bool& bypass) {
+  const auto start = std::chrono::steady_clock::now();
+
   const auto input_device_name = util::gsettings_get_string(settings, "input-device");
 
   // checking if the output device exists
@@ -213,6 +233,8 @@ void StreamInputEffects::connect_filters(const bool& bypass) {
   if (input_device_name.empty()) {
     util::debug("No input device set. Aborting the link");
 
+    log_link_timing("connect_filters", start, list_proxies.size());
+
     return;
   }
 
@@ -231,6 +253,8 @@ void StreamInputEffects::connect_filters(const bool& bypass) {
   if (!dev_exists) {
     util::debug("The input device " + input_device_name + " is not available. Aborting the link");
 
+    log_link_timing("connect_filters", start, list_proxies.size());
+
     return;
   }
 
@@ -252,40 +276,74 @@ void StreamInputEffects::connect_filters(const bool& bypass) {
       util::warning("Information about the ports of the input device " + pm->input_device.name + " with id " +
                     util::to_string(pm->input_device.id) + " are taking to long to be available. Aborting the link");
 
+      log_link_timing("connect_filters", start, list_proxies.size());
+
       return;
     }
   }
 
-  uint prev_node_id = pm->input_device.id;
+  std::vector<uint> prev_node_ids = {pm->input_device.id};
   uint next_node_id = 0U;
 
-  // link plugins
+  linked_stages.clear();
 
-  if (!list.empty()) {
-    for (const auto& name : list) {
-      if (!plugins.contains(name)) {
-        continue;
+  // A mono microphone has only one port. Its links are the only ones that are allowed to be incomplete.
+
+  auto link_stage_node = [&](const uint& node_id) {
+    std::vector<pw_proxy*> node_links;
+
+    for (const auto& prev_node_id : prev_node_ids) {
+      const auto links = pm->link_nodes(prev_node_id, node_id);
+
+      node_links.insert(node_links.end(), links.begin(), links.end());
+
+      if ((mic_linked && (links.size() != 2U)) || (!mic_linked && links.empty())) {
+        util::warning(" link from node " + util::to_string(prev_node_id) + " to node " + util::to_string(node_id) +
+                      " failed");
+
+        /*
+          The node is left out of the stage and the branch gains are computed without it. The links that worked
+          are removed too. Otherwise the previous stage would keep feeding a node whose output goes nowhere.
+        */
+
+        pm->destroy_links(node_links);
+
+        return false;
       }
+    }
 
-      if (!plugins[name]->connected_to_pw ? plugins[name]->connect_to_pw() : true) {
-        next_node_id = plugins[name]->get_node_id();
+    list_proxies.insert(list_proxies.end(), node_links.begin(), node_links.end());
+
+    return true;
+  };
 
-        const auto links = pm->link_nodes(prev_node_id, next_node_id);
+  // link plugins. Every node of a stage is linked to all the nodes of the previous stage.
 
-        for (auto* link : links) {
-          list_proxies.push_back(link);
+  if (!list.empty()) {
+    for (const auto& stage : get_stages(list)) {
+      std::vector<uint> stage_node_ids;
+      std::vector<std::string> linked_plugins;
+
+      for (const auto& name : stage) {
+        if (!plugins[name]->connected_to_pw && !plugins[name]->connect_to_pw()) {
+          continue;
         }
 
-        if (mic_linked && (links.size() == 2U)) {
-          prev_node_id = next_node_id;
-        } else if (!mic_linked && (!links.empty())) {
-          prev_node_id = next_node_id;
-          mic_linked = true;
-        } else {
-          util::warning(" link from node " + util::to_string(prev_node_id) + " to node " +
-                        util::to_string(next_node_id) + " failed");
+        next_node_id = plugins[name]->get_node_id();
+
+        if (link_stage_node(next_node_id)) {
+          stage_node_ids.push_back(next_node_id);
+
+          linked_plugins.push_back(name);
         }
       }
+
+      if (!stage_node_ids.empty()) {
+        prev_node_ids = stage_node_ids;
+        mic_linked = true;
+
+        linked_stages.push_back(linked_plugins);
+      }
     }
 
     // checking if we have to link the echo_canceller probe to the output device
@@ -307,30 +365,36 @@ void StreamInputEffects::connect_filters(const bool& bypass) {
     }
   }
 
-  // link spectrum, output level meter and source node
+  // pw_filter_connect leaves the filters active. Those connected while the pipeline is suspended must wait too.
 
-  for (const auto node_id : {spectrum->get_node_id(), output_level->get_node_id(), pm->ee_source_node.id}) {
-    next_node_id = node_id;
+  if (suspended) {
+    deactivate_filters();
+  }
 
-    const auto links = pm->link_nodes(prev_node_id, next_node_id);
+  assign_metering_taps();
 
-    for (auto* link : links) {
-      list_proxies.push_back(link);
-    }
+  update_delay_compensation();
+
+  update_branch_gains();
 
-    if (mic_linked && (links.size() == 2U)) {
-      prev_node_id = next_node_id;
-    } else if (!mic_linked && (!links.empty())) {
-      prev_node_id = next_node_id;
+  // link spectrum, output level meter and source node. The spectrum is where the branches of a final parallel stage
+  // are mixed.
+
+  for (const auto node_id : {spectrum->get_node_id(), output_level->get_node_id(), pm->ee_source_node.id}) {
+    next_node_id = node_id;
+
+    if (link_stage_node(next_node_id)) {
+      prev_node_ids = {next_node_id};
       mic_linked = true;
-    } else {
-      util::warning(" link from node " + util::to_string(prev_node_id) + " to node " + util::to_string(next_node_id) +
-                    " failed");
     }
   }
+
+  log_link_timing("connect_filters", start, list_proxies.size());
 }
 
 void StreamInputEffects::disconnect_filters() {
+  const auto start = std::chrono::steady_clock::now();
+
   std::set<uint> link_id_list;
 
   const auto selected_plugins_list =
@@ -363,11 +427,15 @@ void StreamInputEffects::disconnect_filters() {
     pm->destroy_object(static_cast<int>(id));
   }
 
+  const auto n_links = link_id_list.size() + list_proxies.size();
+
   pm->destroy_links(list_proxies);
 
   list_proxies.clear();
 
   // remove_unused_filters();
+
+  log_link_timing("disconnect_filters", start, n_links);
 }
 
 void StreamInputEffects::set_bypass(const bool& state) {
@@ -83,8 +83,14 @@ StreamOutputEffects::StreamOutputEffects(PipeManager* pipe_manager)
 
   connections.push_back(pm->stream_output_added.connect(sigc::mem_fun(*this, &StreamOutputEffects::on_app_added)));
 
+  connections.push_back(pm->link_changed.connect([this](const LinkInfo link_info) { update_idle_state(); }));
+
+  connections.push_back(pm->stream_output_removed.connect([this](const uint64_t serial) { update_idle_state(); }));
+
   connect_filters();
 
+  update_idle_state();
+
   gconnections.push_back(g_signal_connect(settings, "changed::output-device",
                                           G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                             auto* self = static_cast<StreamOutputEffects*>(user_data);
@@ -126,6 +132,18 @@ StreamOutputEffects::StreamOutputEffects(PipeManager* pipe_manager)
                                             self->set_bypass(false);
                                           }),
                                           this));
+
+  gconnections.push_back(g_signal_connect(settings, "changed::parallel-plugins",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<StreamOutputEffects*>(user_data);
+
+                                            // only the links change
+
+                                            self->set_bypass(self->bypass);
+
+                                            self->broadcast_pipeline_latency();
+                                          }),
+                                          this));
 }
 
 StreamOutputEffects::~StreamOutputEffects() {
@@ -153,6 +171,8 @@ auto StreamOutputEffects::apps_want_to_play() -> bool {
 }
 
 void StreamOutputEffects::connect_filters(const bool& bypass) {
+  const auto start = std::chrono::steady_clock::now();
+
   const auto output_device_name = util::gsettings_get_string(settings, "output-device");
 
   // checking if the output device exists
@@ -160,6 +180,8 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
   if (output_device_name.empty()) {
     util::debug("No output device set. Aborting the link");
 
+    log_link_timing("connect_filters", start, list_proxies.size());
+
     return;
   }
 
@@ -178,39 +200,73 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
   if (!dev_exists) {
     util::debug("The output device " + output_device_name + " is not available. Aborting the link");
 
+    log_link_timing("connect_filters", start, list_proxies.size());
+
     return;
   }
 
   const auto list =
       (bypass) ? std::vector<std::string>() : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
 
-  uint prev_node_id = pm->ee_sink_node.id;
+  std::vector<uint> prev_node_ids = {pm->ee_sink_node.id};
   uint next_node_id = 0U;
 
-  // link plugins
+  linked_stages.clear();
 
-  if (!list.empty()) {
-    for (const auto& name : list) {
-      if (!plugins.contains(name)) {
-        continue;
+  auto link_stage_node = [&](const uint& node_id) {
+    std::vector<pw_proxy*> node_links;
+
+    for (const auto& prev_node_id : prev_node_ids) {
+      const auto links = pm->link_nodes(prev_node_id, node_id);
+
+      node_links.insert(node_links.end(), links.begin(), links.end());
+
+      if (links.size() != 2U) {
+        util::warning(" link from node " + util::to_string(prev_node_id) + " to node " + util::to_string(node_id) +
+                      " failed");
+
+        /*
+          The node is left out of the stage and the branch gains are computed without it. The links that worked
+          are removed too. Otherwise the previous stage would keep feeding a node whose output goes nowhere.
+        */
+
+        pm->destroy_links(node_links);
+
+        return false;
       }
+    }
 
-      if (!plugins[name]->connected_to_pw ? plugins[name]->connect_to_pw() : true) {
-        next_node_id = plugins[name]->get_node_id();
+    list_proxies.insert(list_proxies.end(), node_links.begin(), node_links.end());
 
-        const auto links = pm->link_nodes(prev_node_id, next_node_id);
+    return true;
+  };
+
+  // link plugins. Every node of a stage is linked to all the nodes of the previous stage.
+
+  if (!list.empty()) {
+    for (const auto& stage : get_stages(list)) {
+      std::vector<uint> stage_node_ids;
+      std::vector<std::string> linked_plugins;
 
-        for (auto* link : links) {
-          list_proxies.push_back(link);
+      for (const auto& name : stage) {
+        if (!plugins[name]->connected_to_pw && !plugins[name]->connect_to_pw()) {
+          continue;
         }
 
-        if (links.size() == 2U) {
-          prev_node_id = next_node_id;
-        } else {
-          util::warning(" link from node " + util::to_string(prev_node_id) + " to node " +
-                        util::to_string(next_node_id) + " failed");
+        next_node_id = plugins[name]->get_node_id();
+
+        if (link_stage_node(next_node_id)) {
+          stage_node_ids.push_back(next_node_id);
+
+          linked_plugins.push_back(name);
         }
       }
+
+      if (!stage_node_ids.empty()) {
+        prev_node_ids = stage_node_ids;
+
+        linked_stages.push_back(linked_plugins);
+      }
     }
 
     // checking if we have to link the echo_canceller probe to the output device
@@ -232,22 +288,25 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
     }
   }
 
-  // link spectrum and output level meter
+  // pw_filter_connect leaves the filters active. Those connected while the pipeline is suspended must wait too.
 
-  for (const auto& node_id : {spectrum->get_node_id(), output_level->get_node_id()}) {
-    next_node_id = node_id;
+  if (suspended) {
+    deactivate_filters();
+  }
 
-    const auto links = pm->link_nodes(prev_node_id, next_node_id);
+  assign_metering_taps();
 
-    for (auto* link : links) {
-      list_proxies.push_back(link);
-    }
+  update_delay_compensation();
+
+  update_branch_gains();
+
+  // link spectrum and output level meter. The spectrum is where the branches of a final parallel stage are mixed.
 
-    if (links.size() == 2U) {
-      prev_node_id = next_node_id;
-    } else {
-      util::warning(" link from node " + util::to_string(prev_node_id) + " to node " + util::to_string(next_node_id) +
-                    " failed");
+  for (const auto& node_id : {spectrum->get_node_id(), output_level->get_node_id()}) {
+    next_node_id = node_id;
+
+    if (link_stage_node(next_node_id)) {
+      prev_node_ids = {next_node_id};
     }
   }
 
@@ -264,6 +323,8 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
       util::warning("Information about the ports of the output device " + pm->output_device.name + " with id " +
                     util::to_string(pm->output_device.id) + " are taking to long to be available. Aborting the link");
 
+      log_link_timing("connect_filters", start, list_proxies.size());
+
       return;
     }
   }
@@ -272,19 +333,25 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
 
   next_node_id = pm->output_device.id;
 
-  const auto links = pm->link_nodes(prev_node_id, next_node_id);
+  for (const auto& prev_node_id : prev_node_ids) {
+    const auto links = pm->link_nodes(prev_node_id, next_node_id);
 
-  for (auto* link : links) {
-    list_proxies.push_back(link);
-  }
+    for (auto* link : links) {
+      list_proxies.push_back(link);
+    }
 
-  if (links.size() < 2U) {
-    util::warning(" link from node " + util::to_string(prev_node_id) + " to output device " +
-                  util::to_string(next_node_id) + " failed");
+    if (links.size() < 2U) {
+      util::warning(" link from node " + util::to_string(prev_node_id) + " to output device " +
+                    util::to_string(next_node_id) + " failed");
+    }
   }
+
+  log_link_timing("connect_filters", start, list_proxies.size());
 }
 
 void StreamOutputEffects::disconnect_filters() {
+  const auto start = std::chrono::steady_clock::now();
+
   std::set<uint> link_id_list;
 
   const auto selected_plugins_list =
@@ -317,11 +384,15 @@ void StreamOutputEffects::disconnect_filters() {
     pm->destroy_object(static_cast<int>(id));
   }
 
+  const auto n_links = link_id_list.size() + list_proxies.size();
+
   pm->destroy_links(list_proxies);
 
   list_proxies.clear();
 
   // remove_unused_filters();
+
+  log_link_timing("disconnect_filters", start, n_links);
 }
 
 void StreamOutputEffects::set_bypass(const bool& state) {
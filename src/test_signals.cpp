@@ -18,18 +18,28 @@
  */
 
 #include "test_signals.hpp"
+#include <fftw3.h>
+#include <glib.h>
 #include <pipewire/filter.h>
 #include <pipewire/keys.h>
 #include <pipewire/port.h>
 #include <pipewire/properties.h>
 #include <spa/node/io.h>
 #include <spa/utils/hook.h>
+#include <sndfile.h>
 #include <sys/types.h>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <filesystem>
 #include <numbers>
+#include <sndfile.hh>
 #include <span>
+#include <string>
+#include <system_error>
 #include <thread>
+#include <vector>
 #include "pipe_manager.hpp"
 #include "tags_app.hpp"
 #include "util.hpp"
@@ -67,6 +77,23 @@ void on_process(void* userdata, spa_io_position* position) {
   std::span left_out(out_left, n_samples);
   std::span right_out(out_right, n_samples);
 
+  // The inputs are only linked while an impulse response is being measured
+
+  auto* in_left = static_cast<float*>(pw_filter_get_dsp_buffer(d->in_left, n_samples));
+  auto* in_right = static_cast<float*>(pw_filter_get_dsp_buffer(d->in_right, n_samples));
+
+  std::span<const float> left_in;
+  std::span<const float> right_in;
+
+  if (in_left != nullptr && in_right != nullptr) {
+    left_in = std::span<const float>(in_left, n_samples);
+    right_in = std::span<const float>(in_right, n_samples);
+  }
+
+  if (d->ts->play_and_record(left_out, right_out, left_in, right_in)) {
+    return;
+  }
+
   const auto phase_delta = pi_x_2 * d->ts->sine_frequency / static_cast<float>(rate);
 
   for (uint n = 0U; n < n_samples; n++) {
@@ -156,6 +183,28 @@ TestSignals::TestSignals(PipeManager* pipe_manager) : pm(pipe_manager), random_g
 
   filter = pw_filter_new(pm->core, filter_name, props_filter);
 
+  // left channel input
+
+  auto* props_in_left = pw_properties_new(nullptr, nullptr);
+
+  pw_properties_set(props_in_left, PW_KEY_FORMAT_DSP, "32 bit float mono audio");
+  pw_properties_set(props_in_left, PW_KEY_PORT_NAME, "input_FL");
+  pw_properties_set(props_in_left, "audio.channel", "FL");
+
+  pf_data.in_left = static_cast<port*>(pw_filter_add_port(filter, PW_DIRECTION_INPUT, PW_FILTER_PORT_FLAG_MAP_BUFFERS,
+                                                          sizeof(port), props_in_left, nullptr, 0));
+
+  // right channel input
+
+  auto* props_in_right = pw_properties_new(nullptr, nullptr);
+
+  pw_properties_set(props_in_right, PW_KEY_FORMAT_DSP, "32 bit float mono audio");
+  pw_properties_set(props_in_right, PW_KEY_PORT_NAME, "input_FR");
+  pw_properties_set(props_in_right, "audio.channel", "FR");
+
+  pf_data.in_right = static_cast<port*>(pw_filter_add_port(filter, PW_DIRECTION_INPUT, PW_FILTER_PORT_FLAG_MAP_BUFFERS,
+                                                           sizeof(port), props_in_right, nullptr, 0));
+
   // left channel output
 
   auto* props_out_left = pw_properties_new(nullptr, nullptr);
@@ -214,6 +263,20 @@ TestSignals::TestSignals(PipeManager* pipe_manager) : pm(pipe_manager), random_g
 TestSignals::~TestSignals() {
   util::debug("destroyed");
 
+  if (measurement_source_id != 0U) {
+    g_source_remove(measurement_source_id);
+  }
+
+  if (measurement_thread.joinable()) {
+    measurement_thread.join();
+  }
+
+  measurement_state.store(MeasurementState::idle);
+
+  wait_for_realtime_thread();
+
+  unlink_measurement();
+
   pm->lock();
 
   spa_hook_remove(&listener);
@@ -225,6 +288,8 @@ TestSignals::~TestSignals() {
   pw_filter_destroy(filter);
 
   pm->sync_wait_unlock();
+
+  free_fft();
 }
 
 void TestSignals::set_state(const bool& state) {
@@ -252,3 +317,458 @@ auto TestSignals::white_noise() -> float {
 
   return (v > 1.0F) ? 1.0F : ((v < -1.0F) ? -1.0F : v);
 }
+
+auto TestSignals::start_measurement(const std::string& ir_name, const double& sweep_seconds) -> bool {
+  if (measurement_state.load(std::memory_order_acquire) != MeasurementState::idle) {
+    return false;
+  }
+
+  // the name becomes a file name in the impulse responses directory
+
+  if (ir_name.empty() || ir_name == "." || ir_name == ".." || ir_name.find_first_of("\\/") != std::string::npos) {
+    util::warning("the impulse response name " + ir_name + " is empty or has illegal file name characters");
+
+    return false;
+  }
+
+  if (measurement_thread.joinable()) {
+    measurement_thread.join();
+  }
+
+  wait_for_realtime_thread();
+
+  uint r = rate;
+
+  if (r == 0U) {
+    util::str_to_num(std::string(pm->default_clock_rate), r);
+  }
+
+  if (r == 0U) {
+    util::warning("the sampling rate is unknown. The impulse response can not be measured");
+
+    return false;
+  }
+
+  measurement_rate = r;
+  measurement_name = ir_name;
+
+  const auto fs = static_cast<double>(r);
+
+  // exponential sine sweep as described by Farina
+
+  sweep_f2 = std::min(sweep_end_frequency, 0.45 * fs);
+
+  const auto sweep_length = static_cast<size_t>(std::lround(std::clamp(sweep_seconds, 1.0, 60.0) * fs));
+  const auto duration = static_cast<double>(sweep_length) / fs;
+  const auto k = duration / std::log(sweep_f2 / sweep_start_frequency);
+
+  sweep.resize(sweep_length);
+
+  const auto fade_in = static_cast<size_t>(0.05 * fs);
+  const auto fade_out = static_cast<size_t>(0.01 * fs);
+
+  for (size_t n = 0U; n < sweep_length; n++) {
+    const auto t = static_cast<double>(n) / fs;
+
+    auto v = 0.5 * std::sin(2.0 * std::numbers::pi * sweep_start_frequency * k * (std::exp(t / k) - 1.0));
+
+    if (n < fade_in) {
+      v *= 0.5 * (1.0 - std::cos(std::numbers::pi * static_cast<double>(n) / static_cast<double>(fade_in)));
+    } else if (n + fade_out >= sweep_length) {
+      const auto m = static_cast<double>(sweep_length - 1U - n);
+
+      v *= 0.5 * (1.0 - std::cos(std::numbers::pi * m / static_cast<double>(fade_out)));
+    }
+
+    sweep[n] = static_cast<float>(v);
+  }
+
+  const auto recording_length = sweep_length + static_cast<size_t>(measurement_tail_seconds * fs);
+
+  recording_left.assign(recording_length, 0.0F);
+  recording_right.assign(recording_length, 0.0F);
+
+  // a linear deconvolution needs room for the recording and the sweep
+
+  free_fft();
+
+  fft_size = 1;
+
+  while (static_cast<size_t>(fft_size) < recording_length + sweep_length) {
+    fft_size *= 2;
+  }
+
+  const auto n_bins = static_cast<size_t>(fft_size / 2 + 1);
+
+  fft_real = fftwf_alloc_real(static_cast<size_t>(fft_size));
+  fft_sweep = fftwf_alloc_complex(n_bins);
+  fft_complex = fftwf_alloc_complex(n_bins);
+
+  plan_forward = fftwf_plan_dft_r2c_1d(fft_size, fft_real, fft_complex, FFTW_ESTIMATE);
+  plan_backward = fftwf_plan_dft_c2r_1d(fft_size, fft_complex, fft_real, FFTW_ESTIMATE);
+
+  // The recording comes from the output of the input pipeline. The sweep goes through the output pipeline.
+
+  for (const auto& link : pm->link_nodes(pm->ee_source_node.id, node_id, false, false)) {
+    measurement_proxies.push_back(link);
+  }
+
+  if (measurement_proxies.empty()) {
+    util::warning("could not link the input pipeline to the test signals node");
+
+    free_fft();
+
+    return false;
+  }
+
+  // when the test signal is enabled its output is already linked to the output pipeline
+
+  if (list_proxies.empty()) {
+    for (const auto& link : pm->link_nodes(node_id, pm->ee_sink_node.id, false, false)) {
+      measurement_proxies.push_back(link);
+    }
+  }
+
+  measurement_position = 0U;
+
+  measurement_state.store(MeasurementState::running, std::memory_order_release);
+
+  measurement_source_id = g_timeout_add(100, GSourceFunc(+[](TestSignals* self) {
+                                          return self->on_measurement_timeout() ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+                                        }),
+                                        this);
+
+  util::debug("measuring the impulse response " + ir_name + " with a sweep of " + util::to_string(duration) +
+              " seconds at " + util::to_string(r) + " Hz");
+
+  return true;
+}
+
+void TestSignals::cancel_measurement() {
+  // Once the recording is done the deconvolution is left to finish. It is fast compared to the sweep.
+
+  if (measurement_state.load(std::memory_order_acquire) != MeasurementState::running) {
+    return;
+  }
+
+  measurement_state.store(MeasurementState::idle);
+
+  wait_for_realtime_thread();
+
+  if (measurement_source_id != 0U) {
+    g_source_remove(measurement_source_id);
+
+    measurement_source_id = 0U;
+  }
+
+  unlink_measurement();
+
+  free_fft();
+
+  util::debug("impulse response measurement cancelled");
+}
+
+void TestSignals::wait_for_realtime_thread() {
+  // the realtime thread may have seen the running state just before it was changed
+
+  while (measurement_busy.load()) {
+    std::this_thread::yield();
+  }
+}
+
+auto TestSignals::measuring() const -> bool {
+  return measurement_state.load(std::memory_order_acquire) != MeasurementState::idle;
+}
+
+auto TestSignals::play_and_record(std::span<float> left_out,
+                                  std::span<float> right_out,
+                                  std::span<const float> left_in,
+                                  std::span<const float> right_in) -> bool {
+  measurement_busy.store(true);
+
+  const auto running = record_quantum(left_out, right_out, left_in, right_in);
+
+  measurement_busy.store(false);
+
+  return running;
+}
+
+auto TestSignals::record_quantum(std::span<float> left_out,
+                                 std::span<float> right_out,
+                                 std::span<const float> left_in,
+                                 std::span<const float> right_in) -> bool {
+  // sequentially consistent, like measurement_busy, so that a cancellation can not be missed
+
+  if (measurement_state.load() != MeasurementState::running) {
+    return false;
+  }
+
+  std::ranges::fill(left_out, 0.0F);
+  std::ranges::fill(right_out, 0.0F);
+
+  // the sweep was computed for the rate the measurement started with
+
+  if (rate != measurement_rate) {
+    auto expected = MeasurementState::running;
+
+    measurement_state.compare_exchange_strong(expected, MeasurementState::failed, std::memory_order_acq_rel);
+
+    return true;
+  }
+
+  const auto recording_length = recording_left.size();
+
+  for (size_t n = 0U; n < left_out.size(); n++) {
+    const auto position = measurement_position + n;
+
+    if (position >= recording_length) {
+      break;
+    }
+
+    const auto v = (position < sweep.size()) ? sweep[position] : 0.0F;
+
+    if (create_left_channel) {
+      left_out[n] = v;
+    }
+
+    if (create_right_channel) {
+      right_out[n] = v;
+    }
+
+    if (!left_in.empty()) {
+      recording_left[position] = left_in[n];
+      recording_right[position] = right_in[n];
+    }
+  }
+
+  measurement_position += left_out.size();
+
+  // a compare and exchange because the main thread may have cancelled the measurement in the meantime
+
+  if (measurement_position >= recording_length) {
+    auto expected = MeasurementState::running;
+
+    measurement_state.compare_exchange_strong(expected, MeasurementState::recorded, std::memory_order_acq_rel);
+  }
+
+  return true;
+}
+
+auto TestSignals::on_measurement_timeout() -> bool {
+  switch (measurement_state.load(std::memory_order_acquire)) {
+    case MeasurementState::recorded: {
+      unlink_measurement();
+
+      measurement_state.store(MeasurementState::processing, std::memory_order_release);
+
+      measurement_thread = std::thread([this]() {
+        deconvolve();
+
+        measurement_state.store(MeasurementState::done, std::memory_order_release);
+      });
+
+      return true;
+    }
+    case MeasurementState::done: {
+      measurement_thread.join();
+
+      free_fft();
+
+      measurement_source_id = 0U;
+
+      measurement_state.store(MeasurementState::idle, std::memory_order_release);
+
+      measurement_finished.emit(measurement_ok, measurement_message);
+
+      return false;
+    }
+    case MeasurementState::failed: {
+      unlink_measurement();
+
+      free_fft();
+
+      measurement_source_id = 0U;
+
+      measurement_state.store(MeasurementState::idle, std::memory_order_release);
+
+      util::warning("the sampling rate changed during the impulse response measurement");
+
+      measurement_finished.emit(false, "The sampling rate changed during the measurement");
+
+      return false;
+    }
+    case MeasurementState::idle: {
+      measurement_source_id = 0U;
+
+      return false;
+    }
+    default:
+      return true;
+  }
+}
+
+void TestSignals::unlink_measurement() {
+  if (measurement_proxies.empty()) {
+    return;
+  }
+
+  pm->destroy_links(measurement_proxies);
+
+  measurement_proxies.clear();
+}
+
+void TestSignals::deconvolve() {
+  measurement_ok = false;
+
+  const auto n_fft = static_cast<size_t>(fft_size);
+  const auto n_bins = n_fft / 2U + 1U;
+  const auto fs = static_cast<double>(measurement_rate);
+
+  auto real = std::span(fft_real, n_fft);
+  auto spectrum = std::span(fft_complex, n_bins);
+  auto sweep_spectrum = std::span(fft_sweep, n_bins);
+
+  std::ranges::fill(real, 0.0F);
+  std::ranges::copy(sweep, real.begin());
+
+  fftwf_execute_dft_r2c(plan_forward, fft_real, fft_sweep);
+
+  // Regularized inverse filter. Outside of the swept band the regularization is large so that noise is not amplified.
+
+  float max_power = 0.0F;
+
+  for (const auto& bin : sweep_spectrum) {
+    max_power = std::max(max_power, bin[0] * bin[0] + bin[1] * bin[1]);
+  }
+
+  const auto bin_f1 = static_cast<size_t>(sweep_start_frequency * static_cast<double>(n_fft) / fs);
+  const auto bin_f2 = static_cast<size_t>(sweep_f2 * static_cast<double>(n_fft) / fs);
+
+  std::vector<std::vector<float>> responses;
+
+  for (const auto* recording : {&recording_left, &recording_right}) {
+    std::ranges::fill(real, 0.0F);
+    std::ranges::copy(*recording, real.begin());
+
+    fftwf_execute(plan_forward);
+
+    for (size_t k = 0U; k < n_bins; k++) {
+      const auto s_re = sweep_spectrum[k][0];
+      const auto s_im = sweep_spectrum[k][1];
+      const auto r_re = spectrum[k][0];
+      const auto r_im = spectrum[k][1];
+
+      const auto epsilon = (k >= bin_f1 && k <= bin_f2) ? 1e-4F * max_power : max_power;
+
+      const auto gain = 1.0F / ((s_re * s_re + s_im * s_im + epsilon) * static_cast<float>(n_fft));
+
+      spectrum[k][0] = (r_re * s_re + r_im * s_im) * gain;
+      spectrum[k][1] = (r_im * s_re - r_re * s_im) * gain;
+    }
+
+    fftwf_execute(plan_backward);
+
+    // The linear response starts at zero lag. Harmonic distortion lands at negative lags, at the end of the buffer.
+
+    responses.emplace_back(real.begin(), real.begin() + static_cast<std::ptrdiff_t>(recording->size()));
+  }
+
+  // Both channels are cut at the same position so that the time difference between them is kept
+
+  size_t peak_index = 0U;
+  float peak = 0.0F;
+
+  for (const auto& h : responses) {
+    for (size_t n = 0U; n < h.size(); n++) {
+      if (std::fabs(h[n]) > peak) {
+        peak = std::fabs(h[n]);
+        peak_index = n;
+      }
+    }
+  }
+
+  if (peak < 1e-6F) {
+    measurement_message = "No signal was recorded from the input pipeline";
+
+    util::warning(measurement_message);
+
+    return;
+  }
+
+  const auto pre_samples = static_cast<size_t>(0.005 * fs);
+  const auto start = (peak_index > pre_samples) ? peak_index - pre_samples : 0U;
+  const auto ir_length = std::min(static_cast<size_t>(ir_seconds * fs), responses[0].size() - start);
+  const auto fade_in = peak_index - start;
+  const auto fade_out = ir_length / 10U;
+
+  std::vector<float> buffer(2U * ir_length);  // 2 channels interleaved
+
+  for (size_t n = 0U; n < ir_length; n++) {
+    double w = 1.0;
+
+    if (n < fade_in) {
+      w = 0.5 * (1.0 - std::cos(std::numbers::pi * static_cast<double>(n) / static_cast<double>(fade_in)));
+    } else if (n + fade_out >= ir_length) {
+      const auto m = static_cast<double>(ir_length - 1U - n);
+
+      w = 0.5 * (1.0 - std::cos(std::numbers::pi * m / static_cast<double>(fade_out)));
+    }
+
+    buffer[2U * n] = static_cast<float>(w) * responses[0][start + n] / peak;
+    buffer[2U * n + 1U] = static_cast<float>(w) * responses[1][start + n] / peak;
+  }
+
+  const auto irs_dir = std::filesystem::path{g_get_user_config_dir()} / "easyeffects" / "irs";
+
+  std::error_code error;
+
+  std::filesystem::create_directories(irs_dir, error);
+
+  const auto output_file_path = irs_dir / std::filesystem::path{measurement_name + ".irs"};
+
+  auto sndfile = SndfileHandle(output_file_path.string(), SFM_WRITE, SF_FORMAT_WAV | SF_FORMAT_PCM_32, 2,
+                               static_cast<int>(measurement_rate));
+
+  if (sndfile.error() != 0 ||
+      sndfile.writef(buffer.data(), static_cast<sf_count_t>(ir_length)) != static_cast<sf_count_t>(ir_length)) {
+    measurement_message = "Could not save " + output_file_path.string();
+
+    util::warning(measurement_message);
+
+    return;
+  }
+
+  measurement_ok = true;
+  measurement_message = output_file_path.string();
+
+  util::debug("measured impulse response saved: " + output_file_path.string());
+}
+
+void TestSignals::free_fft() {
+  if (plan_forward != nullptr) {
+    fftwf_destroy_plan(plan_forward);
+  }
+
+  if (plan_backward != nullptr) {
+    fftwf_destroy_plan(plan_backward);
+  }
+
+  if (fft_real != nullptr) {
+    fftwf_free(fft_real);
+  }
+
+  if (fft_sweep != nullptr) {
+    fftwf_free(fft_sweep);
+  }
+
+  if (fft_complex != nullptr) {
+    fftwf_free(fft_complex);
+  }
+
+  plan_forward = nullptr;
+  plan_backward = nullptr;
+  fft_real = nullptr;
+  fft_sweep = nullptr;
+  fft_complex = nullptr;
+  fft_size = 0;
+}
@@ -42,10 +42,13 @@
 #include <utility>
 #include <vector>
 #include "pipe_manager.hpp"
+#include "rt_checks.hpp"
 
 namespace util {
 
 auto prepare_debug_message(const std::string& message, source_location location) -> std::string {
+  rt_checks::report_blocking_call("util logging");
+
   auto file_path = std::filesystem::path{location.file_name()};
 
   std::ostringstream msg_stream;
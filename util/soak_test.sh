@@ -0,0 +1,275 @@
+#!/usr/bin/env bash
+# Use shellcheck to check this script after making changes
+
+# Soak test of the Easy Effects pipelines. It needs no audio hardware and does not touch the user session:
+# a private PipeWire daemon with null sinks is started in a temporary runtime directory, Easy Effects runs as a
+# GApplication service in its own D-Bus session with the keyfile GSettings backend, and streams are created and
+# destroyed with pw-play while the output device flaps between two null sinks.
+#
+# The "link timing" lines Easy Effects writes in debug mode give the time and the number of links of every
+# connect_filters/disconnect_filters call. xruns are read from the ERR column of pw-top for the Easy Effects nodes.
+#
+# Requirements: pipewire, wireplumber, pw-play, pw-top, pw-cli, dbus-run-session, gsettings and Xvfb when there is
+# no display.
+#
+# Usage: util/soak_test.sh [-c cycles] [-s streams] [-o results] [-b baseline] [-t tolerance_percent]
+#
+# The results are written as "key value" lines. When a baseline produced by a previous run is given the script fails
+# if a timing got more than tolerance_percent slower or if there are more xruns than in the baseline.
+
+set -e
+
+export LANG=C
+
+if [ "$(pwd | awk -F '/' '{print $NF}')" = "util" ]; then cd .. ; fi
+dir0="$PWD"
+
+EE_BIN="${EE_BIN:-easyeffects}"
+WAV_FILE="${WAV_FILE:-${dir0}/util/test.wav}"
+
+cycles=20
+streams=100
+results_file=""
+baseline_file=""
+tolerance=25
+
+while getopts "c:s:o:b:t:" opt; do
+	case "$opt" in
+		c) cycles="$OPTARG" ;;
+		s) streams="$OPTARG" ;;
+		o) results_file="$OPTARG" ;;
+		b) baseline_file="$OPTARG" ;;
+		t) tolerance="$OPTARG" ;;
+		*) echo "Usage: $0 [-c cycles] [-s streams] [-o results] [-b baseline] [-t tolerance_percent]"; exit 1 ;;
+	esac
+done
+
+# Easy Effects is a unique application. A private bus keeps it from talking to an instance of the user session.
+
+if [ -z "$SOAK_TEST_PRIVATE_BUS" ]; then
+	export SOAK_TEST_PRIVATE_BUS=1
+	exec dbus-run-session -- "$0" "$@"
+fi
+
+tmp_dir="$(mktemp -d)"
+echo "Temp dir: ${tmp_dir}"
+
+export XDG_RUNTIME_DIR="${tmp_dir}/runtime"
+export XDG_CONFIG_HOME="${tmp_dir}/config"
+export XDG_DATA_HOME="${tmp_dir}/data"
+export XDG_CACHE_HOME="${tmp_dir}/cache"
+export XDG_STATE_HOME="${tmp_dir}/state"
+export GSETTINGS_BACKEND=keyfile
+
+mkdir -p "$XDG_RUNTIME_DIR" "$XDG_CONFIG_HOME" "$XDG_DATA_HOME" "$XDG_CACHE_HOME" "$XDG_STATE_HOME"
+chmod 700 "$XDG_RUNTIME_DIR"
+
+cleanup(){
+	( set +e
+	if [ -f "${tmp_dir}/pids" ]; then
+		while read -r pid
+		do
+			kill "$pid" 2>/dev/null
+		done < <(tac "${tmp_dir}/pids")
+	fi
+	)
+	if [ -z "$NO_CLEANUP" ]; then rm -fr "${tmp_dir:?}" ; fi
+}
+trap cleanup EXIT
+
+start_bg(){
+	"$@" &
+	echo $! >> "${tmp_dir}/pids"
+}
+
+wait_for(){
+	# wait_for <seconds> <command...>
+	local timeout="$1"
+	shift
+	local n=0
+	until "$@" >/dev/null 2>&1; do
+		sleep 0.1
+		n=$(( n + 1 ))
+		if [ "$n" -gt $(( timeout * 10 )) ]; then
+			return 1
+		fi
+	done
+}
+
+now_ms(){
+	date +%s%3N
+}
+
+cat > "${tmp_dir}/pipewire.conf" <<EOF
+context.properties = {
+	default.clock.rate = 48000
+	default.clock.quantum = 1024
+	core.daemon = true
+	core.name = pipewire-0
+}
+
+context.spa-libs = {
+	audio.convert.* = audioconvert/libspa-audioconvert
+	support.*       = support/libspa-support
+}
+
+context.modules = [
+	{ name = libpipewire-module-rt args = { } flags = [ ifexists nofail ] }
+	{ name = libpipewire-module-protocol-native }
+	{ name = libpipewire-module-profiler }
+	{ name = libpipewire-module-metadata }
+	{ name = libpipewire-module-spa-node-factory }
+	{ name = libpipewire-module-client-node }
+	{ name = libpipewire-module-client-device }
+	{ name = libpipewire-module-adapter }
+	{ name = libpipewire-module-link-factory }
+	{ name = libpipewire-module-session-manager flags = [ ifexists nofail ] }
+]
+
+context.objects = [
+	{ factory = spa-node-factory
+		args = {
+			factory.name    = support.node.driver
+			node.name       = Dummy-Driver
+			node.group      = pipewire.dummy
+			priority.driver = 20000
+		}
+	}
+	{ factory = adapter
+		args = {
+			factory.name     = support.null-audio-sink
+			node.name        = soak_sink_a
+			media.class      = Audio/Sink
+			audio.position   = [ FL FR ]
+			priority.session = 2000
+		}
+	}
+	{ factory = adapter
+		args = {
+			factory.name   = support.null-audio-sink
+			node.name      = soak_sink_b
+			media.class    = Audio/Sink
+			audio.position = [ FL FR ]
+		}
+	}
+	{ factory = adapter
+		args = {
+			factory.name   = support.null-audio-sink
+			node.name      = soak_source
+			media.class    = Audio/Source/Virtual
+			audio.position = [ FL FR ]
+		}
+	}
+]
+EOF
+
+if [ -z "$DISPLAY" ] && [ -z "$WAYLAND_DISPLAY" ]; then
+	virt_display="$(( ( RANDOM % 100 ) + 100 ))"
+	start_bg Xvfb ":${virt_display}" -screen 0 1024x720x24
+	export DISPLAY=":${virt_display}"
+fi
+
+start_bg pipewire -c "${tmp_dir}/pipewire.conf"
+wait_for 10 pw-cli info 0 || { echo "The private PipeWire daemon did not start"; exit 1; }
+
+start_bg wireplumber
+wait_for 10 sh -c "pw-cli ls Node | grep -q soak_sink_a" || { echo "The null sinks were not created"; exit 1; }
+
+gsettings set com.github.wwmm.easyeffects process-all-outputs true
+gsettings set com.github.wwmm.easyeffects.streamoutputs use-default-output-device false
+gsettings set com.github.wwmm.easyeffects.streamoutputs output-device soak_sink_a
+gsettings set com.github.wwmm.easyeffects.streaminputs use-default-input-device false
+gsettings set com.github.wwmm.easyeffects.streaminputs input-device soak_source
+
+log_file="${tmp_dir}/easyeffects.log"
+
+startup_begin="$(now_ms)"
+
+G_MESSAGES_DEBUG=easyeffects start_bg "$EE_BIN" --gapplication-service > "$log_file" 2>&1
+
+if ! wait_for 30 grep -q "link timing: connect_filters" "$log_file"; then
+	echo "$EE_BIN did not link its pipelines in 30 seconds"
+	tail -n 50 "$log_file"
+	exit 1
+fi
+
+bring_up_ms=$(( $(now_ms) - startup_begin ))
+
+echo "Pipelines linked in ${bring_up_ms} ms. Starting ${cycles} cycles of ${streams} streams."
+
+for (( cycle = 0; cycle < cycles; cycle++ )); do
+	pids=()
+
+	for (( n = 0; n < streams; n++ )); do
+		pw-play --volume 0.1 "$WAV_FILE" >/dev/null 2>&1 &
+		pids+=("$!")
+	done
+
+	sleep 2
+
+	# device flap: the output pipeline is disconnected and linked again to the other sink
+
+	if (( cycle % 2 == 0 )); then
+		gsettings set com.github.wwmm.easyeffects.streamoutputs output-device soak_sink_b
+	else
+		gsettings set com.github.wwmm.easyeffects.streamoutputs output-device soak_sink_a
+	fi
+
+	sleep 1
+
+	kill "${pids[@]}" 2>/dev/null || true
+	wait "${pids[@]}" 2>/dev/null || true
+
+	sleep 1
+done
+
+xruns="$(pw-top -b -n 2 2>/dev/null | awk '$NF ~ /^ee_/ { err[$NF] = $9 } END { s = 0; for (n in err) s += err[n]; print s }')"
+
+stats(){
+	# prints "count median max" of the ms= field of the given operation
+	grep "link timing: $1 " "$log_file" | sed -e 's/.* ms=//' | sort -g | awk '
+		{ v[NR] = $1 }
+		END {
+			if (NR == 0) { print 0, 0, 0; exit }
+			print NR, v[int((NR + 1) / 2)], v[NR]
+		}'
+}
+
+read -r connect_count connect_median connect_max <<< "$(stats connect_filters)"
+read -r disconnect_count disconnect_median disconnect_max <<< "$(stats disconnect_filters)"
+
+max_links="$(grep "link timing: connect_filters " "$log_file" | sed -e 's/.* links=\([0-9]*\).*/\1/' | sort -n | tail -n 1)"
+
+results="$(cat <<EOF
+bring_up_ms ${bring_up_ms}
+connect_count ${connect_count}
+connect_median_ms ${connect_median}
+connect_max_ms ${connect_max}
+disconnect_count ${disconnect_count}
+disconnect_median_ms ${disconnect_median}
+disconnect_max_ms ${disconnect_max}
+max_links ${max_links:-0}
+xruns ${xruns:-0}
+EOF
+)"
+
+echo "$results"
+
+if [ -n "$results_file" ]; then echo "$results" > "$results_file"; fi
+
+if [ -n "$baseline_file" ]; then
+	if ! echo "$results" | awk -v tolerance="$tolerance" '
+		NR == FNR { base[$1] = $2; next }
+		($1 in base) && $1 ~ /_ms$/ && $2 > base[$1] * (1 + tolerance / 100) {
+			print "Regression: " $1 " went from " base[$1] " to " $2; failed = 1
+		}
+		($1 in base) && $1 == "xruns" && $2 > base[$1] {
+			print "Regression: xruns went from " base[$1] " to " $2; failed = 1
+		}
+		END { exit failed }' "$baseline_file" -; then
+		echo "Soak test: FAILED !!!"
+		exit 1
+	fi
+fi
+
+echo "Soak test: OK"